@@ -73,6 +73,33 @@ namespace analyze {
    * followed by a normalization, followed by an inverse transform.
    *
    * <p>This method is just a light wrapper around the three-argument
+   * autocorrelation function
+   *
+   * @tparam T Scalar type.
+   * @param y Input sequence.
+   * @param acov Autocovariances.
+   * @param fft FFT engine instance.
+   */
+  template <typename T, typename DerivedA, typename DerivedB>
+  void autocovariance(const Eigen::MatrixBase<DerivedA>& y,
+                      Eigen::MatrixBase<DerivedB>& acov, Eigen::FFT<T>& fft) {
+    autocorrelation(y, acov, fft);
+    acov = acov.array() * (y.array() - y.mean()).square().sum() / y.size();
+  }
+
+  /**
+   * Write autocovariance estimates for every lag for the specified
+   * input sequence into the specified result. Normalizes lag-k
+   * autocovariance estimators by N instead of (N - k), yielding
+   * biased but more stable estimators as discussed in Geyer (1992);
+   * see https://projecteuclid.org/euclid.ss/1177011137. The return
+   * vector will be resized to the same length as the input sequence
+   * with lags given by array index.
+   *
+   * <p>The implementation involves a fast Fourier transform,
+   * followed by a normalization, followed by an inverse transform.
+   *
+   * <p>This method is just a light wrapper around the three-argument
    * autocovariance function
    *
    * @tparam T Scalar type.
@@ -83,8 +110,7 @@ namespace analyze {
   void autocovariance(const Eigen::MatrixBase<DerivedA>& y,
                       Eigen::MatrixBase<DerivedB>& acov) {
     Eigen::FFT<T> fft;
-    autocorrelation(y, acov, fft);
-    acov = acov.array() * (y.array() - y.mean()).square().sum() / y.size();
+    autocovariance(y, acov, fft);
   }
 
   /**
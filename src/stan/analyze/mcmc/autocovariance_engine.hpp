@@ -0,0 +1,158 @@
+#ifndef STAN_ANALYZE_MCMC_AUTOCOVARIANCE_ENGINE_HPP
+#define STAN_ANALYZE_MCMC_AUTOCOVARIANCE_ENGINE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat.hpp>
+#include <unsupported/Eigen/FFT>
+#include <complex>
+#include <cstddef>
+
+namespace stan {
+namespace analyze {
+
+  /**
+   * Computes autocorrelations and autocovariances of many sequences,
+   * reusing one FFT engine and its work buffers.
+   *
+   * <p>The estimates are the same as those of the free functions
+   * <code>autocorrelation</code> and <code>autocovariance</code>,
+   * normalizing lag-k estimators by N instead of (N - k) as
+   * recommended by Geyer (1992). Those functions allocate their
+   * buffers, and usually a new engine, on every call. Here the
+   * buffers are resized only when the padded length changes, and
+   * the FFT engine keeps its plans for every length it has seen, so
+   * computing the autocovariance of many sequences of the same
+   * length, such as the chains of every parameter, allocates once.
+   *
+   * <p>Two sequences of the same length can be transformed together:
+   * the two real sequences are packed into the real and imaginary
+   * parts of one complex sequence, so one forward and one inverse
+   * transform serve both.
+   *
+   * <p>An engine is not thread safe; use one engine per thread.
+   *
+   * @tparam T Scalar type.
+   */
+  template <typename T>
+  class autocovariance_engine {
+  public:
+    typedef Eigen::Matrix<T, Eigen::Dynamic, 1> vector_t;
+    typedef Eigen::Matrix<std::complex<T>, Eigen::Dynamic, 1> complex_vector_t;
+
+    autocovariance_engine() : padded_size_(0) {}
+
+    /**
+     * Write autocorrelation estimates for every lag of the specified
+     * sequence into the specified result, which is resized to the
+     * length of the sequence.
+     *
+     * @param y Input sequence.
+     * @param ac Autocorrelations.
+     */
+    template <typename DerivedA, typename DerivedB>
+    void autocorrelation(const Eigen::MatrixBase<DerivedA>& y,
+                         Eigen::MatrixBase<DerivedB>& ac) {
+      size_t N = y.size();
+      resize(N);
+      real_signal_.setZero();
+      real_signal_.head(N) = y.array() - y.mean();
+
+      fft_.fwd(freqvec_, real_signal_);
+      spectrum_ = freqvec_.cwiseAbs2();
+      fft_.inv(ac_tmp_, spectrum_);
+
+      ac = ac_tmp_.head(N).real().array() / (N * N * 2);
+      ac /= ac(0);
+    }
+
+    /**
+     * Write autocovariance estimates for every lag of the specified
+     * sequence into the specified result, which is resized to the
+     * length of the sequence.
+     *
+     * @param y Input sequence.
+     * @param acov Autocovariances.
+     */
+    template <typename DerivedA, typename DerivedB>
+    void autocovariance(const Eigen::MatrixBase<DerivedA>& y,
+                        Eigen::MatrixBase<DerivedB>& acov) {
+      autocorrelation(y, acov);
+      acov = acov.array() * (y.array() - y.mean()).square().sum() / y.size();
+    }
+
+    /**
+     * Write autocovariance estimates for every lag of two sequences of
+     * the same length, using one forward and one inverse transform
+     * for both.
+     *
+     * <p>With z = x + i y, the transforms of the real sequences are
+     * X(k) = (Z(k) + conj(Z(M - k))) / 2 and
+     * Y(k) = (Z(k) - conj(Z(M - k))) / 2i. Their power spectra are
+     * real and symmetric, so their inverse transforms are real and
+     * can be recovered as the real and imaginary parts of one
+     * inverse transform of |X|^2 + i |Y|^2.
+     *
+     * @param x First input sequence.
+     * @param y Second input sequence, of the same length.
+     * @param acov_x Autocovariances of the first sequence.
+     * @param acov_y Autocovariances of the second sequence.
+     */
+    template <typename DerivedA, typename DerivedB, typename DerivedC,
+              typename DerivedD>
+    void autocovariance(const Eigen::MatrixBase<DerivedA>& x,
+                        const Eigen::MatrixBase<DerivedB>& y,
+                        Eigen::MatrixBase<DerivedC>& acov_x,
+                        Eigen::MatrixBase<DerivedD>& acov_y) {
+      size_t N = x.size();
+      resize(N);
+      complex_signal_.setZero();
+      complex_signal_.head(N).real() = x.array() - x.mean();
+      complex_signal_.head(N).imag() = y.array() - y.mean();
+
+      fft_.fwd(freqvec_, complex_signal_);
+      const size_t M = padded_size_;
+      for (size_t k = 0; k < M; ++k) {
+        std::complex<T> z = freqvec_(k);
+        std::complex<T> z_conj = std::conj(freqvec_((M - k) % M));
+        T abs2_x = std::norm(z + z_conj) / 4;
+        T abs2_y = std::norm(z - z_conj) / 4;
+        spectrum_(k) = std::complex<T>(abs2_x, abs2_y);
+      }
+      fft_.inv(ac_tmp_, spectrum_);
+
+      acov_x = ac_tmp_.head(N).real().array() / ac_tmp_(0).real();
+      acov_x = acov_x.array() * (x.array() - x.mean()).square().sum() / N;
+      acov_y = ac_tmp_.head(N).imag().array() / ac_tmp_(0).imag();
+      acov_y = acov_y.array() * (y.array() - y.mean()).square().sum() / N;
+    }
+
+  private:
+    Eigen::FFT<T> fft_;
+    size_t padded_size_;
+    vector_t real_signal_;
+    complex_vector_t complex_signal_;
+    complex_vector_t freqvec_;
+    complex_vector_t spectrum_;
+    complex_vector_t ac_tmp_;
+
+    /**
+     * Size the buffers for sequences of length N, padded with at
+     * least N zeros to a length the FFT handles efficiently.
+     */
+    void resize(size_t N) {
+      size_t Mt2 = 2 * math::internal::fft_next_good_size(N);
+      if (Mt2 == padded_size_)
+        return;
+      padded_size_ = Mt2;
+      real_signal_.resize(Mt2);
+      complex_signal_.resize(Mt2);
+      freqvec_.resize(Mt2);
+      spectrum_.resize(Mt2);
+      ac_tmp_.resize(Mt2);
+    }
+  };
+
+}  // namespace analyze
+}  // namespace stan
+
+#endif
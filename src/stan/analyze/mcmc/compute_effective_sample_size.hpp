@@ -3,6 +3,7 @@
 
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/analyze/mcmc/autocovariance.hpp>
+#include <stan/analyze/mcmc/autocovariance_engine.hpp>
 #include <stan/analyze/mcmc/split_chains.hpp>
 #include <algorithm>
 #include <cmath>
@@ -20,15 +21,19 @@ namespace analyze {
    * Sample Size". http://mc-stan.org/users/documentation
    *
    * Current implementation assumes chains are all of equal size and
-   * draws are stored in contiguous blocks of memory.
+   * draws are stored in contiguous blocks of memory.  Chains of the
+   * same size are paired and their autocovariances computed with one
+   * transform.
    *
    * @param draws stores pointers to arrays of chains
    * @param sizes stores sizes of chains
+   * @param engine autocovariance engine, reused across calls
    * @return effective sample size for the specified parameter
    */
   inline
-  double compute_effective_sample_size(std::vector<const double*> draws,
-                                       std::vector<size_t> sizes) {
+  double compute_effective_sample_size(const std::vector<const double*>& draws,
+                                       const std::vector<size_t>& sizes,
+                                       autocovariance_engine<double>& engine) {
     int num_chains = sizes.size();
     size_t num_draws = sizes[0];
     for (int chain = 1; chain < num_chains; ++chain) {
@@ -38,11 +43,20 @@ namespace analyze {
     Eigen::Matrix<Eigen::VectorXd, Eigen::Dynamic, 1> acov(num_chains);
     Eigen::VectorXd chain_mean(num_chains);
     Eigen::VectorXd chain_var(num_chains);
+    typedef Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, 1>>
+      draws_map;
     for (int chain = 0; chain < num_chains; ++chain) {
-      Eigen::Map<const Eigen::Matrix<double, Eigen::Dynamic, 1>>
-        draw(draws[chain], sizes[chain]);
-      autocovariance<double>(draw, acov(chain));
-      chain_mean(chain) = draw.mean();
+      draws_map draw(draws[chain], sizes[chain]);
+      if (chain + 1 < num_chains && sizes[chain + 1] == sizes[chain]) {
+        draws_map next_draw(draws[chain + 1], sizes[chain + 1]);
+        engine.autocovariance(draw, next_draw, acov(chain), acov(chain + 1));
+        ++chain;
+      } else {
+        engine.autocovariance(draw, acov(chain));
+      }
+    }
+    for (int chain = 0; chain < num_chains; ++chain) {
+      chain_mean(chain) = draws_map(draws[chain], sizes[chain]).mean();
       chain_var(chain) = acov(chain)(0)*num_draws / (num_draws - 1);
     }
 
@@ -103,6 +117,29 @@ namespace analyze {
                     num_total_draws * std::log10(num_total_draws));
   }
 
+  /**
+   * Computes the effective sample size (ESS) for the specified
+   * parameter across all kept samples.  The value returned is the
+   * minimum of ESS and the number_total_draws *
+   * log10(number_total_draws).
+   *
+   * See more details in Stan reference manual section "Effective
+   * Sample Size". http://mc-stan.org/users/documentation
+   *
+   * Current implementation assumes chains are all of equal size and
+   * draws are stored in contiguous blocks of memory.
+   *
+   * @param draws stores pointers to arrays of chains
+   * @param sizes stores sizes of chains
+   * @return effective sample size for the specified parameter
+   */
+  inline
+  double compute_effective_sample_size(std::vector<const double*> draws,
+                                       std::vector<size_t> sizes) {
+    autocovariance_engine<double> engine;
+    return compute_effective_sample_size(draws, sizes, engine);
+  }
+
   /**
    * Computes the effective sample size (ESS) for the specified
    * parameter across all kept samples.  The value returned is the
@@ -143,11 +180,13 @@ namespace analyze {
    *
    * @param draws stores pointers to arrays of chains
    * @param sizes stores sizes of chains
+   * @param engine autocovariance engine, reused across calls
    * @return effective sample size for the specified parameter
    */
-  inline
-  double compute_split_effective_sample_size(std::vector<const double*> draws,
-                                             std::vector<size_t> sizes) {
+  inline double
+  compute_split_effective_sample_size(const std::vector<const double*>& draws,
+                                      const std::vector<size_t>& sizes,
+                                      autocovariance_engine<double>& engine) {
     int num_chains = sizes.size();
     size_t num_draws = sizes[0];
     for (int chain = 1; chain < num_chains; ++chain) {
@@ -159,7 +198,31 @@ namespace analyze {
     double half = num_draws / 2.0;
     std::vector<size_t> half_sizes(2 * num_chains, std::floor(half));
 
-    return compute_effective_sample_size(split_draws, half_sizes);
+    return compute_effective_sample_size(split_draws, half_sizes, engine);
+  }
+
+  /**
+   * Computes the split effective sample size (ESS) for the specified
+   * parameter across all kept samples.  The value returned is the
+   * minimum of ESS and the number_total_draws *
+   * log10(number_total_draws). When the number of total draws N is
+   * odd, the (N+1)/2th draw is ignored.
+   *
+   * See more details in Stan reference manual section "Effective
+   * Sample Size". http://mc-stan.org/users/documentation
+   *
+   * Current implementation assumes chains are all of equal size and
+   * draws are stored in contiguous blocks of memory.
+   *
+   * @param draws stores pointers to arrays of chains
+   * @param sizes stores sizes of chains
+   * @return effective sample size for the specified parameter
+   */
+  inline
+  double compute_split_effective_sample_size(std::vector<const double*> draws,
+                                             std::vector<size_t> sizes) {
+    autocovariance_engine<double> engine;
+    return compute_split_effective_sample_size(draws, sizes, engine);
   }
 
   /**
@@ -0,0 +1,106 @@
+#ifndef STAN_ANALYZE_MCMC_COMPUTE_QUANTILES_HPP
+#define STAN_ANALYZE_MCMC_COMPUTE_QUANTILES_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace analyze {
+
+  /**
+   * Returns the position in the sorted draws of the quantile with the
+   * specified probability, or the number of draws if the quantile is
+   * undefined.
+   *
+   * The quantile is the ceil(N * p)-th smallest draw for p < 0.5 and
+   * the ceil(N * (1 - p))-th largest draw otherwise, and is undefined
+   * if that rank is N or more.  This is the definition used by the
+   * Boost.Accumulators tail quantiles that Stan used before, so the
+   * values reported are unchanged. A rank of zero, for probability 0
+   * or 1, selects the smallest or largest draw.
+   *
+   * @param num_draws number of draws
+   * @param prob probability
+   * @return position of the quantile in the sorted draws
+   */
+  inline size_t quantile_position(size_t num_draws, double prob) {
+    bool left = prob < 0.5;
+    size_t rank = static_cast<size_t>(
+        std::ceil(num_draws * (left ? prob : 1. - prob)));
+    if (rank >= num_draws)
+      return num_draws;
+    if (left)
+      return rank == 0 ? 0 : rank - 1;
+    return rank == 0 ? num_draws - 1 : num_draws - rank;
+  }
+
+  /**
+   * Computes the quantiles of the draws for the specified
+   * probabilities, reordering the draws in place.
+   *
+   * All quantiles are found by selection: the positions are visited
+   * in increasing order, each with <code>std::nth_element</code> over
+   * the draws not yet known to lie below the previous position, so
+   * the cost is linear in the number of draws for each distinct
+   * quantile and no sorting or extra storage is needed.
+   *
+   * See <code>quantile_position</code> for the definition of the
+   * quantiles; undefined quantiles are NaN.
+   *
+   * @param[in,out] draws pointer to the draws, reordered on return
+   * @param[in] num_draws number of draws
+   * @param[in] probs probabilities
+   * @return quantiles, in the order of the probabilities
+   */
+  inline Eigen::VectorXd
+  compute_quantiles_in_place(double* draws, size_t num_draws,
+                             const Eigen::VectorXd& probs) {
+    std::vector<std::pair<size_t, int> > positions(probs.size());
+    for (int i = 0; i < probs.size(); ++i)
+      positions[i] = std::make_pair(quantile_position(num_draws, probs(i)),
+                                    i);
+    std::sort(positions.begin(), positions.end());
+
+    Eigen::VectorXd q(probs.size());
+    size_t begin = 0;
+    for (size_t i = 0; i < positions.size(); ++i) {
+      size_t pos = positions[i].first;
+      if (pos >= num_draws) {
+        q(positions[i].second) = std::numeric_limits<double>::quiet_NaN();
+        continue;
+      }
+      if (pos >= begin) {
+        std::nth_element(draws + begin, draws + pos, draws + num_draws);
+        begin = pos + 1;
+      }
+      q(positions[i].second) = draws[pos];
+    }
+    return q;
+  }
+
+  /**
+   * Computes the quantiles of the draws for the specified
+   * probabilities. The draws are copied once and the quantiles found
+   * by selection on the copy (see
+   * <code>compute_quantiles_in_place</code>).
+   *
+   * @param[in] draws pointer to the draws
+   * @param[in] num_draws number of draws
+   * @param[in] probs probabilities
+   * @return quantiles, in the order of the probabilities
+   */
+  inline Eigen::VectorXd
+  compute_quantiles(const double* draws, size_t num_draws,
+                    const Eigen::VectorXd& probs) {
+    std::vector<double> work(draws, draws + num_draws);
+    return compute_quantiles_in_place(work.data(), num_draws, probs);
+  }
+
+}  // namespace analyze
+}  // namespace stan
+
+#endif
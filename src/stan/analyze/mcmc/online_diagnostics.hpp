@@ -0,0 +1,429 @@
+#ifndef STAN_ANALYZE_MCMC_ONLINE_DIAGNOSTICS_HPP
+#define STAN_ANALYZE_MCMC_ONLINE_DIAGNOSTICS_HPP
+
+#include <stan/analyze/mcmc/autocovariance_engine.hpp>
+#include <stan/analyze/mcmc/compute_effective_sample_size.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+namespace analyze {
+
+  /**
+   * Convergence diagnostics computed while draws are produced.
+   *
+   * Draws are added one at a time per chain, possibly from several
+   * threads. For every parameter the draws of each chain are stored
+   * along with running sums up to the split points of the draws
+   * held by every chain, from which the split potential scale
+   * reduction (R-hat) is available at any time in constant time per
+   * chain. The split effective sample size (ESS) requires the
+   * FFT-based autocovariance of all draws, so it is recomputed each
+   * time the number of draws held by every chain reaches a multiple
+   * of the refresh interval; between refreshes the last estimate is
+   * returned.
+   *
+   * The thread whose draw reaches a refresh point copies the draws
+   * and computes the ESS without holding the lock, so other threads
+   * keep adding draws meanwhile. A refresh point reached while a
+   * refresh is running is taken at the first draw after it ends.
+   *
+   * When chains have different numbers of draws, the diagnostics use
+   * the first <code>num_draws()</code> draws of each chain, the
+   * largest number held by all chains.
+   */
+  class online_diagnostics {
+  public:
+    /**
+     * Construct diagnostics for the specified number of chains. The
+     * number of parameters is set by the first draw.
+     *
+     * @param num_chains number of chains
+     * @param refresh_interval number of draws per chain between
+     *   recomputations of the effective sample size; at least 1
+     */
+    explicit online_diagnostics(size_t num_chains,
+                                size_t refresh_interval = 100)
+      : refresh_interval_(std::max(refresh_interval, size_t(1))),
+        next_refresh_(std::max(refresh_interval_, min_ess_draws())),
+        num_params_(0), num_summed_(0), ess_num_draws_(0),
+        refreshing_(false), chains_(num_chains) {
+      if (num_chains == 0)
+        throw std::invalid_argument("online_diagnostics: number of chains"
+                                    " must be positive");
+    }
+
+    /**
+     * Set the names of the parameters, for lookup by name.
+     *
+     * @param names parameter names
+     */
+    void set_names(const std::vector<std::string>& names) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      names_ = names;
+    }
+
+    /**
+     * Return the index of the named parameter.
+     *
+     * @param name name of parameter
+     * @return index of the parameter
+     * @throw std::out_of_range if the name was not set
+     */
+    size_t index(const std::string& name) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (size_t n = 0; n < names_.size(); ++n)
+        if (names_[n] == name)
+          return n;
+      throw std::out_of_range("online_diagnostics: unknown parameter "
+                              + name);
+    }
+
+    /**
+     * Add a draw to a chain. If the number of draws held by every
+     * chain reaches the next refresh point, the effective sample
+     * sizes are recomputed before returning.
+     *
+     * @param chain index of the chain
+     * @param draw value of each parameter
+     * @throw std::out_of_range if the chain index is too large
+     * @throw std::invalid_argument if the number of values differs
+     *   from earlier draws
+     */
+    void add_draw(size_t chain, const std::vector<double>& draw) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (chain >= chains_.size())
+        throw std::out_of_range("online_diagnostics: chain index out of"
+                                " range");
+      if (num_params_ == 0) {
+        num_params_ = draw.size();
+        for (size_t c = 0; c < chains_.size(); ++c)
+          chains_[c].resize(num_params_);
+        ess_.assign(num_params_, std::numeric_limits<double>::quiet_NaN());
+        ess_constant_.assign(num_params_, false);
+      }
+      if (draw.size() != num_params_)
+        throw std::invalid_argument("online_diagnostics: number of values"
+                                    " does not match earlier draws");
+
+      std::vector<param_draws>& params = chains_[chain];
+      for (size_t p = 0; p < num_params_; ++p)
+        params[p].values.push_back(draw[p]);
+
+      size_t n = common_num_draws();
+      if (n == num_summed_)
+        return;
+      for (size_t c = 0; c < chains_.size(); ++c)
+        for (size_t p = 0; p < num_params_; ++p)
+          chains_[c][p].advance(n);
+      num_summed_ = n;
+
+      if (n < next_refresh_ || refreshing_)
+        return;
+      refreshing_ = true;
+      while (next_refresh_ <= n)
+        next_refresh_ += refresh_interval_;
+      copy_draws(n);
+      lock.unlock();
+      try {
+        compute_ess(n);
+      } catch (...) {
+        lock.lock();
+        refreshing_ = false;
+        throw;
+      }
+      lock.lock();
+      ess_.swap(fresh_ess_);
+      ess_constant_.swap(fresh_constant_);
+      ess_num_draws_ = n;
+      refreshing_ = false;
+    }
+
+    /**
+     * Return the number of parameters, zero until the first draw.
+     */
+    size_t num_params() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return num_params_;
+    }
+
+    /**
+     * Return the number of draws held by every chain.
+     */
+    size_t num_draws() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return common_num_draws();
+    }
+
+    /**
+     * Return the number of draws per chain used for the current
+     * effective sample size estimates, zero before the first refresh.
+     */
+    size_t ess_num_draws() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return ess_num_draws_;
+    }
+
+    /**
+     * Return the split effective sample size of a parameter as of
+     * the last refresh, or NaN before the first refresh.
+     *
+     * @param param index of parameter
+     * @return effective sample size
+     */
+    double ess(size_t param) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      check_param(param);
+      return ess_[param];
+    }
+
+    /**
+     * Return the smallest split effective sample size over all
+     * parameters as of the last refresh. Parameters whose draws are
+     * all equal, such as a fixed step size, have no effective sample
+     * size and are skipped. Returns NaN before the first refresh, if
+     * every parameter is skipped, or if any other estimate is NaN.
+     */
+    double min_ess() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      double result = std::numeric_limits<double>::quiet_NaN();
+      for (size_t p = 0; p < ess_.size(); ++p) {
+        if (ess_constant_[p])
+          continue;
+        if (std::isnan(ess_[p]))
+          return ess_[p];
+        if (!(result <= ess_[p]))
+          result = ess_[p];
+      }
+      return result;
+    }
+
+    /**
+     * Return the split potential scale reduction of a parameter over
+     * the draws held by every chain, or NaN with fewer than four
+     * draws per chain.
+     *
+     * @param param index of parameter
+     * @return split R-hat
+     */
+    double rhat(size_t param) const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      check_param(param);
+      return split_rhat(param);
+    }
+
+    /**
+     * Return the largest split potential scale reduction over all
+     * parameters. Parameters whose draws are all equal are skipped.
+     * Returns NaN if every parameter is skipped or if any other value
+     * is NaN.
+     */
+    double max_rhat() const {
+      std::lock_guard<std::mutex> lock(mutex_);
+      double result = std::numeric_limits<double>::quiet_NaN();
+      for (size_t p = 0; p < num_params_; ++p) {
+        if (is_constant(p))
+          continue;
+        double rhat = split_rhat(p);
+        if (std::isnan(rhat))
+          return rhat;
+        if (!(result >= rhat))
+          result = rhat;
+      }
+      return result;
+    }
+
+  private:
+    /**
+     * Sums of the first <code>end</code> draws of a chain minus the
+     * first draw, which keeps the variance computed from them
+     * accurate when the variance is small relative to the mean.
+     */
+    struct prefix_sums {
+      size_t end;
+      double sum;
+      double sum_sq;
+
+      prefix_sums() : end(0), sum(0), sum_sq(0) {}
+
+      void advance(const std::vector<double>& values, size_t new_end) {
+        for (; end < new_end; ++end) {
+          double d = values[end] - values[0];
+          sum += d;
+          sum_sq += d * d;
+        }
+      }
+    };
+
+    /**
+     * Draws of one parameter in one chain with running sums up to
+     * the split points of the first n draws: the end of the first
+     * half, the start of the second half, and n.
+     */
+    struct param_draws {
+      std::vector<double> values;
+      prefix_sums first_half;
+      prefix_sums before_second_half;
+      prefix_sums all;
+
+      void advance(size_t n) {
+        size_t half = n / 2;
+        first_half.advance(values, half);
+        before_second_half.advance(values, n - half);
+        all.advance(values, n);
+      }
+
+      /**
+       * Mean and sample variance of the first half of the draws, or
+       * of the second half if <code>second</code> is true.
+       */
+      void moments(bool second, double& mean, double& var) const {
+        double n = first_half.end;
+        double s = first_half.sum;
+        double ss = first_half.sum_sq;
+        if (second) {
+          s = all.sum - before_second_half.sum;
+          ss = all.sum_sq - before_second_half.sum_sq;
+        }
+        mean = values[0] + s / n;
+        var = std::max((ss - s * s / n) / (n - 1), 0.0);
+      }
+    };
+
+    static size_t min_ess_draws() {
+      return 8;
+    }
+
+    size_t refresh_interval_;
+    size_t next_refresh_;
+    size_t num_params_;
+    size_t num_summed_;
+    size_t ess_num_draws_;
+    bool refreshing_;
+    std::vector<std::vector<param_draws> > chains_;
+    std::vector<double> ess_;
+    std::vector<bool> ess_constant_;
+    std::vector<std::string> names_;
+    mutable std::mutex mutex_;
+
+    /**
+     * Used only by the thread running a refresh, outside the lock.
+     */
+    std::vector<double> draws_copy_;
+    std::vector<double> fresh_ess_;
+    std::vector<bool> fresh_constant_;
+    autocovariance_engine<double> acov_engine_;
+
+    void check_param(size_t param) const {
+      if (param >= num_params_)
+        throw std::out_of_range("online_diagnostics: parameter index out"
+                                " of range");
+    }
+
+    size_t common_num_draws() const {
+      if (num_params_ == 0)
+        return 0;
+      size_t n = chains_[0][0].values.size();
+      for (size_t c = 1; c < chains_.size(); ++c)
+        n = std::min(n, chains_[c][0].values.size());
+      return n;
+    }
+
+    /**
+     * Return true if the draws of a parameter held by every chain
+     * are the same value in every chain. Exact, as a draw equal to
+     * the first draw of its chain adds exactly zero to the sum of
+     * squares.
+     */
+    bool is_constant(size_t param) const {
+      if (num_summed_ == 0)
+        return false;
+      double first = chains_[0][param].values[0];
+      for (size_t c = 0; c < chains_.size(); ++c) {
+        const param_draws& d = chains_[c][param];
+        if (d.all.sum_sq != 0 || d.values[0] != first)
+          return false;
+      }
+      return true;
+    }
+
+    /**
+     * Copy the first n draws of each chain, parameter by parameter,
+     * so the effective sample sizes can be computed without the lock.
+     */
+    void copy_draws(size_t n) {
+      size_t num_chains = chains_.size();
+      draws_copy_.resize(num_params_ * num_chains * n);
+      double* out = draws_copy_.data();
+      for (size_t p = 0; p < num_params_; ++p)
+        for (size_t c = 0; c < num_chains; ++c, out += n)
+          std::copy(chains_[c][p].values.begin(),
+                    chains_[c][p].values.begin() + n, out);
+    }
+
+    void compute_ess(size_t n) {
+      size_t num_chains = chains_.size();
+      size_t num_params = draws_copy_.size() / (num_chains * n);
+      std::vector<const double*> draws(num_chains);
+      std::vector<size_t> sizes(num_chains, n);
+      fresh_ess_.resize(num_params);
+      fresh_constant_.resize(num_params);
+      for (size_t p = 0; p < num_params; ++p) {
+        for (size_t c = 0; c < num_chains; ++c)
+          draws[c] = &draws_copy_[(p * num_chains + c) * n];
+        const double* begin = draws[0];
+        const double* end = begin + num_chains * n;
+        fresh_constant_[p]
+          = std::find_if(begin, end, [begin](double x) {
+              return !(x == *begin);
+            }) == end;
+        fresh_ess_[p] = compute_split_effective_sample_size(draws, sizes,
+                                                            acov_engine_);
+      }
+    }
+
+    /**
+     * Split R-hat over the draws held by every chain, computed as in
+     * <code>stan::mcmc::chains</code> from the first and last halves
+     * of those draws.
+     */
+    double split_rhat(size_t param) const {
+      size_t half = num_summed_ / 2;
+      if (half < 2)
+        return std::numeric_limits<double>::quiet_NaN();
+      size_t num_splits = 2 * chains_.size();
+      std::vector<double> means(num_splits);
+      double var_within = 0;
+      for (size_t c = 0; c < chains_.size(); ++c) {
+        const param_draws& d = chains_[c][param];
+        double var;
+        d.moments(false, means[2 * c], var);
+        var_within += var;
+        d.moments(true, means[2 * c + 1], var);
+        var_within += var;
+      }
+      var_within /= num_splits;
+
+      double mean_of_means = 0;
+      for (size_t s = 0; s < num_splits; ++s)
+        mean_of_means += means[s];
+      mean_of_means /= num_splits;
+      double var_means = 0;
+      for (size_t s = 0; s < num_splits; ++s)
+        var_means += (means[s] - mean_of_means) * (means[s] - mean_of_means);
+      var_means /= num_splits - 1;
+      double var_between = half * var_means;
+
+      return std::sqrt((var_between / var_within + half - 1) / half);
+    }
+  };
+
+}  // namespace analyze
+}  // namespace stan
+
+#endif
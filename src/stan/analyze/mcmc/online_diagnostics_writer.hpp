@@ -0,0 +1,105 @@
+#ifndef STAN_ANALYZE_MCMC_ONLINE_DIAGNOSTICS_WRITER_HPP
+#define STAN_ANALYZE_MCMC_ONLINE_DIAGNOSTICS_WRITER_HPP
+
+#include <stan/analyze/mcmc/online_diagnostics.hpp>
+#include <stan/callbacks/writer.hpp>
+#include <string>
+#include <vector>
+
+namespace stan {
+namespace analyze {
+
+  /**
+   * A sample writer that passes every call on to another writer and
+   * adds the post-warmup draws of one chain to
+   * <code>online_diagnostics</code>.
+   *
+   * Only model columns are added. Columns whose names end in
+   * <code>__</code>, such as <code>lp__</code> and
+   * <code>stepsize__</code>, are written by the sampler and skipped;
+   * several of them are constant, which would leave the diagnostics
+   * without an effective sample size. If no names are written, every
+   * column is added.
+   *
+   * Wrapping the sample writer given to a sampling service feeds the
+   * diagnostics as draws are generated. Draws are recorded after the
+   * "Adaptation terminated" message that the samplers write at the
+   * end of warmup, so saved warmup draws are not included. The
+   * diagnostics can then be polled, for example from an interrupt
+   * callback that stops the run once a target effective sample size
+   * is reached.
+   */
+  class online_diagnostics_writer : public callbacks::writer {
+  public:
+    /**
+     * Construct a writer for one chain.
+     *
+     * @param[in,out] diagnostics diagnostics to add draws to
+     * @param[in] chain index of the chain
+     * @param[in,out] writer writer to pass calls on to
+     */
+    online_diagnostics_writer(online_diagnostics& diagnostics, size_t chain,
+                              callbacks::writer& writer)
+      : diagnostics_(diagnostics), chain_(chain), writer_(writer),
+        sampling_(false), has_names_(false) {}
+
+    void operator()(const std::vector<std::string>& names) {
+      writer_(names);
+      has_names_ = true;
+      columns_.clear();
+      std::vector<std::string> model_names;
+      for (size_t n = 0; n < names.size(); ++n) {
+        if (is_sampler_name(names[n]))
+          continue;
+        columns_.push_back(n);
+        model_names.push_back(names[n]);
+      }
+      if (chain_ == 0)
+        diagnostics_.set_names(model_names);
+    }
+
+    void operator()(const std::vector<double>& state) {
+      writer_(state);
+      if (!sampling_ || state.empty())
+        return;
+      if (!has_names_) {
+        diagnostics_.add_draw(chain_, state);
+        return;
+      }
+      if (columns_.empty())
+        return;
+      draw_.resize(columns_.size());
+      for (size_t n = 0; n < columns_.size(); ++n)
+        draw_[n] = state.at(columns_[n]);
+      diagnostics_.add_draw(chain_, draw_);
+    }
+
+    void operator()() {
+      writer_();
+    }
+
+    void operator()(const std::string& message) {
+      writer_(message);
+      if (message == "Adaptation terminated")
+        sampling_ = true;
+    }
+
+  private:
+    online_diagnostics& diagnostics_;
+    size_t chain_;
+    callbacks::writer& writer_;
+    bool sampling_;
+    bool has_names_;
+    std::vector<size_t> columns_;
+    std::vector<double> draw_;
+
+    static bool is_sampler_name(const std::string& name) {
+      return name.size() >= 2
+        && name.compare(name.size() - 2, 2, "__") == 0;
+    }
+  };
+
+}  // namespace analyze
+}  // namespace stan
+
+#endif
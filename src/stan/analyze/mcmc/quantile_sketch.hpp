@@ -0,0 +1,172 @@
+#ifndef STAN_ANALYZE_MCMC_QUANTILE_SKETCH_HPP
+#define STAN_ANALYZE_MCMC_QUANTILE_SKETCH_HPP
+
+#include <stan/analyze/mcmc/compute_quantiles.hpp>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace stan {
+namespace analyze {
+
+  /**
+   * Approximate quantiles of a stream of values in bounded memory, for
+   * monitoring draws while they are produced.
+   *
+   * <p>The sketch is a hierarchy of compactors, as in the KLL sketch
+   * (Karnin, Lang and Liberty, 2016). Values enter level 0; when a
+   * level holds <code>capacity</code> values it is sorted and every
+   * other value is promoted to the next level, where each value
+   * stands for twice as many draws. The offset of the values kept
+   * alternates between compactions, so the sketch is deterministic.
+   * With N values the sketch holds at most
+   * <code>capacity * (1 + log2(N / capacity))</code> values and the
+   * rank of a reported quantile is typically within a few multiples
+   * of N / capacity of the exact rank.
+   *
+   * <p>Quantiles are defined as in <code>quantile_position</code> on
+   * the weighted values, so a sketch that has not compacted reports
+   * the exact quantiles of <code>compute_quantiles</code>.
+   *
+   * <p>A sketch is not thread safe.
+   */
+  class quantile_sketch {
+  public:
+    /**
+     * Construct an empty sketch.
+     *
+     * @param capacity number of values a level holds before it is
+     *   compacted; at least 2
+     * @throw std::invalid_argument if the capacity is less than 2
+     */
+    explicit quantile_sketch(size_t capacity = 256)
+      : capacity_(capacity), count_(0) {
+      if (capacity < 2)
+        throw std::invalid_argument("quantile_sketch: capacity must be at"
+                                    " least 2");
+    }
+
+    /**
+     * Add a value to the sketch.
+     *
+     * @param x value
+     */
+    void add(double x) {
+      if (levels_.empty())
+        add_level();
+      levels_[0].push_back(x);
+      ++count_;
+      for (size_t h = 0; h < levels_.size(); ++h)
+        if (levels_[h].size() >= capacity_)
+          compact(h);
+    }
+
+    /**
+     * Return the number of values added.
+     */
+    size_t count() const {
+      return count_;
+    }
+
+    /**
+     * Return the number of values held by the sketch.
+     */
+    size_t size() const {
+      size_t n = 0;
+      for (size_t h = 0; h < levels_.size(); ++h)
+        n += levels_[h].size();
+      return n;
+    }
+
+    /**
+     * Return the approximate quantile for the specified probability,
+     * or NaN if it is undefined or no values have been added.
+     *
+     * @param prob probability
+     * @return approximate quantile
+     */
+    double quantile(double prob) const {
+      std::vector<double> probs(1, prob);
+      return quantiles(probs)[0];
+    }
+
+    /**
+     * Return the approximate quantiles for the specified
+     * probabilities.
+     *
+     * @param probs probabilities
+     * @return approximate quantiles, in the order of the probabilities
+     */
+    std::vector<double> quantiles(const std::vector<double>& probs) const {
+      std::vector<std::pair<double, size_t> > weighted;
+      weighted.reserve(size());
+      for (size_t h = 0; h < levels_.size(); ++h)
+        for (size_t i = 0; i < levels_[h].size(); ++i)
+          weighted.push_back(std::make_pair(levels_[h][i],
+                                            size_t(1) << h));
+      std::sort(weighted.begin(), weighted.end());
+
+      // compaction preserves the total weight, which is the count
+      size_t total = count_;
+
+      std::vector<double> q(probs.size());
+      for (size_t j = 0; j < probs.size(); ++j) {
+        size_t pos = quantile_position(total, probs[j]);
+        if (pos >= total) {
+          q[j] = std::numeric_limits<double>::quiet_NaN();
+          continue;
+        }
+        size_t cumulative = 0;
+        size_t i = 0;
+        while (cumulative + weighted[i].second <= pos) {
+          cumulative += weighted[i].second;
+          ++i;
+        }
+        q[j] = weighted[i].first;
+      }
+      return q;
+    }
+
+  private:
+    size_t capacity_;
+    size_t count_;
+    std::vector<std::vector<double> > levels_;
+    std::vector<bool> offsets_;
+
+    void add_level() {
+      levels_.push_back(std::vector<double>());
+      levels_.back().reserve(capacity_);
+      offsets_.push_back(false);
+    }
+
+    /**
+     * Promote every other value of a level to the next level. An odd
+     * value out stays at its level, so no weight is lost.
+     */
+    void compact(size_t h) {
+      if (h + 1 == levels_.size())
+        add_level();
+      std::vector<double>& level = levels_[h];
+      std::sort(level.begin(), level.end());
+      double odd_value = 0;
+      bool odd = level.size() % 2 == 1;
+      if (odd) {
+        odd_value = level.back();
+        level.pop_back();
+      }
+      size_t offset = offsets_[h] ? 1 : 0;
+      offsets_[h] = !offsets_[h];
+      for (size_t i = offset; i < level.size(); i += 2)
+        levels_[h + 1].push_back(level[i]);
+      level.clear();
+      if (odd)
+        level.push_back(odd_value);
+    }
+  };
+
+}  // namespace analyze
+}  // namespace stan
+
+#endif
@@ -0,0 +1,245 @@
+#ifndef STAN_CALLBACKS_ASYNC_WRITER_HPP
+#define STAN_CALLBACKS_ASYNC_WRITER_HPP
+
+#include <stan/callbacks/writer.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stan {
+  namespace callbacks {
+
+    /**
+     * <code>async_writer</code> is an implementation of
+     * <code>writer</code> that hands every call to a wrapped writer
+     * on a background thread, so a slow destination does not stall
+     * the caller.
+     *
+     * Calls are copied into a fixed number of slots of a
+     * single-producer, single-consumer ring buffer. The background
+     * thread drains all pending slots at once, in order, so the
+     * wrapped writer sees exactly the sequence of calls made on this
+     * writer. When the buffer is full the caller waits for a free
+     * slot, which bounds memory use. The slots keep their storage,
+     * so once they have been filled no further allocation is needed
+     * for rows of the same size.
+     *
+     * Only one thread may call this writer. The wrapped writer is
+     * only called from the background thread until
+     * <code>flush()</code> returns or this writer is destroyed. An
+     * exception thrown by the wrapped writer stops the draining and
+     * is rethrown from every later call on this writer.
+     */
+    class async_writer : public writer {
+    public:
+      /**
+       * Constructs an asynchronous writer around another writer.
+       *
+       * @param[in, out] writer writer called on the background thread
+       * @param[in] capacity number of calls that can be pending;
+       *   at least 2
+       */
+      explicit async_writer(writer& writer, size_t capacity = 256)
+        : writer_(writer),
+          slots_(capacity < 2 ? 2 : capacity),
+          head_(0), tail_(0),
+          stop_(false), consumer_waiting_(false), producer_waiting_(false),
+          failed_(false),
+          consumer_(&async_writer::drain, this) {
+      }
+
+      /**
+       * Virtual destructor. Waits until all pending calls have been
+       * passed to the wrapped writer.
+       */
+      virtual ~async_writer() {
+        stop_ = true;
+        wake(consumer_waiting_);
+        consumer_.join();
+      }
+
+      void operator()(const std::vector<std::string>& names) {
+        slot& s = acquire();
+        s.type = NAMES;
+        s.names = names;
+        publish();
+      }
+
+      void operator()(const std::vector<double>& state) {
+        slot& s = acquire();
+        s.type = VALUES;
+        s.values.assign(state.begin(), state.end());
+        publish();
+      }
+
+      void operator()() {
+        slot& s = acquire();
+        s.type = BLANK;
+        publish();
+      }
+
+      void operator()(const std::string& message) {
+        slot& s = acquire();
+        s.type = MESSAGE;
+        s.message = message;
+        publish();
+      }
+
+      /**
+       * Waits until every pending call has been passed to the wrapped
+       * writer.
+       *
+       * @throw any exception thrown by the wrapped writer
+       */
+      void flush() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        producer_waiting_ = true;
+        cv_.wait(lock, [this]() {
+            return failed_ || head_.load() == tail_.load();
+          });
+        producer_waiting_ = false;
+        lock.unlock();
+        rethrow_if_failed();
+      }
+
+    private:
+      enum record_type { NAMES, VALUES, BLANK, MESSAGE };
+
+      struct slot {
+        record_type type;
+        std::vector<std::string> names;
+        std::vector<double> values;
+        std::string message;
+      };
+
+      writer& writer_;
+      std::vector<slot> slots_;
+
+      /**
+       * Number of calls passed to the wrapped writer; only advanced
+       * by the background thread
+       */
+      std::atomic<size_t> head_;
+
+      /**
+       * Number of calls made on this writer; only advanced by the
+       * caller
+       */
+      std::atomic<size_t> tail_;
+
+      std::atomic<bool> stop_;
+      std::atomic<bool> consumer_waiting_;
+      std::atomic<bool> producer_waiting_;
+      std::atomic<bool> failed_;
+      std::exception_ptr exception_;
+
+      std::mutex mutex_;
+      std::condition_variable cv_;
+      std::thread consumer_;
+
+      /**
+       * Rethrows the exception of the wrapped writer, on every call
+       * once it has failed, so no later call is silently dropped.
+       */
+      void rethrow_if_failed() {
+        if (failed_)
+          std::rethrow_exception(exception_);
+      }
+
+      /**
+       * Returns the next free slot, waiting for the background thread
+       * if the buffer is full.
+       */
+      slot& acquire() {
+        rethrow_if_failed();
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load() == slots_.size()) {
+          std::unique_lock<std::mutex> lock(mutex_);
+          producer_waiting_ = true;
+          cv_.wait(lock, [this, tail]() {
+              return failed_ || tail - head_.load() < slots_.size();
+            });
+          producer_waiting_ = false;
+          lock.unlock();
+          rethrow_if_failed();
+        }
+        return slots_[tail % slots_.size()];
+      }
+
+      void publish() {
+        tail_.fetch_add(1);
+        wake(consumer_waiting_);
+      }
+
+      /**
+       * Notifies the other thread if it is waiting. The waiting flag
+       * is set before the waiting thread rechecks its condition under
+       * the mutex, so taking the mutex here ensures the notification
+       * is not lost.
+       */
+      void wake(std::atomic<bool>& waiting) {
+        if (waiting) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          cv_.notify_all();
+        }
+      }
+
+      /**
+       * Body of the background thread.
+       */
+      void drain() {
+        while (true) {
+          size_t head = head_.load(std::memory_order_relaxed);
+          size_t tail = tail_.load();
+          if (head == tail) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            consumer_waiting_ = true;
+            cv_.wait(lock, [this, head]() {
+                return stop_ || tail_.load() != head;
+              });
+            consumer_waiting_ = false;
+            if (tail_.load() == head)
+              return;
+            continue;
+          }
+          try {
+            for (; head != tail; ++head) {
+              write(slots_[head % slots_.size()]);
+              head_.store(head + 1);
+            }
+          } catch (...) {
+            exception_ = std::current_exception();
+            failed_ = true;
+            std::lock_guard<std::mutex> lock(mutex_);
+            cv_.notify_all();
+            return;
+          }
+          wake(producer_waiting_);
+        }
+      }
+
+      void write(const slot& s) {
+        switch (s.type) {
+        case NAMES:
+          writer_(s.names);
+          break;
+        case VALUES:
+          writer_(s.values);
+          break;
+        case BLANK:
+          writer_();
+          break;
+        case MESSAGE:
+          writer_(s.message);
+          break;
+        }
+      }
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,244 @@
+#ifndef STAN_CALLBACKS_BINARY_DRAWS_WRITER_HPP
+#define STAN_CALLBACKS_BINARY_DRAWS_WRITER_HPP
+
+#include <stan/callbacks/writer.hpp>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace callbacks {
+
+    /**
+     * Constants describing the binary draws format written by
+     * <code>binary_draws_writer</code>.
+     *
+     * A file starts with the 8 byte <code>magic</code> string and is
+     * followed by a sequence of records, each starting with a one
+     * byte tag:
+     *
+     * <ul>
+     * <li><code>NAMES</code>: the number of columns as a
+     * <code>uint64_t</code>, then for each column the length of its
+     * name as a <code>uint64_t</code> followed by the characters.</li>
+     * <li><code>DRAWS</code>: the number of rows and the number of
+     * columns in the chunk, each as a <code>uint64_t</code>, then the
+     * values of the chunk as doubles in column-major order.</li>
+     * <li><code>MESSAGE</code>: the length of the message as a
+     * <code>uint64_t</code> followed by the characters. A blank line
+     * is an empty message.</li>
+     * </ul>
+     *
+     * All numbers are stored in the native byte order of the
+     * machine that wrote the file.
+     */
+    struct binary_draws_format {
+      static const char* magic() { return "STANDRW1"; }
+      static const size_t magic_size = 8;
+      static const char NAMES = 'N';
+      static const char DRAWS = 'D';
+      static const char MESSAGE = 'M';
+    };
+
+    /**
+     * <code>binary_draws_writer</code> is an implementation of
+     * <code>writer</code> that writes draws to a stream in a binary,
+     * column-chunked format (see <code>binary_draws_format</code>).
+     *
+     * Values are buffered and written as one chunk of many rows, so
+     * no number formatting is done and the stream is written in
+     * large blocks. Pending draws are written before any message, so
+     * the order of calls is preserved. The output stream should be
+     * opened in binary mode.
+     */
+    class binary_draws_writer : public writer {
+    public:
+      /**
+       * Constructs a binary draws writer with an output stream.
+       *
+       * @param[in, out] output stream to write
+       * @param[in] chunk_bytes approximate size in bytes of the
+       *   buffered chunks of draws. At least one row is buffered.
+       */
+      explicit binary_draws_writer(std::ostream& output,
+                                   size_t chunk_bytes = 1 << 22)
+        : output_(output), chunk_bytes_(chunk_bytes), num_cols_(0),
+          chunk_rows_(0), buffered_rows_(0), started_(false) {}
+
+      /**
+       * Virtual destructor. Writes any buffered draws.
+       */
+      virtual ~binary_draws_writer() {
+        try {
+          flush();
+        } catch (...) { }
+      }
+
+      /**
+       * Writes the column names. Must be called at most once, before
+       * any draws are written.
+       *
+       * @param[in] names Names in a std::vector
+       * @throw std::logic_error if draws or names were already
+       *   written
+       */
+      void operator()(const std::vector<std::string>& names) {
+        if (num_cols_ > 0)
+          throw std::logic_error("binary_draws_writer: names must be"
+                                 " written once, before any draws");
+        start();
+        set_num_cols(names.size());
+        output_.put(binary_draws_format::NAMES);
+        write_size(names.size());
+        for (size_t i = 0; i < names.size(); ++i)
+          write_string(names[i]);
+      }
+
+      /**
+       * Buffers a row of values, writing the buffer when it holds a
+       * full chunk.
+       *
+       * @param[in] state Values in a std::vector
+       * @throw std::invalid_argument if the number of values does not
+       *   match the number of columns
+       */
+      void operator()(const std::vector<double>& state) {
+        if (state.empty())
+          return;
+        if (num_cols_ == 0) {
+          start();
+          set_num_cols(state.size());
+        }
+        if (state.size() != num_cols_)
+          throw std::invalid_argument("binary_draws_writer: number of"
+                                      " values does not match the number"
+                                      " of columns");
+        for (size_t col = 0; col < num_cols_; ++col)
+          buffer_[col * chunk_rows_ + buffered_rows_] = state[col];
+        if (++buffered_rows_ == chunk_rows_)
+          write_chunk();
+      }
+
+      /**
+       * Writes an empty message.
+       */
+      void operator()() {
+        write_message("");
+      }
+
+      /**
+       * Writes a message.
+       *
+       * @param[in] message A string
+       */
+      void operator()(const std::string& message) {
+        write_message(message);
+      }
+
+      /**
+       * Writes any buffered draws to the stream and flushes it.
+       */
+      void flush() {
+        if (buffered_rows_ > 0)
+          write_chunk();
+        output_.flush();
+      }
+
+    private:
+      /**
+       * Output stream
+       */
+      std::ostream& output_;
+
+      /**
+       * Target size of a chunk in bytes
+       */
+      size_t chunk_bytes_;
+
+      /**
+       * Number of columns; zero until names or draws are written
+       */
+      size_t num_cols_;
+
+      /**
+       * Number of rows in a full chunk
+       */
+      size_t chunk_rows_;
+
+      /**
+       * Number of rows currently held in the buffer
+       */
+      size_t buffered_rows_;
+
+      /**
+       * Indicates whether the magic string has been written
+       */
+      bool started_;
+
+      /**
+       * Chunk of draws in column-major order, with
+       * <code>chunk_rows_</code> rows
+       */
+      std::vector<double> buffer_;
+
+      void start() {
+        if (started_)
+          return;
+        output_.write(binary_draws_format::magic(),
+                      binary_draws_format::magic_size);
+        started_ = true;
+      }
+
+      void set_num_cols(size_t num_cols) {
+        num_cols_ = num_cols;
+        size_t row_bytes = num_cols_ * sizeof(double);
+        chunk_rows_ = row_bytes > 0 ? chunk_bytes_ / row_bytes : 1;
+        if (chunk_rows_ < 1)
+          chunk_rows_ = 1;
+        buffer_.resize(chunk_rows_ * num_cols_);
+      }
+
+      /**
+       * Writes the buffered rows as one chunk. The columns of the
+       * buffer are <code>chunk_rows_</code> apart, so a partial chunk
+       * is written one column at a time.
+       */
+      void write_chunk() {
+        output_.put(binary_draws_format::DRAWS);
+        write_size(buffered_rows_);
+        write_size(num_cols_);
+        if (buffered_rows_ == chunk_rows_) {
+          output_.write(reinterpret_cast<const char*>(&buffer_[0]),
+                        buffer_.size() * sizeof(double));
+        } else {
+          for (size_t col = 0; col < num_cols_; ++col)
+            output_.write(reinterpret_cast<const char*>(
+                              &buffer_[col * chunk_rows_]),
+                          buffered_rows_ * sizeof(double));
+        }
+        buffered_rows_ = 0;
+      }
+
+      void write_message(const std::string& message) {
+        start();
+        if (buffered_rows_ > 0)
+          write_chunk();
+        output_.put(binary_draws_format::MESSAGE);
+        write_string(message);
+      }
+
+      void write_size(uint64_t n) {
+        output_.write(reinterpret_cast<const char*>(&n), sizeof(n));
+      }
+
+      void write_string(const std::string& s) {
+        write_size(s.size());
+        output_.write(s.data(), s.size());
+      }
+    };
+
+  }
+}
+#endif
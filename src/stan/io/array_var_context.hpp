@@ -4,9 +4,10 @@
 #include <stan/io/var_context.hpp>
 #include <boost/throw_exception.hpp>
 #include <stan/math/prim/mat/fun/Eigen.hpp>
-#include <map>
+#include <algorithm>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
@@ -29,12 +30,16 @@ namespace stan {
      */
     class array_var_context : public var_context {
     private:
-      std::map<std::string,
-               std::pair<std::vector<double>,
-                         std::vector<size_t> > > vars_r_;
-      std::map<std::string,
-               std::pair<std::vector<int>,
-                         std::vector<size_t> > > vars_i_;
+      typedef std::unordered_map<std::string,
+                                 std::pair<std::vector<double>,
+                                           std::vector<size_t> > >
+      vars_map_r;
+      typedef std::unordered_map<std::string,
+                                 std::pair<std::vector<int>,
+                                           std::vector<size_t> > >
+      vars_map_i;
+      vars_map_r vars_r_;
+      vars_map_i vars_i_;
       std::vector<double> const empty_vec_r_;
       std::vector<int> const empty_vec_i_;
       std::vector<size_t> const empty_vec_ui_;
@@ -268,6 +273,74 @@ namespace stan {
         return empty_vec_ui_;
       }
 
+      /**
+       * Return a reference to the double values for the variable with
+       * the specified name, copying them to the buffer only if they
+       * are stored as integers.
+       *
+       * @param name Name of variable.
+       * @param buffer Storage for converted values.
+       * @return Values of variable.
+       */
+      const std::vector<double>& vals_r_ref(const std::string& name,
+                                            std::vector<double>& buffer)
+        const {
+        vars_map_r::const_iterator it = vars_r_.find(name);
+        if (it != vars_r_.end())
+          return it->second.first;
+        vars_map_i::const_iterator it_i = vars_i_.find(name);
+        if (it_i == vars_i_.end())
+          return empty_vec_r_;
+        buffer.assign(it_i->second.first.begin(), it_i->second.first.end());
+        return buffer;
+      }
+
+      /**
+       * Return a reference to the dimensions for the double variable
+       * with the specified name.
+       *
+       * @param name Name of variable.
+       * @param buffer Unused, as the dimensions are stored.
+       * @return Dimensions of variable.
+       */
+      const std::vector<size_t>& dims_r_ref(const std::string& name,
+                                            std::vector<size_t>& buffer)
+        const {
+        vars_map_r::const_iterator it = vars_r_.find(name);
+        if (it != vars_r_.end())
+          return it->second.second;
+        return dims_i_ref(name, buffer);
+      }
+
+      /**
+       * Return a reference to the integer values for the variable with
+       * the specified name.
+       *
+       * @param name Name of variable.
+       * @param buffer Unused, as the values are stored.
+       * @return Values of variable.
+       */
+      const std::vector<int>& vals_i_ref(const std::string& name,
+                                         std::vector<int>& buffer) const {
+        vars_map_i::const_iterator it = vars_i_.find(name);
+        return it == vars_i_.end() ? empty_vec_i_ : it->second.first;
+      }
+
+      /**
+       * Return a reference to the dimensions for the integer variable
+       * with the specified name.
+       *
+       * @param name Name of variable.
+       * @param buffer Unused, as the dimensions are stored.
+       * @return Dimensions of variable.
+       */
+      const std::vector<size_t>& dims_i_ref(const std::string& name,
+                                            std::vector<size_t>& buffer)
+        const {
+        vars_map_i::const_iterator it = vars_i_.find(name);
+        return it == vars_i_.end() ? empty_vec_ui_ : it->second.second;
+      }
+
       /**
        * Return a list of the names of the floating point variables in
        * the dump.
@@ -276,12 +349,10 @@ namespace stan {
        */
       virtual void names_r(std::vector<std::string>& names) const {
         names.resize(0);
-        for (std::map<std::string,
-                      std::pair<std::vector<double>,
-                                std::vector<size_t> > >
-                 ::const_iterator it = vars_r_.begin();
+        for (vars_map_r::const_iterator it = vars_r_.begin();
              it != vars_r_.end(); ++it)
           names.push_back((*it).first);
+        std::sort(names.begin(), names.end());
       }
 
       /**
@@ -292,12 +363,10 @@ namespace stan {
        */
       virtual void names_i(std::vector<std::string>& names) const {
         names.resize(0);
-        for (std::map<std::string,
-                      std::pair<std::vector<int>,
-                                std::vector<size_t> > >
-                 ::const_iterator it = vars_i_.begin();
+        for (vars_map_i::const_iterator it = vars_i_.begin();
              it != vars_i_.end(); ++it)
           names.push_back((*it).first);
+        std::sort(names.begin(), names.end());
       }
 
       /**
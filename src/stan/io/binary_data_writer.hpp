@@ -0,0 +1,161 @@
+#ifndef STAN_IO_BINARY_DATA_WRITER_HPP
+#define STAN_IO_BINARY_DATA_WRITER_HPP
+
+#include <stan/io/var_context.hpp>
+#include <cstdint>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace stan {
+
+  namespace io {
+
+    /**
+     * Constants describing the binary data format written by
+     * <code>write_binary_data</code> and read by
+     * <code>mmap_var_context</code>.
+     *
+     * A file starts with a header:
+     *
+     * <ul>
+     * <li>the 8 byte <code>magic</code> string,</li>
+     * <li>the <code>byte_order</code> marker as a
+     * <code>uint64_t</code>,</li>
+     * <li>the number of variables as a <code>uint64_t</code>,</li>
+     * <li>for each variable, the length of its name as a
+     * <code>uint64_t</code> followed by the characters, a one byte
+     * type (<code>REAL</code> or <code>INT</code>), the number of
+     * dimensions and then each dimension as a <code>uint64_t</code>,
+     * and the offset of its values from the start of the file as a
+     * <code>uint64_t</code>.</li>
+     * </ul>
+     *
+     * The values of each variable follow the header in column-major
+     * order, as doubles or as 32 bit integers, starting at an offset
+     * that is a multiple of <code>alignment</code>. All numbers are
+     * stored in the native byte order of the machine that wrote the
+     * file; the byte order marker detects files written on a machine
+     * with a different order.
+     */
+    struct binary_data_format {
+      static const char* magic() { return "STANDAT1"; }
+      static const size_t magic_size = 8;
+      static const uint64_t byte_order = 0x0102030405060708ULL;
+      static const size_t alignment = 8;
+      static const char REAL = 'R';
+      static const char INT = 'I';
+    };
+
+    namespace internal {
+
+      inline void write_binary_size(std::ostream& out, uint64_t n) {
+        out.write(reinterpret_cast<const char*>(&n), sizeof(n));
+      }
+
+      inline uint64_t align_binary_offset(uint64_t offset) {
+        const uint64_t a = binary_data_format::alignment;
+        return (offset + a - 1) / a * a;
+      }
+
+      inline uint64_t num_binary_values(const std::vector<size_t>& dims) {
+        uint64_t n = 1;
+        for (size_t i = 0; i < dims.size(); ++i)
+          n *= dims[i];
+        return n;
+      }
+
+    }
+
+    /**
+     * Write the variables of a context in the binary data format
+     * described by <code>binary_data_format</code>, so they can be
+     * read back without parsing through an
+     * <code>mmap_var_context</code>.
+     *
+     * Integer variables are stored as 32 bit integers and all other
+     * variables as doubles. The output stream should be opened in
+     * binary mode.
+     *
+     * @param[in] context variables to write
+     * @param[in,out] out stream to write to
+     */
+    inline void write_binary_data(const var_context& context,
+                                  std::ostream& out) {
+      std::vector<std::string> names_i;
+      context.names_i(names_i);
+      std::set<std::string> is_int(names_i.begin(), names_i.end());
+      std::vector<std::string> names_r;
+      context.names_r(names_r);
+
+      std::vector<std::string> names;
+      std::vector<char> types;
+      std::vector<std::vector<size_t> > dims;
+      for (size_t n = 0; n < names_r.size(); ++n) {
+        if (is_int.count(names_r[n]))
+          continue;
+        names.push_back(names_r[n]);
+        types.push_back(static_cast<char>(binary_data_format::REAL));
+        dims.push_back(context.dims_r(names_r[n]));
+      }
+      for (size_t n = 0; n < names_i.size(); ++n) {
+        names.push_back(names_i[n]);
+        types.push_back(static_cast<char>(binary_data_format::INT));
+        dims.push_back(context.dims_i(names_i[n]));
+      }
+
+      uint64_t header_size = binary_data_format::magic_size
+                             + 2 * sizeof(uint64_t);
+      for (size_t n = 0; n < names.size(); ++n)
+        header_size += sizeof(uint64_t) + names[n].size() + 1
+                       + (dims[n].size() + 2) * sizeof(uint64_t);
+
+      std::vector<uint64_t> offsets(names.size());
+      uint64_t offset = header_size;
+      for (size_t n = 0; n < names.size(); ++n) {
+        offset = internal::align_binary_offset(offset);
+        offsets[n] = offset;
+        offset += internal::num_binary_values(dims[n])
+                  * (types[n] == binary_data_format::REAL ? sizeof(double)
+                                                          : sizeof(int32_t));
+      }
+
+      out.write(binary_data_format::magic(), binary_data_format::magic_size);
+      internal::write_binary_size(out, binary_data_format::byte_order);
+      internal::write_binary_size(out, names.size());
+      for (size_t n = 0; n < names.size(); ++n) {
+        internal::write_binary_size(out, names[n].size());
+        out.write(names[n].data(), names[n].size());
+        out.put(types[n]);
+        internal::write_binary_size(out, dims[n].size());
+        for (size_t i = 0; i < dims[n].size(); ++i)
+          internal::write_binary_size(out, dims[n][i]);
+        internal::write_binary_size(out, offsets[n]);
+      }
+
+      uint64_t position = header_size;
+      for (size_t n = 0; n < names.size(); ++n) {
+        for (; position < offsets[n]; ++position)
+          out.put(0);
+        if (types[n] == binary_data_format::REAL) {
+          std::vector<double> vals = context.vals_r(names[n]);
+          if (!vals.empty())
+            out.write(reinterpret_cast<const char*>(&vals[0]),
+                      vals.size() * sizeof(double));
+          position += vals.size() * sizeof(double);
+        } else {
+          std::vector<int> vals = context.vals_i(names[n]);
+          std::vector<int32_t> vals32(vals.begin(), vals.end());
+          if (!vals32.empty())
+            out.write(reinterpret_cast<const char*>(&vals32[0]),
+                      vals32.size() * sizeof(int32_t));
+          position += vals32.size() * sizeof(int32_t);
+        }
+      }
+    }
+
+  }
+
+}
+#endif
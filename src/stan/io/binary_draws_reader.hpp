@@ -0,0 +1,358 @@
+#ifndef STAN_IO_BINARY_DRAWS_READER_HPP
+#define STAN_IO_BINARY_DRAWS_READER_HPP
+
+#include <stan/callbacks/binary_draws_writer.hpp>
+#include <stan/io/stan_csv_reader.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace io {
+
+    /**
+     * Reads draws written by <code>callbacks::binary_draws_writer</code>
+     * into a <code>stan_csv</code>, so they can be loaded into
+     * <code>stan::mcmc::chains</code> without parsing text.
+     *
+     * Column names are converted the same way as by
+     * <code>stan_csv_reader::read_header</code> and the timing
+     * messages are read into <code>stan_csv::timing</code>. Other
+     * messages are ignored.
+     */
+    class binary_draws_reader {
+    public:
+      binary_draws_reader() {}
+      ~binary_draws_reader() {}
+
+      /**
+       * Parses the stream.
+       *
+       * @param[in] in input stream to parse, opened in binary mode
+       * @param[out] out output stream to send messages
+       * @return header, draws and timing read from the stream
+       * @throw std::invalid_argument if the stream is not in the
+       *   binary draws format or is truncated
+       */
+      static stan_csv parse(std::istream& in, std::ostream* out) {
+        return parse(in, out, std::vector<std::string>());
+      }
+
+      /**
+       * Parses the stream, reading only the draws of the named
+       * columns. The values of other columns are skipped by seeking
+       * past them, so the stream must support seeking unless all
+       * columns are read.
+       *
+       * If the stream supports seeking, the draws are counted first
+       * and then read directly into the returned matrix, so they are
+       * held in memory once.
+       *
+       * @param[in] in input stream to parse, opened in binary mode
+       * @param[out] out output stream to send messages
+       * @param[in] columns names of the columns to read, as in the
+       *   returned header, in the order to return them; all columns
+       *   if empty
+       * @return header and draws of the columns read, and timing
+       * @throw std::invalid_argument if the stream is not in the
+       *   binary draws format or is truncated, or a column is not in
+       *   the header or is requested more than once
+       */
+      static stan_csv parse(std::istream& in, std::ostream* out,
+                            const std::vector<std::string>& columns) {
+        typedef callbacks::binary_draws_format format;
+        stan_csv data;
+        data.timing.warmup = 0;
+        data.timing.sampling = 0;
+        read_magic(in);
+
+        // a seekable stream is read straight into the draws, sized by
+        // a first pass over the record headers; otherwise the chunks
+        // are collected and joined at the end
+        const std::streampos start = in.tellg();
+        const bool sized = start != std::streampos(-1);
+        if (sized) {
+          size_t total_rows = 0;
+          size_t total_cols = 0;
+          count_draws(in, total_rows, total_cols);
+          in.clear();
+          in.seekg(start);
+          data.samples.resize(total_rows, columns.empty() ? total_cols
+                                                          : columns.size());
+        }
+
+        std::vector<Eigen::MatrixXd> chunks;
+        std::vector<int> col_map;
+        size_t num_cols = 0;
+        size_t num_rows = 0;
+        bool has_names = false;
+        bool has_draws = false;
+        char tag;
+        while (in.get(tag)) {
+          if (tag == format::NAMES) {
+            num_cols = read_names(in, data.header);
+            col_map = column_map(data.header, columns);
+            has_names = true;
+          } else if (tag == format::DRAWS) {
+            size_t rows = read_size(in);
+            size_t cols = read_size(in);
+            if (!has_names && !has_draws)
+              num_cols = cols;
+            has_draws = true;
+            if (cols != num_cols)
+              throw std::invalid_argument("binary_draws_reader: number of"
+                                          " columns does not match");
+            if (!columns.empty() && !has_names)
+              throw std::invalid_argument("binary_draws_reader: columns"
+                                          " selected without names");
+            if (columns.empty())
+              col_map = identity_map(cols);
+            if (sized) {
+              if (num_rows + rows
+                  > static_cast<size_t>(data.samples.rows()))
+                throw std::invalid_argument("binary_draws_reader: number"
+                                            " of rows does not match");
+              read_columns(in, col_map, data.samples, num_rows, rows);
+            } else {
+              Eigen::MatrixXd chunk(rows, columns.empty() ? cols
+                                                          : columns.size());
+              read_columns(in, col_map, chunk, 0, rows);
+              chunks.push_back(std::move(chunk));
+            }
+            num_rows += rows;
+          } else if (tag == format::MESSAGE) {
+            read_timing(read_string(in), data.timing);
+          } else {
+            if (out)
+              *out << "Error: unknown record in binary draws input"
+                   << std::endl;
+            throw std::invalid_argument("binary_draws_reader: unknown"
+                                        " record type");
+          }
+        }
+
+        if (!sized) {
+          if (chunks.size() == 1) {
+            data.samples = std::move(chunks[0]);
+          } else {
+            data.samples.resize(num_rows, columns.empty() ? num_cols
+                                                          : columns.size());
+            size_t row = 0;
+            for (size_t i = 0; i < chunks.size(); ++i) {
+              data.samples.middleRows(row, chunks[i].rows()) = chunks[i];
+              row += chunks[i].rows();
+              chunks[i].resize(0, 0);
+            }
+          }
+        } else if (num_rows != static_cast<size_t>(data.samples.rows())) {
+          throw std::invalid_argument("binary_draws_reader: number of"
+                                      " rows does not match");
+        }
+        if (!columns.empty()) {
+          Eigen::Matrix<std::string, Eigen::Dynamic, 1>
+            header(columns.size());
+          for (size_t n = 0; n < columns.size(); ++n)
+            header(n) = columns[n];
+          data.header = header;
+        }
+        return data;
+      }
+
+      /**
+       * Reads the column names at the start of the stream.
+       *
+       * @param[in] in input stream to read, opened in binary mode
+       * @param[out] header column names
+       * @return <code>false</code> if the stream does not start with
+       *   the column names
+       * @throw std::invalid_argument if the stream is not in the
+       *   binary draws format or is truncated
+       */
+      static bool read_header(std::istream& in,
+                              Eigen::Matrix<std::string,
+                                            Eigen::Dynamic, 1>& header) {
+        read_magic(in);
+        if (in.peek() != callbacks::binary_draws_format::NAMES)
+          return false;
+        in.get();
+        read_names(in, header);
+        return true;
+      }
+
+    private:
+      static void read_magic(std::istream& in) {
+        typedef callbacks::binary_draws_format format;
+        std::string magic(format::magic_size, ' ');
+        in.read(&magic[0], format::magic_size);
+        if (!in || magic != format::magic())
+          throw std::invalid_argument("binary_draws_reader: input is not"
+                                      " in the binary draws format");
+      }
+
+      static size_t
+      read_names(std::istream& in,
+                 Eigen::Matrix<std::string, Eigen::Dynamic, 1>& header) {
+        size_t num_cols = read_size(in);
+        header.resize(num_cols);
+        for (size_t col = 0; col < num_cols; ++col)
+          header(col) = format_name(read_string(in));
+        return num_cols;
+      }
+
+      /**
+       * Map from column of the stream to column of the draws read,
+       * -1 for columns not read.
+       */
+      static std::vector<int>
+      column_map(const Eigen::Matrix<std::string, Eigen::Dynamic, 1>& header,
+                 const std::vector<std::string>& columns) {
+        std::vector<int> col_map(header.size(), -1);
+        for (size_t n = 0; n < columns.size(); ++n) {
+          Eigen::Index col = 0;
+          while (col < header.size() && header(col) != columns[n])
+            ++col;
+          if (col == header.size())
+            throw std::invalid_argument("binary_draws_reader: column "
+                                        + columns[n] + " not found");
+          if (col_map[col] >= 0)
+            throw std::invalid_argument("binary_draws_reader: column "
+                                        + columns[n]
+                                        + " requested more than once");
+          col_map[col] = n;
+        }
+        return col_map;
+      }
+
+      static std::vector<int> identity_map(size_t num_cols) {
+        std::vector<int> col_map(num_cols);
+        for (size_t col = 0; col < num_cols; ++col)
+          col_map[col] = col;
+        return col_map;
+      }
+
+      /**
+       * Counts the rows of all chunks and the columns of the first,
+       * seeking past the values. Stops at the first record that
+       * cannot be read, which the reading pass then reports.
+       */
+      static void count_draws(std::istream& in, size_t& num_rows,
+                              size_t& num_cols) {
+        typedef callbacks::binary_draws_format format;
+        Eigen::Matrix<std::string, Eigen::Dynamic, 1> header;
+        bool has_cols = false;
+        char tag;
+        try {
+          while (in.get(tag)) {
+            if (tag == format::NAMES) {
+              num_cols = read_names(in, header);
+              has_cols = true;
+            } else if (tag == format::DRAWS) {
+              size_t rows = read_size(in);
+              size_t cols = read_size(in);
+              if (!has_cols)
+                num_cols = cols;
+              has_cols = true;
+              skip_bytes(in, static_cast<std::streamoff>(rows * cols
+                                                         * sizeof(double)));
+              num_rows += rows;
+            } else if (tag == format::MESSAGE) {
+              skip_bytes(in, static_cast<std::streamoff>(read_size(in)));
+            } else {
+              return;
+            }
+          }
+        } catch (const std::invalid_argument&) { }
+      }
+
+      /**
+       * Reads the mapped columns of a chunk of <code>rows</code> rows
+       * into the rows of <code>draws</code> starting at
+       * <code>first_row</code>, seeking past runs of columns that are
+       * not read.
+       */
+      static void read_columns(std::istream& in,
+                               const std::vector<int>& col_map,
+                               Eigen::MatrixXd& draws, size_t first_row,
+                               size_t rows) {
+        const std::streamoff col_bytes = rows * sizeof(double);
+        std::streamoff skip = 0;
+        for (size_t col = 0; col < col_map.size(); ++col) {
+          if (col_map[col] < 0) {
+            skip += col_bytes;
+            continue;
+          }
+          if (skip > 0)
+            skip_bytes(in, skip);
+          skip = 0;
+          double* x = draws.col(col_map[col]).data() + first_row;
+          read_bytes(in, reinterpret_cast<char*>(x), col_bytes);
+        }
+        if (skip > 0)
+          skip_bytes(in, skip);
+      }
+
+      static void skip_bytes(std::istream& in, std::streamoff n) {
+        if (!in.seekg(n, std::ios_base::cur))
+          throw std::invalid_argument("binary_draws_reader: unexpected"
+                                      " end of input");
+      }
+
+      static void read_bytes(std::istream& in, char* buf, size_t n) {
+        in.read(buf, n);
+        if (static_cast<size_t>(in.gcount()) != n)
+          throw std::invalid_argument("binary_draws_reader: unexpected"
+                                      " end of input");
+      }
+
+      static size_t read_size(std::istream& in) {
+        uint64_t n;
+        read_bytes(in, reinterpret_cast<char*>(&n), sizeof(n));
+        return n;
+      }
+
+      static std::string read_string(std::istream& in) {
+        std::string s(read_size(in), ' ');
+        if (!s.empty())
+          read_bytes(in, &s[0], s.size());
+        return s;
+      }
+
+      /**
+       * Converts a name such as <code>theta.1.2</code> to
+       * <code>theta[1,2]</code>.
+       */
+      static std::string format_name(std::string name) {
+        size_t pos = name.find('.');
+        if (pos != std::string::npos && pos > 0) {
+          name.replace(pos, 1, "[");
+          std::replace(name.begin(), name.end(), '.', ',');
+          name += "]";
+        }
+        return name;
+      }
+
+      static void read_timing(const std::string& message,
+                              stan_csv_timing& timing) {
+        size_t right = message.find(" seconds");
+        if (right == std::string::npos)
+          return;
+        size_t left = message.find_last_of(' ', right - 1);
+        left = (left == std::string::npos) ? 0 : left + 1;
+        double seconds = 0;
+        std::stringstream(message.substr(left, right - left)) >> seconds;
+        if (message.find("(Warm-up)") != std::string::npos)
+          timing.warmup += seconds;
+        else if (message.find("(Sampling)") != std::string::npos)
+          timing.sampling += seconds;
+      }
+    };
+
+  }
+}
+#endif
@@ -43,7 +43,34 @@ namespace stan {
       }
 
       std::vector<size_t> dims_i(const std::string& name) const {
-        return vc1_.contains_r(name) ? vc1_.dims_i(name) : vc2_.dims_i(name);
+        return vc1_.contains_i(name) ? vc1_.dims_i(name) : vc2_.dims_i(name);
+      }
+
+      const std::vector<double>& vals_r_ref(const std::string& name,
+                                            std::vector<double>& buffer)
+        const {
+        return vc1_.contains_r(name) ? vc1_.vals_r_ref(name, buffer)
+                                     : vc2_.vals_r_ref(name, buffer);
+      }
+
+      const std::vector<int>& vals_i_ref(const std::string& name,
+                                         std::vector<int>& buffer) const {
+        return vc1_.contains_i(name) ? vc1_.vals_i_ref(name, buffer)
+                                     : vc2_.vals_i_ref(name, buffer);
+      }
+
+      const std::vector<size_t>& dims_r_ref(const std::string& name,
+                                            std::vector<size_t>& buffer)
+        const {
+        return vc1_.contains_r(name) ? vc1_.dims_r_ref(name, buffer)
+                                     : vc2_.dims_r_ref(name, buffer);
+      }
+
+      const std::vector<size_t>& dims_i_ref(const std::string& name,
+                                            std::vector<size_t>& buffer)
+        const {
+        return vc1_.contains_i(name) ? vc1_.dims_i_ref(name, buffer)
+                                     : vc2_.dims_i_ref(name, buffer);
       }
 
       void names_r(std::vector<std::string>& names) const {
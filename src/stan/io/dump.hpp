@@ -1,6 +1,7 @@
 #ifndef STAN_IO_DUMP_HPP
 #define STAN_IO_DUMP_HPP
 
+#include <stan/io/fast_parse_double.hpp>
 #include <stan/io/validate_zero_buf.hpp>
 #include <stan/io/var_context.hpp>
 #include <stan/math/prim/mat.hpp>
@@ -10,12 +11,14 @@
 #include <boost/type_traits/is_integral.hpp>
 #include <boost/type_traits/is_arithmetic.hpp>
 #include <boost/utility/enable_if.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <limits>
-#include <map>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 #include <cctype>
@@ -51,6 +54,10 @@ namespace stan {
      * array contains a single entry for the number of values.
      * For an array, the dimensions are the dimensions of the array.
      *
+     * <p>The reader reads the stream in large blocks, so it may read
+     * past the end of the last variable returned by
+     * <code>next()</code>.
+     *
      * <p>Reads are performed in an "S-compatible" mode whereby
      * a string such as "1" or "-127" denotes and integer, whereas
      * a string such as "1." or "0.9e-5" represents a floating
@@ -121,14 +128,65 @@ namespace stan {
       std::vector<double> stack_r_;
       std::vector<size_t> dims_;
       std::istream& in_;
+      std::vector<char> block_;
+      size_t pos_;
+      size_t end_;
+
+      static size_t block_size() {
+        return 1 << 16;
+      }
+
+      /**
+       * Make at least n unread characters available in the block,
+       * reading from the stream as needed, and return
+       * <code>true</code> if there are that many before the end of
+       * the stream.  Unread characters keep their offset from
+       * <code>pos_</code>.
+       */
+      bool fill(size_t n) {
+        if (end_ - pos_ >= n)
+          return true;
+        if (pos_ > 0) {
+          std::copy(block_.begin() + pos_, block_.begin() + end_,
+                    block_.begin());
+          end_ -= pos_;
+          pos_ = 0;
+        }
+        if (block_.size() < std::max(n, block_size()))
+          block_.resize(std::max(n, std::max(block_size(),
+                                             2 * block_.size())));
+        while (end_ < n && in_.good()) {
+          in_.read(&block_[end_], block_.size() - end_);
+          end_ += in_.gcount();
+        }
+        return end_ >= n;
+      }
+
+      // character n past the next unread character; call fill(n + 1)
+      char char_at(size_t n) const {
+        return block_[pos_ + n];
+      }
+
+      bool next_char(char& c) {
+        if (!fill(1))
+          return false;
+        c = block_[pos_];
+        return true;
+      }
+
+      // offset of the first non-space character at or after n
+      size_t skip_space(size_t n) {
+        while (fill(n + 1)
+               && std::isspace(static_cast<unsigned char>(char_at(n))))
+          ++n;
+        return n;
+      }
 
       bool scan_single_char(char c_expected) {
-        int c = in_.peek();
-        if (in_.fail()) return false;
-        if (c != c_expected)
+        char c;
+        if (!next_char(c) || c != c_expected)
           return false;
-        char c_skip;
-        in_.get(c_skip);
+        ++pos_;
         return true;
       }
 
@@ -142,31 +200,22 @@ namespace stan {
       }
 
       bool scan_char(char c_expected) {
-        char c;
-        in_ >> c;
-        if (in_.fail()) return false;
-        if (c != c_expected) {
-          in_.putback(c);
-          return false;
-        }
-        return true;
+        pos_ += skip_space(0);
+        return scan_single_char(c_expected);
       }
 
       bool scan_name_unquoted() {
         char c;
-        in_ >> c;
-        if (in_.fail()) return false;
-        if (!std::isalpha(c)) return false;
-        name_.push_back(c);
-        while (in_.get(c)) {  // get turns off auto space skip
-          if (std::isalpha(c) || std::isdigit(c) || c == '_' || c == '.') {
-            name_.push_back(c);
-          } else {
-            in_.putback(c);
-            return true;
-          }
-        }
-        return true;  // but hit eos
+        pos_ += skip_space(0);
+        if (!next_char(c) || !std::isalpha(static_cast<unsigned char>(c)))
+          return false;
+        do {
+          name_.push_back(c);
+          ++pos_;
+        } while (next_char(c)
+                 && (std::isalnum(static_cast<unsigned char>(c))
+                     || c == '_' || c == '.'));
+        return true;
       }
 
       bool scan_name() {
@@ -182,65 +231,51 @@ namespace stan {
         return true;
       }
 
-
+      /**
+       * Scan the specified characters, each optionally preceded by
+       * space.  If they do not all match, only the space before the
+       * first is consumed.
+       */
       bool scan_chars(const char *s, bool case_sensitive = true) {
+        pos_ += skip_space(0);
+        size_t n = 0;
         for (size_t i = 0; s[i]; ++i) {
-          char c;
-          if (!(in_ >> c)) {
-            for (size_t j = 1; j < i; ++j)
-              in_.putback(s[i-j]);
+          n = skip_space(n);
+          if (!fill(n + 1))
             return false;
-          }
+          char c = char_at(n);
           // all ASCII, so toupper is OK
           if ((case_sensitive && c != s[i])
-              || (!case_sensitive && ::toupper(c) != ::toupper(s[i]))) {
-            in_.putback(c);
-            for (size_t j = 1; j < i; ++j)
-              in_.putback(s[i-j]);
+              || (!case_sensitive && ::toupper(c) != ::toupper(s[i])))
             return false;
-          }
+          ++n;
         }
+        pos_ += n;
         return true;
       }
 
-      bool scan_chars(std::string s, bool case_sensitive = true) {
-        for (size_t i = 0; i < s.size(); ++i) {
-          char c;
-          if (!(in_ >> c)) {
-            for (size_t j = 1; j < i; ++j)
-              in_.putback(s[i-j]);
-            return false;
-          }
-          // all ASCII, so toupper is OK
-          if ((case_sensitive && c != s[i])
-              || (!case_sensitive && ::toupper(c) != ::toupper(s[i]))) {
-            in_.putback(c);
-            for (size_t j = 1; j < i; ++j)
-              in_.putback(s[i-j]);
-            return false;
-          }
-        }
-        return true;
+      bool scan_chars(const std::string& s, bool case_sensitive = true) {
+        return scan_chars(s.c_str(), case_sensitive);
       }
 
-      size_t scan_dim() {
-        char c;
+      // append digits to buf_, skipping any space, as R does for dims
+      void scan_digits_and_space() {
         buf_.clear();
-        while (in_.get(c)) {
-          if (std::isspace(c)) continue;
-          if (std::isdigit(c)) {
+        char c;
+        while (next_char(c)) {
+          if (std::isdigit(static_cast<unsigned char>(c)))
             buf_.push_back(c);
-          } else {
-            in_.putback(c);
+          else if (!std::isspace(static_cast<unsigned char>(c)))
             break;
-          }
+          ++pos_;
         }
+      }
+
+      size_t scan_dim() {
+        scan_digits_and_space();
         scan_optional_long();
         size_t d = 0;
-        try {
-          d = boost::lexical_cast<size_t>(buf_);
-        }
-        catch ( const boost::bad_lexical_cast &exc ) {
+        if (!parse_digits(std::numeric_limits<size_t>::max(), d)) {
           std::string msg = "value " + buf_ + " beyond array dimension range";
           BOOST_THROW_EXCEPTION(std::invalid_argument(msg));
         }
@@ -248,34 +283,41 @@ namespace stan {
       }
 
       int scan_int() {
-        char c;
-        buf_.clear();
-        while (in_.get(c)) {
-          if (std::isspace(c)) continue;
-          if (std::isdigit(c)) {
-            buf_.push_back(c);
-          } else {
-            in_.putback(c);
-            break;
-          }
-        }
+        scan_digits_and_space();
         return(get_int());
       }
 
-      int get_int() {
-        int n = 0;
-        try {
-          n = boost::lexical_cast<int>(buf_);
+      /**
+       * Convert the digits in buf_ to an integer no greater than the
+       * specified maximum, returning <code>false</code> if there are no
+       * digits or the value is too large.
+       */
+      bool parse_digits(size_t max, size_t& n) const {
+        if (buf_.empty())
+          return false;
+        n = 0;
+        for (size_t i = 0; i < buf_.size(); ++i) {
+          size_t d = buf_[i] - '0';
+          if (n > (max - d) / 10)
+            return false;
+          n = n * 10 + d;
         }
-        catch ( const boost::bad_lexical_cast &exc ) {
+        return true;
+      }
+
+      int get_int() {
+        size_t n = 0;
+        if (!parse_digits(std::numeric_limits<int>::max(), n)) {
           std::string msg = "value " + buf_ + " beyond int range";
           BOOST_THROW_EXCEPTION(std::invalid_argument(msg));
         }
-        return n;
+        return static_cast<int>(n);
       }
 
       double scan_double() {
         double x = 0;
+        if (fast_parse_double(buf_, x))
+          return x;
         try {
           x = boost::lexical_cast<double>(buf_);
           if (x == 0)
@@ -308,8 +350,9 @@ namespace stan {
         char c;
         bool is_double = false;
         buf_.clear();
-        while (in_.get(c)) {
-          if (std::isdigit(c)) {  // before pre-scan || c == '-' || c == '+') {
+        while (next_char(c)) {
+          // before pre-scan || c == '-' || c == '+') {
+          if (std::isdigit(static_cast<unsigned char>(c))) {
             buf_.push_back(c);
           } else if (c == '.'
                      || c == 'e'
@@ -319,35 +362,45 @@ namespace stan {
             is_double = true;
             buf_.push_back(c);
           } else {
-            in_.putback(c);
             break;
           }
+          ++pos_;
         }
         if (!is_double && stack_r_.size() == 0) {
           int n = get_int();
           stack_i_.push_back(negate_val ? -n : n);
           scan_optional_long();
         } else {
-          for (size_t j = 0; j < stack_i_.size(); ++j)
-            stack_r_.push_back(static_cast<double>(stack_i_[j]));
-          stack_i_.clear();
+          if (!stack_i_.empty()) {
+            stack_r_.assign(stack_i_.begin(), stack_i_.end());
+            stack_i_.clear();
+          }
           double x = scan_double();
           stack_r_.push_back(negate_val ? -x : x);
         }
       }
 
       void scan_number() {
-        char c;
-        while (in_.get(c)) {
-          if (std::isspace(c)) continue;
-          in_.putback(c);
-          break;
-        }
+        pos_ += skip_space(0);
         bool negate_val = scan_char('-');
         if (!negate_val) scan_char('+');  // flush leading +
         return scan_number(negate_val);
       }
 
+      bool push_range(int start, int end) {
+        // in a wider type, as end - start can overflow an int
+        const int64_t step = start <= end ? 1 : -1;
+        const uint64_t size = static_cast<uint64_t>(
+            (static_cast<int64_t>(end) - start) * step) + 1;
+        if (size > stack_i_.max_size() - stack_i_.size())
+          return false;
+        stack_i_.reserve(stack_i_.size() + size);
+        int64_t i = start;
+        for (uint64_t n = 0; n < size; ++n, i += step)
+          stack_i_.push_back(static_cast<int>(i));
+        return true;
+      }
+
       bool scan_zero_integers() {
         if (!scan_char('(')) return false;
         if (scan_char(')')) {
@@ -356,9 +409,7 @@ namespace stan {
         }
         int s = scan_int();
         if (s < 0) return false;
-        for (int i = 0; i < s; ++i) {
-          stack_i_.push_back(0);
-        }
+        stack_i_.assign(s, 0);
         if (!scan_char(')')) return false;
         dims_.push_back(s);
         return true;
@@ -372,9 +423,7 @@ namespace stan {
         }
         int s = scan_int();
         if (s < 0) return false;
-        for (int i = 0; i < s; ++i) {
-          stack_r_.push_back(0);
-        }
+        stack_r_.assign(s, 0);
         if (!scan_char(')')) return false;
         dims_.push_back(s);
         return true;
@@ -408,13 +457,8 @@ namespace stan {
           if (!scan_char(':'))
             return false;
           int end = scan_int();
-          if (start <= end) {
-            for (int i = start; i <= end; ++i)
-              stack_i_.push_back(i);
-          } else {
-            for (int i = start; i >= end; --i)
-              stack_i_.push_back(i);
-          }
+          if (!push_range(start, end))
+            return false;
         }
         dims_.clear();
         if (!scan_char(',')) return false;
@@ -467,13 +511,8 @@ namespace stan {
         int start = stack_i_[0];
         int end = stack_i_[1];
         stack_i_.clear();
-        if (start <= end) {
-          for (int i = start; i <= end; ++i)
-            stack_i_.push_back(i);
-        } else {
-          for (int i = start; i >= end; --i)
-            stack_i_.push_back(i);
-        }
+        if (!push_range(start, end))
+          return false;
         dims_.push_back(stack_i_.size());
         return true;
       }
@@ -485,7 +524,8 @@ namespace stan {
        *
        * @param in Input stream reference from which to read.
        */
-      explicit dump_reader(std::istream& in) : in_(in) { }
+      explicit dump_reader(std::istream& in)
+        : in_(in), pos_(0), end_(0) { }
 
       /**
        * Destroy this reader.
@@ -598,12 +638,16 @@ namespace stan {
      */
     class dump : public stan::io::var_context {
     private:
-      std::map<std::string,
-               std::pair<std::vector<double>,
-                         std::vector<size_t> > > vars_r_;
-      std::map<std::string,
-               std::pair<std::vector<int>,
-                         std::vector<size_t> > > vars_i_;
+      typedef std::unordered_map<std::string,
+                                 std::pair<std::vector<double>,
+                                           std::vector<size_t> > >
+      vars_map_r;
+      typedef std::unordered_map<std::string,
+                                 std::pair<std::vector<int>,
+                                           std::vector<size_t> > >
+      vars_map_i;
+      vars_map_r vars_r_;
+      vars_map_i vars_i_;
       std::vector<double> const empty_vec_r_;
       std::vector<int> const empty_vec_i_;
       std::vector<size_t> const empty_vec_ui_;
@@ -633,15 +677,10 @@ namespace stan {
         while (reader.next()) {
           if (reader.is_int()) {
             vars_i_[reader.name()]
-              = std::pair<std::vector<int>,
-                          std::vector<size_t> >(reader.int_values(),
-                                                reader.dims());
-
+              = std::make_pair(reader.int_values(), reader.dims());
           } else {
             vars_r_[reader.name()]
-              = std::pair<std::vector<double>,
-                          std::vector<size_t> >(reader.double_values(),
-                                                reader.dims());
+              = std::make_pair(reader.double_values(), reader.dims());
           }
         }
       }
@@ -735,6 +774,74 @@ namespace stan {
         return empty_vec_ui_;
       }
 
+      /**
+       * Return a reference to the double values for the variable with
+       * the specified name, copying them to the buffer only if they
+       * are stored as integers.
+       *
+       * @param name Name of variable.
+       * @param buffer Storage for converted values.
+       * @return Values of variable.
+       */
+      const std::vector<double>& vals_r_ref(const std::string& name,
+                                            std::vector<double>& buffer)
+        const {
+        vars_map_r::const_iterator it = vars_r_.find(name);
+        if (it != vars_r_.end())
+          return it->second.first;
+        vars_map_i::const_iterator it_i = vars_i_.find(name);
+        if (it_i == vars_i_.end())
+          return empty_vec_r_;
+        buffer.assign(it_i->second.first.begin(), it_i->second.first.end());
+        return buffer;
+      }
+
+      /**
+       * Return a reference to the dimensions for the double variable
+       * with the specified name.
+       *
+       * @param name Name of variable.
+       * @param buffer Unused, as the dimensions are stored.
+       * @return Dimensions of variable.
+       */
+      const std::vector<size_t>& dims_r_ref(const std::string& name,
+                                            std::vector<size_t>& buffer)
+        const {
+        vars_map_r::const_iterator it = vars_r_.find(name);
+        if (it != vars_r_.end())
+          return it->second.second;
+        return dims_i_ref(name, buffer);
+      }
+
+      /**
+       * Return a reference to the integer values for the variable with
+       * the specified name.
+       *
+       * @param name Name of variable.
+       * @param buffer Unused, as the values are stored.
+       * @return Values of variable.
+       */
+      const std::vector<int>& vals_i_ref(const std::string& name,
+                                         std::vector<int>& buffer) const {
+        vars_map_i::const_iterator it = vars_i_.find(name);
+        return it == vars_i_.end() ? empty_vec_i_ : it->second.first;
+      }
+
+      /**
+       * Return a reference to the dimensions for the integer variable
+       * with the specified name.
+       *
+       * @param name Name of variable.
+       * @param buffer Unused, as the dimensions are stored.
+       * @return Dimensions of variable.
+       */
+      const std::vector<size_t>& dims_i_ref(const std::string& name,
+                                            std::vector<size_t>& buffer)
+        const {
+        vars_map_i::const_iterator it = vars_i_.find(name);
+        return it == vars_i_.end() ? empty_vec_ui_ : it->second.second;
+      }
+
       /**
        * Return a list of the names of the floating point variables in
        * the dump.
@@ -743,12 +850,10 @@ namespace stan {
        */
       virtual void names_r(std::vector<std::string>& names) const {
         names.resize(0);
-        for (std::map<std::string,
-                      std::pair<std::vector<double>,
-                                std::vector<size_t> > >
-                 ::const_iterator it = vars_r_.begin();
+        for (vars_map_r::const_iterator it = vars_r_.begin();
              it != vars_r_.end(); ++it)
           names.push_back((*it).first);
+        std::sort(names.begin(), names.end());
       }
 
       /**
@@ -759,12 +864,10 @@ namespace stan {
        */
       virtual void names_i(std::vector<std::string>& names) const {
         names.resize(0);
-        for (std::map<std::string,
-                      std::pair<std::vector<int>,
-                                std::vector<size_t> > >
-                 ::const_iterator it = vars_i_.begin();
+        for (vars_map_i::const_iterator it = vars_i_.begin();
              it != vars_i_.end(); ++it)
           names.push_back((*it).first);
+        std::sort(names.begin(), names.end());
       }
 
       /**
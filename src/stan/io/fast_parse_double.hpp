@@ -0,0 +1,108 @@
+#ifndef STAN_IO_FAST_PARSE_DOUBLE_HPP
+#define STAN_IO_FAST_PARSE_DOUBLE_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace stan {
+  namespace io {
+
+    /**
+     * Convert a decimal number to a double without the locale-aware
+     * stream machinery, if the conversion can be done exactly.
+     *
+     * The buffer must hold an optional sign, digits with at most one
+     * decimal point, and an optional exponent (<code>e</code> or
+     * <code>E</code>, optional sign, digits), with at least one digit
+     * before the exponent.  The conversion succeeds if there are at
+     * most 18 significant digits, the digits as an integer are at most
+     * 2^53, and the decimal exponent is at most 22 in magnitude.  The
+     * digits and the power of ten are then both exact doubles, so the
+     * single multiplication or division that combines them is
+     * correctly rounded, giving the same result as
+     * <code>strtod</code>.  Other input, including malformed input,
+     * is left to the caller.
+     *
+     * The buffer argument must implement <code>size_t size()</code>
+     * and <code>char operator[](size_t)</code>.
+     *
+     * @tparam B Character buffer type
+     * @param[in] buf characters of the number
+     * @param[out] x value, set only on success
+     * @return <code>true</code> if the number was converted
+     */
+    template <typename B>
+    bool fast_parse_double(const B& buf, double& x) {
+      static const double pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+      };
+      const int max_pow10 = 22;
+      const uint64_t max_mantissa = uint64_t(1) << 53;
+      const size_t n = buf.size();
+      size_t i = 0;
+      bool negative = false;
+      if (i < n && (buf[i] == '-' || buf[i] == '+'))
+        negative = buf[i++] == '-';
+
+      uint64_t mantissa = 0;
+      int num_digits = 0;
+      int num_sig_digits = 0;
+      int exponent = 0;
+      bool seen_point = false;
+      for (; i < n; ++i) {
+        char c = buf[i];
+        if (c >= '0' && c <= '9') {
+          ++num_digits;
+          if (mantissa != 0 || c != '0')
+            if (++num_sig_digits > 18)
+              return false;
+          mantissa = mantissa * 10 + (c - '0');
+          if (seen_point)
+            --exponent;
+        } else if (c == '.' && !seen_point) {
+          seen_point = true;
+        } else {
+          break;
+        }
+      }
+      if (num_digits == 0)
+        return false;
+
+      if (i < n) {
+        if (buf[i] != 'e' && buf[i] != 'E')
+          return false;
+        ++i;
+        bool exp_negative = false;
+        if (i < n && (buf[i] == '-' || buf[i] == '+'))
+          exp_negative = buf[i++] == '-';
+        if (i == n)
+          return false;
+        int e = 0;
+        for (; i < n; ++i) {
+          if (buf[i] < '0' || buf[i] > '9')
+            return false;
+          if (e < 10000)
+            e = e * 10 + (buf[i] - '0');
+        }
+        exponent += exp_negative ? -e : e;
+      }
+
+      if (mantissa > max_mantissa)
+        return false;
+      double y;
+      if (mantissa == 0)
+        y = 0;
+      else if (exponent >= 0 && exponent <= max_pow10)
+        y = static_cast<double>(mantissa) * pow10[exponent];
+      else if (exponent < 0 && exponent >= -max_pow10)
+        y = static_cast<double>(mantissa) / pow10[-exponent];
+      else
+        return false;
+      x = negative ? -y : y;
+      return true;
+    }
+
+  }
+}
+#endif
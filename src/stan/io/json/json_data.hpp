@@ -7,12 +7,13 @@
 #include <stan/io/json/json_error.hpp>
 #include <stan/io/json/json_parser.hpp>
 #include <stan/io/json/json_data_handler.hpp>
+#include <algorithm>
 #include <cctype>
 #include <iostream>
 #include <limits>
-#include <map>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace stan {
@@ -166,6 +167,74 @@ namespace stan {
         return empty_vec_ui_;
       }
 
+      /**
+       * Return a reference to the double values for the variable with
+       * the specified name, copying them to the buffer only if they
+       * are stored as integers.
+       *
+       * @param name Name of variable.
+       * @param buffer Storage for converted values.
+       * @return Values of variable.
+       */
+      const std::vector<double>& vals_r_ref(const std::string& name,
+                                            std::vector<double>& buffer)
+        const {
+        vars_map_r::const_iterator it = vars_r_.find(name);
+        if (it != vars_r_.end())
+          return it->second.first;
+        vars_map_i::const_iterator it_i = vars_i_.find(name);
+        if (it_i == vars_i_.end())
+          return empty_vec_r_;
+        buffer.assign(it_i->second.first.begin(), it_i->second.first.end());
+        return buffer;
+      }
+
+      /**
+       * Return a reference to the dimensions for the double variable
+       * with the specified name.
+       *
+       * @param name Name of variable.
+       * @param buffer Unused, as the dimensions are stored.
+       * @return Dimensions of variable.
+       */
+      const std::vector<size_t>& dims_r_ref(const std::string& name,
+                                            std::vector<size_t>& buffer)
+        const {
+        vars_map_r::const_iterator it = vars_r_.find(name);
+        if (it != vars_r_.end())
+          return it->second.second;
+        return dims_i_ref(name, buffer);
+      }
+
+      /**
+       * Return a reference to the integer values for the variable with
+       * the specified name.
+       *
+       * @param name Name of variable.
+       * @param buffer Unused, as the values are stored.
+       * @return Values of variable.
+       */
+      const std::vector<int>& vals_i_ref(const std::string& name,
+                                         std::vector<int>& buffer) const {
+        vars_map_i::const_iterator it = vars_i_.find(name);
+        return it == vars_i_.end() ? empty_vec_i_ : it->second.first;
+      }
+
+      /**
+       * Return a reference to the dimensions for the integer variable
+       * with the specified name.
+       *
+       * @param name Name of variable.
+       * @param buffer Unused, as the dimensions are stored.
+       * @return Dimensions of variable.
+       */
+      const std::vector<size_t>& dims_i_ref(const std::string& name,
+                                            std::vector<size_t>& buffer)
+        const {
+        vars_map_i::const_iterator it = vars_i_.find(name);
+        return it == vars_i_.end() ? empty_vec_ui_ : it->second.second;
+      }
+
       /**
        * Return a list of the names of the floating point variables in
        * the json_data.
@@ -177,6 +246,7 @@ namespace stan {
         for (vars_map_r::const_iterator it = vars_r_.begin();
              it != vars_r_.end(); ++it)
           names.push_back((*it).first);
+        std::sort(names.begin(), names.end());
       }
 
       /**
@@ -190,6 +260,7 @@ namespace stan {
         for (vars_map_i::const_iterator it = vars_i_.begin();
              it != vars_i_.end(); ++it)
           names.push_back((*it).first);
+        std::sort(names.begin(), names.end());
       }
 
       /**
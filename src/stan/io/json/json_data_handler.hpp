@@ -7,12 +7,13 @@
 #include <stan/io/json/json_error.hpp>
 #include <stan/io/json/json_parser.hpp>
 #include <stan/io/json/json_handler.hpp>
+#include <algorithm>
 #include <cctype>
 #include <iostream>
 #include <limits>
-#include <map>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
@@ -21,15 +22,15 @@ namespace stan {
   namespace json {
 
     typedef
-    std::map<std::string,
-             std::pair<std::vector<double>,
-                       std::vector<size_t> > >
+    std::unordered_map<std::string,
+                       std::pair<std::vector<double>,
+                                 std::vector<size_t> > >
     vars_map_r;
 
     typedef
-    std::map<std::string,
-             std::pair<std::vector<int>,
-                       std::vector<size_t> > >
+    std::unordered_map<std::string,
+                       std::pair<std::vector<int>,
+                                 std::vector<size_t> > >
     vars_map_i;
 
     /**
@@ -251,6 +252,27 @@ namespace stan {
         incr_dim_size();
       }
 
+      void number_doubles(const double* x, size_t n) {
+        set_last_dim();
+        if (is_int_) {
+          values_r_.assign(values_i_.begin(), values_i_.end());
+          values_i_.clear();
+        }
+        is_int_ = false;
+        values_r_.insert(values_r_.end(), x, x + n);
+        incr_dim_size(n);
+      }
+
+      // NOLINTNEXTLINE(runtime/int)
+      void number_longs(const long* x, size_t n) {
+        set_last_dim();
+        if (is_int_)
+          values_i_.insert(values_i_.end(), x, x + n);
+        else
+          values_r_.insert(values_r_.end(), x, x + n);
+        incr_dim_size(n);
+      }
+
       void save_current_key_value_pair() {
         if (0 == key_.size()) return;
 
@@ -262,49 +284,93 @@ namespace stan {
             throw json_error(errorMsg.str());
         }
 
-        // transpose order of array values to column-major
+        // transpose order of array values to column-major;
+        // the values are moved into the map, as reset() follows
         if (is_int_) {
           std::pair<std::vector<int>,
-                    std::vector<size_t> > pair;
+                    std::vector<size_t> >& pair = vars_i_[key_];
+          pair.second = dims_;
           if (dims_.size() > 1) {
-            std::vector<int> cm_values_i(values_i_.size());
-            to_column_major(cm_values_i, values_i_, dims_);
-            pair = make_pair(cm_values_i, dims_);
-
+            pair.first.resize(values_i_.size());
+            to_column_major(pair.first, values_i_, dims_);
           } else {
-            pair = make_pair(values_i_, dims_);
+            pair.first.swap(values_i_);
           }
-          vars_i_[key_] = pair;
         } else {
           std::pair<std::vector<double>,
-                    std::vector<size_t> > pair;
+                    std::vector<size_t> >& pair = vars_r_[key_];
+          pair.second = dims_;
           if (dims_.size() > 1) {
-            std::vector<double> cm_values_r(values_r_.size());
-            to_column_major(cm_values_r, values_r_, dims_);
-            pair = make_pair(cm_values_r, dims_);
+            pair.first.resize(values_r_.size());
+            to_column_major(pair.first, values_r_, dims_);
           } else {
-            pair = make_pair(values_r_, dims_);
+            pair.first.swap(values_r_);
           }
-          vars_r_[key_] = pair;
         }
       }
 
-      void incr_dim_size() {
+      void incr_dim_size(size_t n = 1) {
         if (dim_idx_ > 0) {
           if (dims_unknown_[dim_idx_-1])
-            dims_[dim_idx_-1]++;
+            dims_[dim_idx_-1] += n;
           else
-            dims_verify_[dim_idx_-1]++;
+            dims_verify_[dim_idx_-1] += n;
         }
       }
 
+      /**
+       * Copy values from row-major to column-major order.
+       *
+       * <p>Reversing the order of the dimensions moves the first index
+       * from slowest to fastest varying and the last from fastest to
+       * slowest, so for each combination of the middle indices the
+       * values form a matrix indexed by the first and last index that
+       * is transposed.  The transpose is done in square tiles, so that
+       * both the rows read and the columns written stay in cache.
+       *
+       * @tparam T type of values
+       * @param[out] cm_vals values in column-major order, sized to
+       *   match <code>rm_vals</code>
+       * @param[in] rm_vals values in row-major order
+       * @param[in] dims dimensions, at least two
+       */
       template <typename T>
       void to_column_major(std::vector<T>& cm_vals,
                            const std::vector<T>& rm_vals,
                            const std::vector<size_t>& dims) {
-        for (size_t i = 0; i< rm_vals.size(); i++) {
-          size_t idx = convert_offset_rtl_2_ltr(i, dims);
-          cm_vals[idx] = rm_vals[i];
+        const size_t tile = 32;
+        const size_t num_rows = dims.front();
+        const size_t num_cols = dims.back();
+        std::vector<size_t> middle_dims(dims.begin() + 1, dims.end() - 1);
+        size_t num_middle = 1;
+        for (size_t i = 0; i < middle_dims.size(); ++i)
+          num_middle *= middle_dims[i];
+        if (rm_vals.size() != num_rows * num_middle * num_cols) {
+          std::stringstream errorMsg;
+          errorMsg << "variable: " << key_ << ", unexpected error";
+          throw json_error(errorMsg.str());
+        }
+        if (rm_vals.empty())
+          return;
+
+        // row-major:    ((row * num_middle) + m_rm) * num_cols + col
+        // column-major: row + num_rows * (m_cm + num_middle * col)
+        const size_t rm_row_stride = num_middle * num_cols;
+        const size_t cm_col_stride = num_rows * num_middle;
+        for (size_t m = 0; m < num_middle; ++m) {
+          size_t m_cm = middle_dims.empty()
+              ? 0 : convert_offset_rtl_2_ltr(m, middle_dims);
+          const T* src = rm_vals.data() + m * num_cols;
+          T* dest = cm_vals.data() + num_rows * m_cm;
+          for (size_t r0 = 0; r0 < num_rows; r0 += tile) {
+            size_t r1 = std::min(r0 + tile, num_rows);
+            for (size_t c0 = 0; c0 < num_cols; c0 += tile) {
+              size_t c1 = std::min(c0 + tile, num_cols);
+              for (size_t r = r0; r < r1; ++r)
+                for (size_t c = c0; c < c1; ++c)
+                  dest[r + c * cm_col_stride] = src[r * rm_row_stride + c];
+            }
+          }
         }
       }
 
@@ -1,6 +1,7 @@
 #ifndef STAN_IO_JSON_JSON_HANDLER_HPP
 #define STAN_IO_JSON_JSON_HANDLER_HPP
 
+#include <cstddef>
 #include <string>
 
 namespace stan {
@@ -84,6 +85,40 @@ namespace stan {
       // NOLINTNEXTLINE(runtime/int)
       virtual void number_unsigned_long(unsigned long n) { }
 
+      /**
+       * Handle a run of consecutive double-precision floating point
+       * values within an array.  By default each value is passed to
+       * <code>number_double()</code>; handlers that store arrays can
+       * override this to copy the values in one step.
+       *
+       * @param x Pointer to first value.
+       * @param n Number of values.
+       */
+      virtual void number_doubles(const double* x, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+          number_double(x[i]);
+      }
+
+      /**
+       * Handle a run of consecutive integer values within an array.
+       * By default negative values are passed to
+       * <code>number_long()</code> and other values to
+       * <code>number_unsigned_long()</code>, as they are for single
+       * values.
+       *
+       * @param x Pointer to first value.
+       * @param n Number of values.
+       */
+      // NOLINTNEXTLINE(runtime/int)
+      virtual void number_longs(const long* x, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+          if (x[i] < 0)
+            number_long(x[i]);
+          else
+            number_unsigned_long(x[i]);
+        }
+      }
+
       /**
        * Handle the specified string value.
        *
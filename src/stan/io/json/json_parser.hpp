@@ -3,6 +3,7 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <stan/io/fast_parse_double.hpp>
 #include <stan/io/validate_zero_buf.hpp>
 #include <stan/io/json/json_error.hpp>
 
@@ -12,6 +13,7 @@
 #include <limits>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace stan {
 
@@ -50,7 +52,10 @@ namespace stan {
           in_(in),
           next_char_(0),
           line_(0),
-          column_(0)
+          column_(0),
+          num_buf_(),
+          ints_(),
+          reals_()
       {  }
 
       ~parser() {
@@ -121,35 +126,71 @@ namespace stan {
         }
       }
 
+      enum number_kind {
+        INTEGER,
+        REAL,
+        POSITIVE_INFINITY,
+        NEGATIVE_INFINITY,
+        NOT_A_NUMBER
+      };
+
       void parse_number() {
-        bool is_positive = true;
+        switch (scan_number()) {
+        case INTEGER: {
+          long n;  // NOLINT(runtime/int)
+          if (integer_value(n)) {
+            if (n < 0)
+              h_.number_long(n);
+            else
+              h_.number_unsigned_long(n);
+          } else {
+            h_.number_unsigned_long(unsigned_integer_value());
+          }
+          break;
+        }
+        case REAL:
+          h_.number_double(real_value());
+          break;
+        case POSITIVE_INFINITY:
+          h_.number_double(std::numeric_limits<double>::infinity());
+          break;
+        case NEGATIVE_INFINITY:
+          h_.number_double(-std::numeric_limits<double>::infinity());
+          break;
+        case NOT_A_NUMBER:
+          h_.number_double(std::numeric_limits<double>::quiet_NaN());
+          break;
+        }
+      }
 
-        std::stringstream ss;
+      // read the characters of a number into num_buf_ and return its kind
+      number_kind scan_number() {
+        num_buf_.clear();
+        bool is_positive = true;
         char c = get_non_ws_char();
         // minus
         if (c == '-') {
           is_positive = false;
-          ss << c;
+          num_buf_ += c;
           c = get_char();
         }
 
         // Infinity
-        if ((is_positive && ss.str() == "I") ||
-            c == 'I') {
-            parse_infinity_literal(is_positive);
-            return;
+        if (c == 'I') {
+          get_chars("nfinity");
+          return is_positive ? POSITIVE_INFINITY : NEGATIVE_INFINITY;
         }
         // Nan
         if (c == 'N') {
-          parse_nan_literal();
-          return;
+          get_chars("aN");
+          return NOT_A_NUMBER;
         }
 
         // int
         //   zero / digit1-9
         if (c < '0' || c > '9')
           throw json_exception("expecting int part of number");
-        ss << c;
+        num_buf_ += c;
 
         //   *DIGIT
         bool leading_zero = (c == '0');
@@ -157,7 +198,7 @@ namespace stan {
         if (leading_zero && (c == '0'))
           throw json_exception("zero padded numbers not allowed");
         while (c >= '0' && c <= '9') {
-          ss << c;
+          num_buf_ += c;
           c = get_char();
         }
 
@@ -165,14 +206,14 @@ namespace stan {
         bool is_integer = true;
         if (c == '.') {
           is_integer = false;
-          ss << '.';
+          num_buf_ += '.';
           c = get_char();
           if (c < '0' || c > '9')
             throw json_exception("expected digit after decimal");
-          ss << c;
+          num_buf_ += c;
           c = get_char();
           while (c >= '0' && c <= '9') {
-            ss << c;
+            num_buf_ += c;
             c = get_char();
           }
         }
@@ -180,60 +221,77 @@ namespace stan {
         // exp
         if (c == 'e' || c == 'E') {
           is_integer = false;
-          ss << c;
+          num_buf_ += c;
           c = get_char();
           // minus / plus
           if (c == '+' || c == '-') {
-            ss << c;
+            num_buf_ += c;
             c = get_char();
           }
           // 1*DIGIT
           if (c < '0' || c > '9')
             throw json_exception("expected digit after e/E");
           while (c >= '0' && c <= '9') {
-            ss << c;
+            num_buf_ += c;
             c = get_char();
           }
         }
         unget_char();
+        return is_integer ? INTEGER : REAL;
+      }
 
-        if (is_integer) {
-          if (is_positive) {
-            unsigned long n;  // NOLINT(runtime/int)
-            try {
-              // NOLINTNEXTLINE(runtime/int)
-              n = boost::lexical_cast<unsigned long>(ss.str());
-            } catch (const boost::bad_lexical_cast & ) {
-              throw json_exception("number exceeds integer range");
-            }
-            ss >> n;
-            h_.number_unsigned_long(n);
-          } else {
-            long n;  // NOLINT(runtime/int)
-            try {
-              // NOLINTNEXTLINE(runtime/int)
-              n = boost::lexical_cast<unsigned long>(ss.str());
-            } catch (const boost::bad_lexical_cast & ) {
-              throw json_exception("number exceeds integer range");
-            }
-            ss >> n;
-            h_.number_long(n);
-          }
-        } else {
-          double x;
-          try {
-            std::string ss_str = ss.str();
-            x = boost::lexical_cast<double>(ss_str);
-            if (x == 0)
-              io::validate_zero_buf(ss_str);
-          } catch (const boost::bad_lexical_cast & ) {
-            throw json_exception("number exceeds double range");
-          }
-          ss >> x;
-          h_.number_double(x);
+      // value of the integer in num_buf_; false if it is positive and
+      // only fits in an unsigned long
+      bool integer_value(long& n) {  // NOLINT(runtime/int)
+        size_t i = num_buf_[0] == '-' ? 1 : 0;
+        unsigned long m = 0;  // NOLINT(runtime/int)
+        // NOLINTNEXTLINE(runtime/int)
+        const unsigned long max = std::numeric_limits<unsigned long>::max();
+        for (; i < num_buf_.size(); ++i) {
+          unsigned int d = num_buf_[i] - '0';
+          if (m > (max - d) / 10)
+            throw json_exception("number exceeds integer range");
+          m = m * 10 + d;
+        }
+        // NOLINTNEXTLINE(runtime/int)
+        const unsigned long long_max = std::numeric_limits<long>::max();
+        if (num_buf_[0] == '-') {
+          if (m > long_max + 1)
+            throw json_exception("number exceeds integer range");
+          // avoid negating long_max + 1, which is not a long
+          n = m == 0 ? 0 : -static_cast<long>(m - 1) - 1;  // NOLINT
+          return true;
+        }
+        if (m > long_max)
+          return false;
+        n = m;
+        return true;
+      }
+
+      unsigned long unsigned_integer_value() {  // NOLINT(runtime/int)
+        try {
+          // NOLINTNEXTLINE(runtime/int)
+          return boost::lexical_cast<unsigned long>(num_buf_);
+        } catch (const boost::bad_lexical_cast & ) {
+          throw json_exception("number exceeds integer range");
         }
       }
 
+      // value of the real number in num_buf_
+      double real_value() {
+        double x;
+        if (io::fast_parse_double(num_buf_, x))
+          return x;
+        try {
+          x = boost::lexical_cast<double>(num_buf_);
+          if (x == 0)
+            io::validate_zero_buf(num_buf_);
+        } catch (const boost::bad_lexical_cast & ) {
+          throw json_exception("number exceeds double range");
+        }
+        return x;
+      }
+
       std::string parse_string_chars_quotation_mark() {
         std::stringstream s;
         while (true) {
@@ -283,19 +341,6 @@ namespace stan {
         h_.null();
       }
 
-      void parse_infinity_literal(bool is_positive) {
-        get_chars("nfinity");
-        if (is_positive)
-          h_.number_double(std::numeric_limits<double>::infinity());
-        else
-          h_.number_double(-std::numeric_limits<double>::infinity());
-      }
-
-      void parse_nan_literal() {
-        get_chars("aN");
-        h_.number_double(std::numeric_limits<double>::quiet_NaN());
-      }
-
       void get_escaped_unicode(std::stringstream& s) {
         unsigned int codepoint = get_int_as_hex_chars();
         if (!(is_high_surrogate(codepoint) || is_low_surrogate(codepoint))) {
@@ -368,6 +413,7 @@ namespace stan {
         char c = get_non_ws_char();
         if (c == ']') return;
         unget_char();
+        if (parse_numbers_end_array()) return;
         while (true) {
           parse_value();
           char c = get_non_ws_char();
@@ -382,6 +428,78 @@ namespace stan {
         }
       }
 
+      static bool is_number_start(char c) {
+        return c == '-' || (c >= '0' && c <= '9') || c == 'I' || c == 'N';
+      }
+
+      // Parse the leading numbers of an array into a buffer, passing
+      // each run of integers or of reals to the handler in one call.
+      // Returns true after the end of the array, or false positioned at
+      // the first value that is not a number.
+      bool parse_numbers_end_array() {
+        ints_.clear();
+        reals_.clear();
+        while (true) {
+          char c = get_non_ws_char();
+          unget_char();
+          if (!is_number_start(c)) {
+            flush_numbers();
+            return false;
+          }
+          long n;  // NOLINT(runtime/int)
+          switch (scan_number()) {
+          case INTEGER:
+            if (!integer_value(n)) {
+              flush_numbers();
+              h_.number_unsigned_long(unsigned_integer_value());
+              break;
+            }
+            if (!reals_.empty())
+              flush_numbers();
+            ints_.push_back(n);
+            break;
+          case REAL:
+            push_real(real_value());
+            break;
+          case POSITIVE_INFINITY:
+            push_real(std::numeric_limits<double>::infinity());
+            break;
+          case NEGATIVE_INFINITY:
+            push_real(-std::numeric_limits<double>::infinity());
+            break;
+          case NOT_A_NUMBER:
+            push_real(std::numeric_limits<double>::quiet_NaN());
+            break;
+          }
+          c = get_non_ws_char();
+          if (c == ']') {
+            flush_numbers();
+            return true;
+          }
+          if (c != ',')
+            throw json_exception("in array, expecting ] or ,");
+          c = get_non_ws_char();
+          if (c == ']')
+            throw json_exception("in array, expecting value");
+          unget_char();
+        }
+      }
+
+      void push_real(double x) {
+        if (!ints_.empty())
+          flush_numbers();
+        reals_.push_back(x);
+      }
+
+      void flush_numbers() {
+        if (!ints_.empty())
+          h_.number_longs(&ints_[0], ints_.size());
+        if (!reals_.empty())
+          h_.number_doubles(&reals_[0], reals_.size());
+        ints_.clear();
+        reals_.clear();
+      }
+
       void parse_object_members_end_object() {
         char c = get_non_ws_char();
         if (c == '}') return;
@@ -440,6 +558,9 @@ namespace stan {
       char next_char_;
       size_t line_;
       size_t column_;
+      std::string num_buf_;
+      std::vector<long> ints_;  // NOLINT(runtime/int)
+      std::vector<double> reals_;
     };
 
 
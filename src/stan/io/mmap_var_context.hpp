@@ -0,0 +1,239 @@
+#ifndef STAN_IO_MMAP_VAR_CONTEXT_HPP
+#define STAN_IO_MMAP_VAR_CONTEXT_HPP
+
+#include <stan/io/binary_data_writer.hpp>
+#include <stan/io/var_context.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+
+  namespace io {
+
+    /**
+     * An <code>mmap_var_context</code> reads variables from a file in
+     * the binary data format (see <code>binary_data_format</code>) by
+     * mapping the file into memory.
+     *
+     * <p>Opening the file reads only its header; values are paged in
+     * from the file as they are accessed, so the values are held in
+     * memory once, by the operating system's page cache.
+     * <code>vals_r_view</code> and <code>vals_i_view</code> return
+     * views of the values in the mapped file without copying them.
+     * The <code>var_context</code> methods return copies, as that
+     * interface requires.
+     *
+     * <p>Views remain valid as long as this object exists.
+     */
+    class mmap_var_context : public var_context {
+    public:
+      typedef Eigen::Map<const Eigen::VectorXd> vals_r_view_t;
+      typedef Eigen::Map<const Eigen::Matrix<int32_t, Eigen::Dynamic, 1> >
+        vals_i_view_t;
+
+      /**
+       * Construct a context by mapping the specified file.
+       *
+       * @param path name of file in the binary data format
+       * @throw std::invalid_argument if the file cannot be mapped or is
+       *   not in the binary data format
+       */
+      explicit mmap_var_context(const std::string& path) {
+        try {
+          boost::interprocess::file_mapping
+            mapping(path.c_str(), boost::interprocess::read_only);
+          boost::interprocess::mapped_region
+            region(mapping, boost::interprocess::read_only);
+          region_.swap(region);
+        } catch (const boost::interprocess::interprocess_exception& e) {
+          throw std::invalid_argument("mmap_var_context: cannot map file "
+                                      + path + ": " + e.what());
+        }
+        read_header();
+      }
+
+      bool contains_r(const std::string& name) const {
+        return vars_.find(name) != vars_.end();
+      }
+
+      std::vector<double> vals_r(const std::string& name) const {
+        const var* v = find(name);
+        if (v == 0)
+          return std::vector<double>();
+        if (v->type == binary_data_format::REAL) {
+          const double* x = reinterpret_cast<const double*>(v->data);
+          return std::vector<double>(x, x + v->size);
+        }
+        const int32_t* x = reinterpret_cast<const int32_t*>(v->data);
+        return std::vector<double>(x, x + v->size);
+      }
+
+      std::vector<size_t> dims_r(const std::string& name) const {
+        const var* v = find(name);
+        return v == 0 ? std::vector<size_t>() : v->dims;
+      }
+
+      bool contains_i(const std::string& name) const {
+        const var* v = find(name);
+        return v != 0 && v->type == binary_data_format::INT;
+      }
+
+      std::vector<int> vals_i(const std::string& name) const {
+        if (!contains_i(name))
+          return std::vector<int>();
+        const var* v = find(name);
+        const int32_t* x = reinterpret_cast<const int32_t*>(v->data);
+        return std::vector<int>(x, x + v->size);
+      }
+
+      std::vector<size_t> dims_i(const std::string& name) const {
+        return contains_i(name) ? find(name)->dims : std::vector<size_t>();
+      }
+
+      void names_r(std::vector<std::string>& names) const {
+        names.resize(0);
+        for (std::map<std::string, var>::const_iterator it = vars_.begin();
+             it != vars_.end(); ++it)
+          if (it->second.type == binary_data_format::REAL)
+            names.push_back(it->first);
+      }
+
+      void names_i(std::vector<std::string>& names) const {
+        names.resize(0);
+        for (std::map<std::string, var>::const_iterator it = vars_.begin();
+             it != vars_.end(); ++it)
+          if (it->second.type == binary_data_format::INT)
+            names.push_back(it->first);
+      }
+
+      /**
+       * Return a view of the values of a variable stored as doubles.
+       *
+       * @param name name of variable
+       * @return view of the values in the mapped file, or an empty
+       *   view if there is no variable of that name stored as doubles
+       */
+      vals_r_view_t vals_r_view(const std::string& name) const {
+        const var* v = find(name);
+        if (v == 0 || v->type != binary_data_format::REAL)
+          return vals_r_view_t(0, 0);
+        return vals_r_view_t(reinterpret_cast<const double*>(v->data),
+                             v->size);
+      }
+
+      /**
+       * Return a view of the values of an integer variable.
+       *
+       * @param name name of variable
+       * @return view of the values in the mapped file, or an empty
+       *   view if there is no integer variable of that name
+       */
+      vals_i_view_t vals_i_view(const std::string& name) const {
+        if (!contains_i(name))
+          return vals_i_view_t(0, 0);
+        const var* v = find(name);
+        return vals_i_view_t(reinterpret_cast<const int32_t*>(v->data),
+                             v->size);
+      }
+
+    private:
+      struct var {
+        char type;
+        std::vector<size_t> dims;
+        const char* data;
+        size_t size;
+      };
+
+      boost::interprocess::mapped_region region_;
+      std::map<std::string, var> vars_;
+
+      mmap_var_context(const mmap_var_context&);
+      mmap_var_context& operator=(const mmap_var_context&);
+
+      const var* find(const std::string& name) const {
+        std::map<std::string, var>::const_iterator it = vars_.find(name);
+        return it == vars_.end() ? 0 : &it->second;
+      }
+
+      static void bad_format(const std::string& what) {
+        throw std::invalid_argument("mmap_var_context: " + what);
+      }
+
+      void read_header() {
+        const char* begin = static_cast<const char*>(region_.get_address());
+        const size_t file_size = region_.get_size();
+        size_t pos = 0;
+
+        if (file_size < binary_data_format::magic_size
+            || std::memcmp(begin, binary_data_format::magic(),
+                           binary_data_format::magic_size) != 0)
+          bad_format("file is not in the binary data format");
+        pos = binary_data_format::magic_size;
+        if (read_size(begin, file_size, pos) != binary_data_format::byte_order)
+          bad_format("file was written with a different byte order");
+
+        uint64_t num_vars = read_size(begin, file_size, pos);
+        for (uint64_t n = 0; n < num_vars; ++n) {
+          uint64_t name_size = read_size(begin, file_size, pos);
+          if (pos >= file_size || name_size > file_size - pos - 1)
+            bad_format("unexpected end of file");
+          std::string name(begin + pos, name_size);
+          pos += name_size;
+
+          var v;
+          v.type = begin[pos++];
+          if (v.type != binary_data_format::REAL
+              && v.type != binary_data_format::INT)
+            bad_format("unknown type of variable " + name);
+          uint64_t num_dims = read_size(begin, file_size, pos);
+          v.size = 1;
+          for (uint64_t i = 0; i < num_dims; ++i) {
+            uint64_t dim = read_size(begin, file_size, pos);
+            if (dim != 0
+                && v.size > std::numeric_limits<size_t>::max() / dim)
+              bad_format("size of variable " + name + " is too large");
+            v.dims.push_back(dim);
+            v.size *= dim;
+          }
+          uint64_t offset = read_size(begin, file_size, pos);
+          size_t value_size = v.type == binary_data_format::REAL
+                              ? sizeof(double) : sizeof(int32_t);
+          if (offset % binary_data_format::alignment != 0)
+            bad_format("values of variable " + name + " are not aligned");
+          if (offset > file_size
+              || v.size > (file_size - offset) / value_size)
+            bad_format("unexpected end of file");
+          v.data = begin + offset;
+          vars_[name] = v;
+        }
+      }
+
+      static void check_available(size_t file_size, uint64_t pos,
+                                  uint64_t n) {
+        if (pos > file_size || n > file_size - pos)
+          bad_format("unexpected end of file");
+      }
+
+      static uint64_t read_size(const char* begin, size_t file_size,
+                                size_t& pos) {
+        check_available(file_size, pos, sizeof(uint64_t));
+        uint64_t n;
+        std::memcpy(&n, begin + pos, sizeof(n));
+        pos += sizeof(n);
+        return n;
+      }
+    };
+
+  }
+
+}
+#endif
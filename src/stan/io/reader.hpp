@@ -39,18 +39,47 @@ private:
   size_t pos_;
   size_t int_pos_;
 
-  inline T &scalar_ptr() { return data_r_.at(pos_); }
-
-  inline T &scalar_ptr_increment(size_t m) {
+  /**
+   * Return a pointer to the next <code>m</code> scalars and move
+   * past them.  The bounds are checked once for the whole block, so
+   * the scalars are then read through the pointer without further
+   * checks.
+   *
+   * @param m Number of scalars.
+   * @return Pointer to the first of the scalars.
+   * @throw std::runtime_error If fewer than <code>m</code> scalars
+   * remain.
+   */
+  inline T *scalar_block(size_t m) {
+    if (m > data_r_.size() - pos_)
+      BOOST_THROW_EXCEPTION(std::runtime_error("no more scalars to read"));
+    T *block = data_r_.data() + pos_;
     pos_ += m;
-    return data_r_.at(pos_ - m);
-  }
-
-  inline int &int_ptr() { return data_i_.at(int_pos_); }
-
-  inline int &int_ptr_increment(size_t m) {
-    int_pos_ += m;
-    return data_i_.at(int_pos_ - m);
+    return block;
+  }
+
+  /**
+   * Return a container of the specified dimensions whose elements are
+   * the next scalars, in column-major order, passed through the
+   * specified function.  The scalars are read as one block, so the
+   * bounds are checked once and the result is the only allocation.
+   *
+   * @tparam M Type of container.
+   * @tparam F Type of function from scalar to scalar.
+   * @param rows Number of rows.
+   * @param cols Number of columns.
+   * @param f Function applied to each scalar.
+   * @return Container of transformed scalars.
+   */
+  template <typename M, typename F>
+  inline M read_block(size_t rows, size_t cols, const F &f) {
+    size_t size = rows * cols;
+    const T *x = scalar_block(size);
+    M v(rows, cols);
+    T *y = v.data();
+    for (size_t i = 0; i < size; ++i)
+      y[i] = f(x[i]);
+    return v;
   }
 
 public:
@@ -164,12 +193,8 @@ public:
    * @return Vector made up of the next scalars.
    */
   inline std::vector<T> std_vector(size_t m) {
-    if (m == 0)
-      return std::vector<T>();
-    std::vector<T> vec;
-    T &start = scalar_ptr_increment(m);
-    vec.insert(vec.begin(), &start, &scalar_ptr());
-    return vec;
+    const T *start = scalar_block(m);
+    return std::vector<T>(start, start + m);
   }
 
   /**
@@ -182,7 +207,7 @@ public:
   inline vector_t vector(size_t m) {
     if (m == 0)
       return vector_t();
-    return map_vector_t(&scalar_ptr_increment(m), m);
+    return map_vector_t(scalar_block(m), m);
   }
   /**
    * Return a column vector of specified dimensionality made up of
@@ -194,7 +219,7 @@ public:
   inline vector_t vector_constrain(size_t m) {
     if (m == 0)
       return vector_t();
-    return map_vector_t(&scalar_ptr_increment(m), m);
+    return map_vector_t(scalar_block(m), m);
   }
   /**
    * Return a column vector of specified dimensionality made up of
@@ -207,7 +232,7 @@ public:
   inline vector_t vector_constrain(size_t m, T & /*lp*/) {
     if (m == 0)
       return vector_t();
-    return map_vector_t(&scalar_ptr_increment(m), m);
+    return map_vector_t(scalar_block(m), m);
   }
 
   /**
@@ -220,7 +245,7 @@ public:
   inline row_vector_t row_vector(size_t m) {
     if (m == 0)
       return row_vector_t();
-    return map_row_vector_t(&scalar_ptr_increment(m), m);
+    return map_row_vector_t(scalar_block(m), m);
   }
 
   /**
@@ -233,7 +258,7 @@ public:
   inline row_vector_t row_vector_constrain(size_t m) {
     if (m == 0)
       return row_vector_t();
-    return map_row_vector_t(&scalar_ptr_increment(m), m);
+    return map_row_vector_t(scalar_block(m), m);
   }
 
   /**
@@ -248,7 +273,7 @@ public:
   inline row_vector_t row_vector_constrain(size_t m, T & /*lp*/) {
     if (m == 0)
       return row_vector_t();
-    return map_row_vector_t(&scalar_ptr_increment(m), m);
+    return map_row_vector_t(scalar_block(m), m);
   }
 
   /**
@@ -271,7 +296,7 @@ public:
   inline matrix_t matrix(size_t m, size_t n) {
     if (m == 0 || n == 0)
       return matrix_t(m, n);
-    return map_matrix_t(&scalar_ptr_increment(m * n), m, n);
+    return map_matrix_t(scalar_block(m * n), m, n);
   }
 
   /**
@@ -287,7 +312,7 @@ public:
   inline matrix_t matrix_constrain(size_t m, size_t n) {
     if (m == 0 || n == 0)
       return matrix_t(m, n);
-    return map_matrix_t(&scalar_ptr_increment(m * n), m, n);
+    return map_matrix_t(scalar_block(m * n), m, n);
   }
 
   /**
@@ -305,7 +330,7 @@ public:
   inline matrix_t matrix_constrain(size_t m, size_t n, T & /*lp*/) {
     if (m == 0 || n == 0)
       return matrix_t(m, n);
-    return map_matrix_t(&scalar_ptr_increment(m * n), m, n);
+    return map_matrix_t(scalar_block(m * n), m, n);
   }
 
   /**
@@ -1177,321 +1202,288 @@ public:
     return stan::math::corr_matrix_constrain(vector((k * (k - 1)) / 2), k, lp);
   }
 
-  template <typename TL> inline vector_t vector_lb(const TL lb, size_t m) {
-    vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_lb(lb);
-    return v;
+  template <typename TL>
+  inline vector_t vector_lb(const TL lb, size_t m) {
+    return read_block<vector_t>(m, 1, [&](const T &x) -> T {
+      stan::math::check_greater_or_equal("stan::io::scalar_lb",
+                                         "Constrained scalar", x, lb);
+      return x;
+    });
   }
 
   template <typename TL>
   inline vector_t vector_lb_constrain(const TL lb, size_t m) {
-    vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_lb_constrain(lb);
-    return v;
+    return read_block<vector_t>(m, 1, [&](const T &x) {
+      return stan::math::lb_constrain(x, lb);
+    });
   }
 
   template <typename TL>
   inline vector_t vector_lb_constrain(const TL lb, size_t m, T &lp) {
-    vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_lb_constrain(lb, lp);
-    return v;
+    return read_block<vector_t>(m, 1, [&](const T &x) {
+      return stan::math::lb_constrain(x, lb, lp);
+    });
   }
 
   template <typename TL>
   inline row_vector_t row_vector_lb(const TL lb, size_t m) {
-    row_vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_lb(lb);
-    return v;
+    return read_block<row_vector_t>(1, m, [&](const T &x) -> T {
+      stan::math::check_greater_or_equal("stan::io::scalar_lb",
+                                         "Constrained scalar", x, lb);
+      return x;
+    });
   }
 
   template <typename TL>
   inline row_vector_t row_vector_lb_constrain(const TL lb, size_t m) {
-    row_vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_lb_constrain(lb);
-    return v;
+    return read_block<row_vector_t>(1, m, [&](const T &x) {
+      return stan::math::lb_constrain(x, lb);
+    });
   }
 
   template <typename TL>
   inline row_vector_t row_vector_lb_constrain(const TL lb, size_t m, T &lp) {
-    row_vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_lb_constrain(lb, lp);
-    return v;
+    return read_block<row_vector_t>(1, m, [&](const T &x) {
+      return stan::math::lb_constrain(x, lb, lp);
+    });
   }
 
   template <typename TL>
   inline matrix_t matrix_lb(const TL lb, size_t m, size_t n) {
-    matrix_t v(m, n);
-    for (size_t j = 0; j < n; ++j)
-      for (size_t i = 0; i < m; ++i)
-        v(i, j) = scalar_lb(lb);
-    return v;
+    return read_block<matrix_t>(m, n, [&](const T &x) -> T {
+      stan::math::check_greater_or_equal("stan::io::scalar_lb",
+                                         "Constrained scalar", x, lb);
+      return x;
+    });
   }
 
   template <typename TL>
   inline matrix_t matrix_lb_constrain(const TL lb, size_t m, size_t n) {
-    matrix_t v(m, n);
-    for (size_t j = 0; j < n; ++j)
-      for (size_t i = 0; i < m; ++i)
-        v(i, j) = scalar_lb_constrain(lb);
-    return v;
+    return read_block<matrix_t>(m, n, [&](const T &x) {
+      return stan::math::lb_constrain(x, lb);
+    });
   }
 
   template <typename TL>
   inline matrix_t matrix_lb_constrain(const TL lb, size_t m, size_t n, T &lp) {
-    matrix_t v(m, n);
-    for (size_t j = 0; j < n; ++j)
-      for (size_t i = 0; i < m; ++i)
-        v(i, j) = scalar_lb_constrain(lb, lp);
-    return v;
+    return read_block<matrix_t>(m, n, [&](const T &x) {
+      return stan::math::lb_constrain(x, lb, lp);
+    });
   }
 
-  template <typename TU> inline vector_t vector_ub(const TU ub, size_t m) {
-    vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_ub(ub);
-    return v;
+  template <typename TU>
+  inline vector_t vector_ub(const TU ub, size_t m) {
+    return read_block<vector_t>(m, 1, [&](const T &x) -> T {
+      stan::math::check_less_or_equal("stan::io::scalar_ub",
+                                      "Constrained scalar", x, ub);
+      return x;
+    });
   }
 
   template <typename TU>
   inline vector_t vector_ub_constrain(const TU ub, size_t m) {
-    vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_ub_constrain(ub);
-    return v;
+    return read_block<vector_t>(m, 1, [&](const T &x) {
+      return stan::math::ub_constrain(x, ub);
+    });
   }
 
   template <typename TU>
   inline vector_t vector_ub_constrain(const TU ub, size_t m, T &lp) {
-    vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_ub_constrain(ub, lp);
-    return v;
+    return read_block<vector_t>(m, 1, [&](const T &x) {
+      return stan::math::ub_constrain(x, ub, lp);
+    });
   }
 
   template <typename TU>
   inline row_vector_t row_vector_ub(const TU ub, size_t m) {
-    row_vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_ub(ub);
-    return v;
+    return read_block<row_vector_t>(1, m, [&](const T &x) -> T {
+      stan::math::check_less_or_equal("stan::io::scalar_ub",
+                                      "Constrained scalar", x, ub);
+      return x;
+    });
   }
 
   template <typename TU>
   inline row_vector_t row_vector_ub_constrain(const TU ub, size_t m) {
-    row_vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_ub_constrain(ub);
-    return v;
+    return read_block<row_vector_t>(1, m, [&](const T &x) {
+      return stan::math::ub_constrain(x, ub);
+    });
   }
 
   template <typename TU>
   inline row_vector_t row_vector_ub_constrain(const TU ub, size_t m, T &lp) {
-    row_vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_ub_constrain(ub, lp);
-    return v;
+    return read_block<row_vector_t>(1, m, [&](const T &x) {
+      return stan::math::ub_constrain(x, ub, lp);
+    });
   }
 
   template <typename TU>
   inline matrix_t matrix_ub(const TU ub, size_t m, size_t n) {
-    matrix_t v(m, n);
-    for (size_t j = 0; j < n; ++j)
-      for (size_t i = 0; i < m; ++i)
-        v(i, j) = scalar_ub(ub);
-    return v;
+    return read_block<matrix_t>(m, n, [&](const T &x) -> T {
+      stan::math::check_less_or_equal("stan::io::scalar_ub",
+                                      "Constrained scalar", x, ub);
+      return x;
+    });
   }
 
   template <typename TU>
   inline matrix_t matrix_ub_constrain(const TU ub, size_t m, size_t n) {
-    matrix_t v(m, n);
-    for (size_t j = 0; j < n; ++j)
-      for (size_t i = 0; i < m; ++i)
-        v(i, j) = scalar_ub_constrain(ub);
-    return v;
+    return read_block<matrix_t>(m, n, [&](const T &x) {
+      return stan::math::ub_constrain(x, ub);
+    });
   }
 
   template <typename TU>
   inline matrix_t matrix_ub_constrain(const TU ub, size_t m, size_t n, T &lp) {
-    matrix_t v(m, n);
-    for (size_t j = 0; j < n; ++j)
-      for (size_t i = 0; i < m; ++i)
-        v(i, j) = scalar_ub_constrain(ub, lp);
-    return v;
+    return read_block<matrix_t>(m, n, [&](const T &x) {
+      return stan::math::ub_constrain(x, ub, lp);
+    });
   }
 
   template <typename TL, typename TU>
   inline vector_t vector_lub(const TL lb, const TU ub, size_t m) {
-    vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_lub(lb, ub);
-    return v;
+    return read_block<vector_t>(m, 1, [&](const T &x) -> T {
+      stan::math::check_bounded<T, TL, TU>("stan::io::scalar_lub",
+                                           "Constrained scalar", x, lb, ub);
+      return x;
+    });
   }
 
   template <typename TL, typename TU>
   inline vector_t vector_lub_constrain(const TL lb, const TU ub, size_t m) {
-    vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_lub_constrain(lb, ub);
-    return v;
+    return read_block<vector_t>(m, 1, [&](const T &x) {
+      return stan::math::lub_constrain(x, lb, ub);
+    });
   }
 
   template <typename TL, typename TU>
   inline vector_t vector_lub_constrain(const TL lb, const TU ub, size_t m,
                                        T &lp) {
-    vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_lub_constrain(lb, ub, lp);
-    return v;
+    return read_block<vector_t>(m, 1, [&](const T &x) {
+      return stan::math::lub_constrain(x, lb, ub, lp);
+    });
   }
 
   template <typename TL, typename TU>
   inline row_vector_t row_vector_lub(const TL lb, const TU ub, size_t m) {
-    row_vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_lub(lb, ub);
-    return v;
+    return read_block<row_vector_t>(1, m, [&](const T &x) -> T {
+      stan::math::check_bounded<T, TL, TU>("stan::io::scalar_lub",
+                                           "Constrained scalar", x, lb, ub);
+      return x;
+    });
   }
+
   template <typename TL, typename TU>
   inline row_vector_t row_vector_lub_constrain(const TL lb, const TU ub,
                                                size_t m) {
-    row_vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_lub_constrain(lb, ub);
-    return v;
+    return read_block<row_vector_t>(1, m, [&](const T &x) {
+      return stan::math::lub_constrain(x, lb, ub);
+    });
   }
 
   template <typename TL, typename TU>
   inline row_vector_t row_vector_lub_constrain(const TL lb, const TU ub,
                                                size_t m, T &lp) {
-    row_vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_lub_constrain(lb, ub, lp);
-    return v;
+    return read_block<row_vector_t>(1, m, [&](const T &x) {
+      return stan::math::lub_constrain(x, lb, ub, lp);
+    });
   }
 
   template <typename TL, typename TU>
   inline matrix_t matrix_lub(const TL lb, const TU ub, size_t m, size_t n) {
-    matrix_t v(m, n);
-    for (size_t j = 0; j < n; ++j)
-      for (size_t i = 0; i < m; ++i)
-        v(i, j) = scalar_lub(lb, ub);
-    return v;
+    return read_block<matrix_t>(m, n, [&](const T &x) -> T {
+      stan::math::check_bounded<T, TL, TU>("stan::io::scalar_lub",
+                                           "Constrained scalar", x, lb, ub);
+      return x;
+    });
   }
 
   template <typename TL, typename TU>
   inline matrix_t matrix_lub_constrain(const TL lb, const TU ub, size_t m,
                                        size_t n) {
-    matrix_t v(m, n);
-    for (size_t j = 0; j < n; ++j)
-      for (size_t i = 0; i < m; ++i)
-        v(i, j) = scalar_lub_constrain(lb, ub);
-    return v;
+    return read_block<matrix_t>(m, n, [&](const T &x) {
+      return stan::math::lub_constrain(x, lb, ub);
+    });
   }
 
   template <typename TL, typename TU>
   inline matrix_t matrix_lub_constrain(const TL lb, const TU ub, size_t m,
                                        size_t n, T &lp) {
-    matrix_t v(m, n);
-    for (size_t j = 0; j < n; ++j)
-      for (size_t i = 0; i < m; ++i)
-        v(i, j) = scalar_lub_constrain(lb, ub, lp);
-    return v;
+    return read_block<matrix_t>(m, n, [&](const T &x) {
+      return stan::math::lub_constrain(x, lb, ub, lp);
+    });
   }
 
   template <typename TL, typename TS>
   inline vector_t vector_offset_multiplier(const TL offset, const TS multiplier,
                                            size_t m) {
-    vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_offset_multiplier(offset, multiplier);
-    return v;
+    return vector(m);
   }
 
   template <typename TL, typename TS>
-  inline vector_t vector_offset_multiplier_constrain(const TL offset,
-                                                     const TS multiplier,
-                                                     size_t m) {
-    vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_offset_multiplier_constrain(offset, multiplier);
-    return v;
+  inline vector_t
+  vector_offset_multiplier_constrain(const TL offset, const TS multiplier,
+                                     size_t m) {
+    return read_block<vector_t>(m, 1, [&](const T &x) {
+      return stan::math::offset_multiplier_constrain(x, offset, multiplier);
+    });
   }
 
   template <typename TL, typename TS>
-  inline vector_t vector_offset_multiplier_constrain(const TL offset,
-                                                     const TS multiplier,
-                                                     size_t m, T &lp) {
-    vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_offset_multiplier_constrain(offset, multiplier, lp);
-    return v;
+  inline vector_t
+  vector_offset_multiplier_constrain(const TL offset, const TS multiplier,
+                                     size_t m, T &lp) {
+    return read_block<vector_t>(m, 1, [&](const T &x) {
+      return stan::math::offset_multiplier_constrain(x, offset, multiplier, lp);
+    });
   }
 
   template <typename TL, typename TS>
   inline row_vector_t
   row_vector_offset_multiplier(const TL offset, const TS multiplier, size_t m) {
-    row_vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_offset_multiplier(offset, multiplier);
-    return v;
+    return row_vector(m);
   }
 
   template <typename TL, typename TS>
   inline row_vector_t
   row_vector_offset_multiplier_constrain(const TL offset, const TS multiplier,
                                          size_t m) {
-    row_vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_offset_multiplier_constrain(offset, multiplier);
-    return v;
+    return read_block<row_vector_t>(1, m, [&](const T &x) {
+      return stan::math::offset_multiplier_constrain(x, offset, multiplier);
+    });
   }
 
   template <typename TL, typename TS>
   inline row_vector_t
   row_vector_offset_multiplier_constrain(const TL offset, const TS multiplier,
                                          size_t m, T &lp) {
-    row_vector_t v(m);
-    for (size_t i = 0; i < m; ++i)
-      v(i) = scalar_offset_multiplier_constrain(offset, multiplier, lp);
-    return v;
+    return read_block<row_vector_t>(1, m, [&](const T &x) {
+      return stan::math::offset_multiplier_constrain(x, offset, multiplier, lp);
+    });
   }
 
   template <typename TL, typename TS>
   inline matrix_t matrix_offset_multiplier(const TL offset, const TS multiplier,
                                            size_t m, size_t n) {
-    matrix_t v(m, n);
-    for (size_t j = 0; j < n; ++j)
-      for (size_t i = 0; i < m; ++i)
-        v(i, j) = scalar_offset_multiplier(offset, multiplier);
-    return v;
+    return matrix(m, n);
   }
 
   template <typename TL, typename TS>
-  inline matrix_t matrix_offset_multiplier_constrain(const TL offset,
-                                                     const TS multiplier,
-                                                     size_t m, size_t n) {
-    matrix_t v(m, n);
-    for (size_t j = 0; j < n; ++j)
-      for (size_t i = 0; i < m; ++i)
-        v(i, j) = scalar_offset_multiplier_constrain(offset, multiplier);
-    return v;
+  inline matrix_t
+  matrix_offset_multiplier_constrain(const TL offset, const TS multiplier,
+                                     size_t m, size_t n) {
+    return read_block<matrix_t>(m, n, [&](const T &x) {
+      return stan::math::offset_multiplier_constrain(x, offset, multiplier);
+    });
   }
 
   template <typename TL, typename TS>
   inline matrix_t
   matrix_offset_multiplier_constrain(const TL offset, const TS multiplier,
                                      size_t m, size_t n, T &lp) {
-    matrix_t v(m, n);
-    for (size_t j = 0; j < n; ++j)
-      for (size_t i = 0; i < m; ++i)
-        v(i, j) = scalar_offset_multiplier_constrain(offset, multiplier, lp);
-    return v;
+    return read_block<matrix_t>(m, n, [&](const T &x) {
+      return stan::math::offset_multiplier_constrain(x, offset, multiplier, lp);
+    });
   }
 };
 
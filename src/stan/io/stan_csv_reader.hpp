@@ -2,11 +2,24 @@
 #define STAN_IO_STAN_CSV_READER_HPP
 
 #include <boost/algorithm/string.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <stan/io/fast_parse_double.hpp>
 #include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/services/util/parallel_for.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
 #include <istream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace stan {
   namespace io {
@@ -255,71 +268,137 @@ namespace stan {
 
       static bool read_samples(std::istream& in, Eigen::MatrixXd& samples,
                                stan_csv_timing& timing, std::ostream* out) {
-        std::stringstream ss;
-        std::string line;
-
-        int rows = 0;
-        int cols = -1;
-
         if (in.peek() == '#' || in.good() == false)
           return false;
+        std::string buf((std::istreambuf_iterator<char>(in)),
+                        std::istreambuf_iterator<char>());
+        return read_samples(buf.data(), buf.data() + buf.size(),
+                            std::vector<size_t>(), samples, timing, out, 1);
+      }
 
-        while (in.good()) {
-          bool comment_line = (in.peek() == '#');
-          bool empty_line   = (in.peek() == '\n');
+      /**
+       * Reads the samples from a buffer holding the rest of a Stan CSV
+       * file after the adaptation comments.
+       *
+       * Rows are located in one pass over the buffer, then parsed in
+       * chunks of rows, in parallel if more than one thread is
+       * requested and the code is compiled with
+       * <code>STAN_THREADS</code>.
+       *
+       * @param[in] begin start of buffer
+       * @param[in] end end of buffer
+       * @param[in] columns indices of the columns to read, in the order
+       *   of the columns of <code>samples</code>; all columns if empty
+       * @param[out] samples values of the columns read, one row per
+       *   draw
+       * @param[in,out] timing timing read from comments is added to
+       * @param[out] out output stream to send messages
+       * @param[in] num_threads maximum number of threads to use
+       * @return <code>false</code> if the buffer starts with a comment
+       *   or the rows have different numbers of columns
+       */
+      static bool read_samples(const char* begin, const char* end,
+                               const std::vector<size_t>& columns,
+                               Eigen::MatrixXd& samples,
+                               stan_csv_timing& timing, std::ostream* out,
+                               size_t num_threads) {
+        if (begin == end || *begin == '#')
+          return false;
 
-          std::getline(in, line);
+        std::vector<row_t> rows;
+        scan_rows(begin, end, true, rows, timing);
+        int cols = -1;
+        if (!check_columns(rows, 0, cols, out))
+          return false;
+        if (rows.empty())
+          return true;
 
-          if (empty_line)
-            continue;
-          if (!line.length())
-            break;
-
-          if (comment_line) {
-            if (line.find("(Warm-up)") != std::string::npos) {
-              int left = 17;
-              int right = line.find(" seconds");
-              double warmup;
-              std::stringstream(line.substr(left, right - left)) >> warmup;
-              timing.warmup += warmup;
-            } else if (line.find("(Sampling)") != std::string::npos) {
-              int left = 17;
-              int right = line.find(" seconds");
-              double sampling;
-              std::stringstream(line.substr(left, right - left)) >> sampling;
-              timing.sampling += sampling;
-            }
-          } else {
-            ss << line << '\n';
-            int current_cols = std::count(line.begin(), line.end(), ',') + 1;
-            if (cols == -1) {
-              cols = current_cols;
-            } else if (cols != current_cols) {
-              if (out)
-                *out << "Error: expected " << cols << " columns, but found "
-                     << current_cols << " instead for row " << rows + 1
-                     << std::endl;
-              return false;
+        std::vector<int> col_map;
+        size_t max_col = 0;
+        size_t num_out_cols = map_columns(cols, columns, col_map, max_col);
+        samples.resize(rows.size(), num_out_cols);
+        const size_t rows_per_job = 256;
+        size_t num_jobs = (rows.size() + rows_per_job - 1) / rows_per_job;
+        services::util::parallel_for(num_jobs, num_threads, [&](size_t n) {
+          size_t last = std::min(rows.size(), (n + 1) * rows_per_job);
+          for (size_t row = n * rows_per_job; row < last; ++row)
+            parse_row(rows[row], col_map, max_col, samples, row);
+        });
+        return true;
+      }
+
+      /**
+       * Reads the samples from the stream in blocks of rows, without
+       * holding all of them in memory.  The stream should be positioned
+       * after the adaptation comments.
+       *
+       * @tparam F type of functor, callable with a
+       *   <code>const Eigen::MatrixXd&</code>
+       * @param[in] in input stream to read
+       * @param[in] block_size maximum number of rows per block
+       * @param[in] columns indices of the columns to read, in the order
+       *   of the columns of the blocks; all columns if empty
+       * @param[in] f functor called with each block of rows, in order;
+       *   every block but the last has <code>block_size</code> rows
+       * @param[in,out] timing timing read from comments is added to
+       * @param[out] out output stream to send messages
+       * @return <code>false</code> if the stream is at a comment or
+       *   not readable or the rows have different numbers of columns
+       */
+      template <typename F>
+      static bool read_samples(std::istream& in, size_t block_size,
+                               const std::vector<size_t>& columns,
+                               const F& f, stan_csv_timing& timing,
+                               std::ostream* out) {
+        if (in.peek() == '#' || in.good() == false)
+          return false;
+        if (block_size == 0)
+          block_size = 1;
+
+        const size_t chunk_size = 1 << 20;
+        std::vector<char> buf;
+        size_t buf_end = 0;
+        std::vector<row_t> rows;
+        size_t num_rows = 0;
+        int cols = -1;
+        std::vector<int> col_map;
+        size_t max_col = 0;
+        Eigen::MatrixXd block;
+        Eigen::Index block_rows = 0;
+        bool at_end = false;
+        while (!at_end) {
+          if (buf.size() < buf_end + chunk_size)
+            buf.resize(buf_end + chunk_size);
+          in.read(&buf[buf_end], chunk_size);
+          buf_end += in.gcount();
+          at_end = !in.good();
+
+          rows.clear();
+          const char* begin = buf.data();
+          const char* rest = scan_rows(begin, begin + buf_end, at_end, rows,
+                                       timing);
+          if (!check_columns(rows, num_rows, cols, out))
+            return false;
+          if (!rows.empty() && block.size() == 0) {
+            size_t num_out_cols = map_columns(cols, columns, col_map,
+                                              max_col);
+            block.resize(block_size, num_out_cols);
+          }
+          for (size_t row = 0; row < rows.size(); ++row) {
+            parse_row(rows[row], col_map, max_col, block, block_rows++);
+            if (block_rows == block.rows()) {
+              f(static_cast<const Eigen::MatrixXd&>(block));
+              block_rows = 0;
             }
-            rows++;
           }
+          num_rows += rows.size();
 
-          in.peek();
+          buf_end -= rest - begin;
+          std::copy(rest, rest + buf_end, buf.begin());
         }
-
-        ss.seekg(std::ios_base::beg);
-
-        if (rows > 0) {
-          samples.resize(rows, cols);
-          for (int row = 0; row < rows; row++) {
-            std::getline(ss, line);
-            std::stringstream ls(line);
-            for (int col = 0; col < cols; col++) {
-              std::getline(ls, line, ',');
-              boost::trim(line);
-              std::stringstream(line) >> samples(row, col);
-            }
-          }
+        if (block_rows > 0) {
+          Eigen::MatrixXd last = block.topRows(block_rows);
+          f(static_cast<const Eigen::MatrixXd&>(last));
         }
         return true;
       }
@@ -332,7 +411,119 @@ namespace stan {
        */
       static stan_csv parse(std::istream& in, std::ostream* out) {
         stan_csv data;
+        parse_preamble(in, data, out);
+
+        if (!read_samples(in, data.samples, data.timing, out)) {
+          if (out)
+            *out << "Warning: non-fatal error reading samples" << std::endl;
+        }
+
+        return data;
+      }
+
+      /**
+       * Parses the file with the specified name by mapping it into
+       * memory.  Rows of samples are parsed in parallel if more than
+       * one thread is requested and the code is compiled with
+       * <code>STAN_THREADS</code>.
+       *
+       * @param[in] filename name of file to parse
+       * @param[out] out output stream to send messages
+       * @param[in] columns names of the columns to read, as in the
+       *   returned header, in the order to return them; all columns
+       *   if empty
+       * @param[in] num_threads maximum number of threads to use
+       * @return parsed file, empty if the file is empty
+       * @throw std::invalid_argument if the file cannot be mapped, the
+       *   header cannot be read or a column is not in the header or
+       *   is requested more than once
+       */
+      static stan_csv parse_file(const std::string& filename,
+                                 std::ostream* out,
+                                 const std::vector<std::string>& columns
+                                   = std::vector<std::string>(),
+                                 size_t num_threads = 1) {
+        // an empty file cannot be mapped, and holds no header or samples
+        std::ifstream file(filename.c_str(),
+                           std::ios::binary | std::ios::ate);
+        if (!file)
+          throw std::invalid_argument("Error opening input file "
+                                      + filename);
+        if (file.tellg() == std::streampos(0)) {
+          stan_csv data;
+          column_indexes(data, columns);
+          return data;
+        }
+        file.close();
+
+        boost::interprocess::mapped_region region;
+        try {
+          boost::interprocess::file_mapping
+            mapping(filename.c_str(), boost::interprocess::read_only);
+          boost::interprocess::mapped_region
+            mapped(mapping, boost::interprocess::read_only);
+          region.swap(mapped);
+        } catch (const boost::interprocess::interprocess_exception& e) {
+          throw std::invalid_argument("Error mapping input file "
+                                      + filename + ": " + e.what());
+        }
+        const char* begin = static_cast<const char*>(region.get_address());
+        const char* end = begin + region.get_size();
+
+        // the comments and header before the samples are small, so are
+        // read through a stream as by parse()
+        const char* samples_begin = skip_preamble(begin, end);
+        std::istringstream preamble(std::string(begin, samples_begin));
+        stan_csv data;
+        parse_preamble(preamble, data, out);
+        std::vector<size_t> indexes = column_indexes(data, columns);
+
+        if (!read_samples(samples_begin, end, indexes, data.samples,
+                          data.timing, out, num_threads)) {
+          if (out)
+            *out << "Warning: non-fatal error reading samples" << std::endl;
+        }
+        return data;
+      }
+
+      /**
+       * Parses the file, passing the samples to a functor in blocks of
+       * rows instead of storing them, so files larger than memory can
+       * be processed.  The samples of the returned object are empty.
+       *
+       * @tparam F type of functor, callable with a
+       *   <code>const Eigen::MatrixXd&</code>
+       * @param[in] in input stream to parse
+       * @param[out] out output stream to send messages
+       * @param[in] block_size maximum number of rows per block
+       * @param[in] f functor called with each block of rows, in order
+       * @param[in] columns names of the columns to read, as in the
+       *   returned header, in the order of the columns of the blocks;
+       *   all columns if empty
+       * @throw std::invalid_argument if the header cannot be read or a
+       *   column is not in the header or is requested more than once
+       */
+      template <typename F>
+      static stan_csv parse_blocks(std::istream& in, std::ostream* out,
+                                   size_t block_size, const F& f,
+                                   const std::vector<std::string>& columns
+                                     = std::vector<std::string>()) {
+        stan_csv data;
+        parse_preamble(in, data, out);
+        std::vector<size_t> indexes = column_indexes(data, columns);
+
+        if (!read_samples(in, block_size, indexes, f, data.timing, out)) {
+          if (out)
+            *out << "Warning: non-fatal error reading samples" << std::endl;
+        }
+        return data;
+      }
 
+    private:
+      typedef std::pair<const char*, const char*> row_t;
+
+      static void parse_preamble(std::istream& in, stan_csv& data,
+                                 std::ostream* out) {
         if (!read_metadata(in, data.metadata, out)) {
           if (out)
             *out << "Warning: non-fatal error reading metadata" << std::endl;
@@ -353,13 +544,185 @@ namespace stan {
 
         data.timing.warmup = 0;
         data.timing.sampling = 0;
+      }
 
-        if (!read_samples(in, data.samples, data.timing, out)) {
-          if (out)
-            *out << "Warning: non-fatal error reading samples" << std::endl;
+      // start of the first line after the metadata comments, the
+      // header and the adaptation comments
+      static const char* skip_preamble(const char* begin, const char* end) {
+        const char* line = begin;
+        bool header = false;
+        while (line != end) {
+          if (*line != '#') {
+            if (header || *line != 'l')
+              break;
+            header = true;
+          }
+          const char* eol = std::find(line, end, '\n');
+          line = eol == end ? end : eol + 1;
+        }
+        return line;
+      }
+
+      /**
+       * Select the named columns, reordering the header to match, and
+       * return their indexes.  Returns no indexes, selecting all
+       * columns, if no names are given.
+       */
+      static std::vector<size_t>
+      column_indexes(stan_csv& data, const std::vector<std::string>& names) {
+        std::vector<size_t> indexes;
+        if (names.empty())
+          return indexes;
+        Eigen::Matrix<std::string, Eigen::Dynamic, 1> header(names.size());
+        for (size_t n = 0; n < names.size(); ++n) {
+          Eigen::Index col = 0;
+          while (col < data.header.size() && data.header(col) != names[n])
+            ++col;
+          if (col == data.header.size())
+            throw std::invalid_argument("Column " + names[n]
+                                        + " not found in input file");
+          if (std::find(indexes.begin(), indexes.end(), col)
+              != indexes.end())
+            throw std::invalid_argument("Column " + names[n]
+                                        + " requested more than once");
+          indexes.push_back(col);
+          header(n) = names[n];
         }
+        data.header = header;
+        return indexes;
+      }
 
-        return data;
+      /**
+       * Add the data rows of the lines in [begin, end) to rows and the
+       * timing of comment lines to timing, skipping empty lines.  If
+       * not at the end of the input, a final line without a newline is
+       * left unscanned.
+       *
+       * @return start of the first line not scanned
+       */
+      static const char* scan_rows(const char* begin, const char* end,
+                                   bool at_end, std::vector<row_t>& rows,
+                                   stan_csv_timing& timing) {
+        const char* line = begin;
+        while (line != end) {
+          const char* eol = static_cast<const char*>(
+              std::memchr(line, '\n', end - line));
+          if (eol == 0) {
+            if (!at_end)
+              break;
+            eol = end;
+          }
+          if (eol != line) {
+            if (*line == '#')
+              read_timing(std::string(line, eol), timing);
+            else
+              rows.push_back(row_t(line, eol));
+          }
+          line = eol == end ? end : eol + 1;
+        }
+        return line;
+      }
+
+      static void read_timing(const std::string& line,
+                              stan_csv_timing& timing) {
+        if (line.find("(Warm-up)") != std::string::npos) {
+          int left = 17;
+          int right = line.find(" seconds");
+          double warmup;
+          std::stringstream(line.substr(left, right - left)) >> warmup;
+          timing.warmup += warmup;
+        } else if (line.find("(Sampling)") != std::string::npos) {
+          int left = 17;
+          int right = line.find(" seconds");
+          double sampling;
+          std::stringstream(line.substr(left, right - left)) >> sampling;
+          timing.sampling += sampling;
+        }
+      }
+
+      /**
+       * Check that each row has the same number of columns as the
+       * first row read, setting cols from the first row if it is -1.
+       *
+       * @param first_row number of rows checked before these
+       */
+      static bool check_columns(const std::vector<row_t>& rows,
+                                size_t first_row, int& cols,
+                                std::ostream* out) {
+        for (size_t row = 0; row < rows.size(); ++row) {
+          int current_cols = std::count(rows[row].first, rows[row].second,
+                                        ',') + 1;
+          if (cols == -1) {
+            cols = current_cols;
+          } else if (cols != current_cols) {
+            if (out)
+              *out << "Error: expected " << cols << " columns, but found "
+                   << current_cols << " instead for row "
+                   << first_row + row + 1 << std::endl;
+            return false;
+          }
+        }
+        return true;
+      }
+
+      /**
+       * Build the map from column of the file to column of the
+       * samples, -1 for columns not read, and return the number of
+       * columns read.
+       */
+      static size_t map_columns(int cols, const std::vector<size_t>& columns,
+                                std::vector<int>& col_map, size_t& max_col) {
+        col_map.assign(cols, -1);
+        if (columns.empty()) {
+          for (int col = 0; col < cols; ++col)
+            col_map[col] = col;
+          max_col = cols - 1;
+          return cols;
+        }
+        max_col = 0;
+        for (size_t n = 0; n < columns.size(); ++n) {
+          if (columns[n] >= col_map.size())
+            throw std::invalid_argument("Column index out of range");
+          if (col_map[columns[n]] >= 0)
+            throw std::invalid_argument("Column index repeated");
+          col_map[columns[n]] = n;
+          max_col = std::max(max_col, columns[n]);
+        }
+        return columns.size();
+      }
+
+      static void parse_row(const row_t& row, const std::vector<int>& col_map,
+                            size_t max_col, Eigen::MatrixXd& samples,
+                            Eigen::Index sample_row) {
+        const char* token = row.first;
+        for (size_t col = 0; col <= max_col; ++col) {
+          const char* comma = std::find(token, row.second, ',');
+          if (col_map[col] >= 0)
+            samples(sample_row, col_map[col]) = parse_value(token, comma);
+          token = comma + 1;
+        }
+      }
+
+      // characters of a token, for fast_parse_double
+      struct token_t {
+        const char* begin;
+        const char* end;
+        size_t size() const { return end - begin; }
+        char operator[](size_t n) const { return begin[n]; }
+      };
+
+      static double parse_value(const char* begin, const char* end) {
+        while (begin != end
+               && std::isspace(static_cast<unsigned char>(*begin)))
+          ++begin;
+        while (end != begin
+               && std::isspace(static_cast<unsigned char>(*(end - 1))))
+          --end;
+        token_t token = { begin, end };
+        double x = 0;
+        if (!fast_parse_double(token, x))
+          std::stringstream(std::string(begin, end)) >> x;
+        return x;
       }
     };
 
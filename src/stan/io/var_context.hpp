@@ -111,6 +111,76 @@ namespace stan {
        */
       virtual void names_i(std::vector<std::string>& names) const = 0;
 
+      /**
+       * Return a reference to the floating point values for the
+       * variable of the specified name, as returned by
+       * <code>vals_r()</code>, without copying them if the context
+       * stores them as doubles.
+       *
+       * <p>This default implementation copies the values into the
+       * specified buffer and returns a reference to it.  Contexts that
+       * store the values return a reference to their storage and leave
+       * the buffer unchanged.  The reference is valid as long as the
+       * context and the buffer are neither modified nor destroyed.
+       *
+       * @param name Name of variable.
+       * @param buffer Storage for the values if they must be copied.
+       * @return Sequence of values for the named variable.
+       */
+      virtual const std::vector<double>&
+      vals_r_ref(const std::string& name,
+                 std::vector<double>& buffer) const {
+        buffer = vals_r(name);
+        return buffer;
+      }
+
+      /**
+       * Return a reference to the dimensions of the specified floating
+       * point variable, as returned by <code>dims_r()</code>.  See
+       * <code>vals_r_ref()</code> for the use of the buffer.
+       *
+       * @param name Name of variable.
+       * @param buffer Storage for the dimensions if they must be copied.
+       * @return Sequence of dimensions for the variable.
+       */
+      virtual const std::vector<size_t>&
+      dims_r_ref(const std::string& name,
+                 std::vector<size_t>& buffer) const {
+        buffer = dims_r(name);
+        return buffer;
+      }
+
+      /**
+       * Return a reference to the integer values for the variable of
+       * the specified name, as returned by <code>vals_i()</code>.  See
+       * <code>vals_r_ref()</code> for the use of the buffer.
+       *
+       * @param name Name of variable.
+       * @param buffer Storage for the values if they must be copied.
+       * @return Sequence of integer values.
+       */
+      virtual const std::vector<int>&
+      vals_i_ref(const std::string& name, std::vector<int>& buffer) const {
+        buffer = vals_i(name);
+        return buffer;
+      }
+
+      /**
+       * Return a reference to the dimensions of the specified integer
+       * variable, as returned by <code>dims_i()</code>.  See
+       * <code>vals_r_ref()</code> for the use of the buffer.
+       *
+       * @param name Name of variable.
+       * @param buffer Storage for the dimensions if they must be copied.
+       * @return Sequence of dimensions for the variable.
+       */
+      virtual const std::vector<size_t>&
+      dims_i_ref(const std::string& name,
+                 std::vector<size_t>& buffer) const {
+        buffer = dims_i(name);
+        return buffer;
+      }
+
       void add_vec(std::stringstream& msg,
                    const std::vector<size_t>& dims) const {
         msg << '(';
@@ -147,7 +217,8 @@ namespace stan {
             throw std::runtime_error(msg.str());
           }
         }
-        std::vector<size_t> dims = dims_r(name);
+        std::vector<size_t> dims_buffer;
+        const std::vector<size_t>& dims = dims_r_ref(name, dims_buffer);
         if (dims.size() != dims_declared.size()) {
           std::stringstream msg;
           msg << "mismatch in number dimensions declared and found in context"
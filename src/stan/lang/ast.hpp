@@ -57,6 +57,7 @@
 #include <stan/lang/ast/fun/write_expression_vis.hpp>
 #include <stan/lang/ast/fun/write_idx_vis.hpp>
 
+#include <stan/lang/ast/fun/eliminate_common_subexprs.hpp>
 #include <stan/lang/ast/fun/ends_with.hpp>
 #include <stan/lang/ast/fun/fun_name_exists.hpp>
 #include <stan/lang/ast/fun/generate_expression.hpp>
@@ -72,6 +73,8 @@
 #include <stan/lang/ast/fun/has_rng_suffix.hpp>
 #include <stan/lang/ast/fun/has_var.hpp>
 #include <stan/lang/ast/fun/has_var_vis.hpp>
+#include <stan/lang/ast/fun/hoist_data_expr_vis.hpp>
+#include <stan/lang/ast/fun/hoist_data_exprs.hpp>
 #include <stan/lang/ast/fun/indexed_type.hpp>
 #include <stan/lang/ast/fun/infer_type_indexing.hpp>
 #include <stan/lang/ast/fun/is_assignable.hpp>
@@ -82,6 +85,7 @@
 #include <stan/lang/ast/fun/is_space.hpp>
 #include <stan/lang/ast/fun/is_user_defined.hpp>
 #include <stan/lang/ast/fun/is_user_defined_prob_function.hpp>
+#include <stan/lang/ast/fun/mentions_var_vis.hpp>
 #include <stan/lang/ast/fun/num_index_op_dims.hpp>
 #include <stan/lang/ast/fun/print_scope.hpp>
 #include <stan/lang/ast/fun/promote_primitive.hpp>
@@ -91,6 +95,7 @@
 #include <stan/lang/ast/fun/strip_cdf_suffix.hpp>
 #include <stan/lang/ast/fun/strip_prob_fun_suffix.hpp>
 #include <stan/lang/ast/fun/var_occurs_vis.hpp>
+#include <stan/lang/ast/fun/vectorize_sampling_loops.hpp>
 
 #include <stan/lang/ast/sigs/function_signature_t.hpp>
 #include <stan/lang/ast/sigs/function_signatures.hpp>
@@ -117,6 +122,7 @@
 #include <stan/lang/ast/node/fun.hpp>
 #include <stan/lang/ast/node/function_decl_def.hpp>
 #include <stan/lang/ast/node/function_decl_defs.hpp>
+#include <stan/lang/ast/node/hoisted_expr.hpp>
 #include <stan/lang/ast/node/idx.hpp>
 #include <stan/lang/ast/node/increment_log_prob_statement.hpp>
 #include <stan/lang/ast/node/index_op.hpp>
@@ -0,0 +1,37 @@
+#ifndef STAN_LANG_AST_FUN_ELIMINATE_COMMON_SUBEXPRS_HPP
+#define STAN_LANG_AST_FUN_ELIMINATE_COMMON_SUBEXPRS_HPP
+
+namespace stan {
+  namespace lang {
+
+    struct program;
+
+    /**
+     * Replace real-valued subexpressions that are evaluated more than
+     * once within a block of the transformed parameters or model
+     * block of the specified program by local variables holding their
+     * values, so that each is computed, and for parameters recorded
+     * on the autodiff expression graph, only once.
+     *
+     * <p>A subexpression is shared only if it is repeated in the
+     * expressions of statements directly in the same block, at
+     * positions that are always evaluated, and if no variable it
+     * mentions is assigned from the statement containing its first
+     * occurrence up to the statement containing its last.  The
+     * temporary <code>cse_k__</code> is declared in the block and
+     * assigned immediately before the statement containing the first
+     * occurrence, so evaluation order with respect to earlier
+     * statements is unchanged.  Subexpressions calling user-defined
+     * functions, functions with <code>_rng</code> or
+     * <code>_lp</code> suffixes or <code>target()</code>, and those
+     * containing ODE integrators, algebraic solvers or
+     * <code>map_rect</code>, are never shared.  Larger subexpressions
+     * are shared before the subexpressions they contain.
+     *
+     * @param[in,out] prog program to rewrite
+     */
+    void eliminate_common_subexprs(program& prog);
+
+  }
+}
+#endif
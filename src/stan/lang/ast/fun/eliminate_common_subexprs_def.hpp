@@ -0,0 +1,492 @@
+#ifndef STAN_LANG_AST_FUN_ELIMINATE_COMMON_SUBEXPRS_DEF_HPP
+#define STAN_LANG_AST_FUN_ELIMINATE_COMMON_SUBEXPRS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/variant/get.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Return pointers to the immediate subexpressions of the
+     * specified expression.  If the flag is set, only subexpressions
+     * that are evaluated whenever the expression is are returned,
+     * leaving out the branches of conditional operators and the
+     * operands of short-circuiting logical operators.  Subexpressions
+     * of ODE integrators, algebraic solvers and <code>map_rect</code>
+     * are never returned.
+     *
+     * @param[in] e expression
+     * @param[in] eager_only true if only eagerly evaluated
+     * subexpressions are returned
+     * @return subexpressions
+     */
+    std::vector<expression*> cse_subexprs(expression& e, bool eager_only) {
+      std::vector<expression*> subexprs;
+      if (array_expr* x = boost::get<array_expr>(&e.expr_)) {
+        for (size_t i = 0; i < x->args_.size(); ++i)
+          subexprs.push_back(&x->args_[i]);
+      } else if (matrix_expr* x = boost::get<matrix_expr>(&e.expr_)) {
+        for (size_t i = 0; i < x->args_.size(); ++i)
+          subexprs.push_back(&x->args_[i]);
+      } else if (row_vector_expr* x = boost::get<row_vector_expr>(&e.expr_)) {
+        for (size_t i = 0; i < x->args_.size(); ++i)
+          subexprs.push_back(&x->args_[i]);
+      } else if (fun* x = boost::get<fun>(&e.expr_)) {
+        if (eager_only
+            && (x->name_ == "logical_or" || x->name_ == "logical_and"))
+          return subexprs;
+        for (size_t i = 0; i < x->args_.size(); ++i)
+          subexprs.push_back(&x->args_[i]);
+      } else if (index_op* x = boost::get<index_op>(&e.expr_)) {
+        subexprs.push_back(&x->expr_);
+        for (size_t i = 0; i < x->dimss_.size(); ++i)
+          for (size_t j = 0; j < x->dimss_[i].size(); ++j)
+            subexprs.push_back(&x->dimss_[i][j]);
+      } else if (index_op_sliced* x = boost::get<index_op_sliced>(&e.expr_)) {
+        subexprs.push_back(&x->expr_);
+        for (size_t i = 0; i < x->idxs_.size(); ++i) {
+          idx& k = x->idxs_[i];
+          if (uni_idx* y = boost::get<uni_idx>(&k.idx_)) {
+            subexprs.push_back(&y->idx_);
+          } else if (multi_idx* y = boost::get<multi_idx>(&k.idx_)) {
+            subexprs.push_back(&y->idxs_);
+          } else if (lb_idx* y = boost::get<lb_idx>(&k.idx_)) {
+            subexprs.push_back(&y->lb_);
+          } else if (ub_idx* y = boost::get<ub_idx>(&k.idx_)) {
+            subexprs.push_back(&y->ub_);
+          } else if (lub_idx* y = boost::get<lub_idx>(&k.idx_)) {
+            subexprs.push_back(&y->lb_);
+            subexprs.push_back(&y->ub_);
+          }
+        }
+      } else if (conditional_op* x = boost::get<conditional_op>(&e.expr_)) {
+        subexprs.push_back(&x->cond_);
+        if (!eager_only) {
+          subexprs.push_back(&x->true_val_);
+          subexprs.push_back(&x->false_val_);
+        }
+      } else if (binary_op* x = boost::get<binary_op>(&e.expr_)) {
+        subexprs.push_back(&x->left);
+        subexprs.push_back(&x->right);
+      } else if (unary_op* x = boost::get<unary_op>(&e.expr_)) {
+        subexprs.push_back(&x->subject);
+      }
+      return subexprs;
+    }
+
+    /**
+     * Return a string that is the same for two expressions if and
+     * only if they compute the same value, or the empty string if the
+     * expression may not be shared.  Unlike
+     * <code>expression::to_string()</code>, operators are fully
+     * parenthesized.
+     *
+     * @param[in] e expression
+     * @return key for the expression
+     */
+    std::string cse_key(expression& e) {
+      if (const int_literal* x = boost::get<int_literal>(&e.expr_))
+        return boost::lexical_cast<std::string>(x->val_);
+      if (const double_literal* x = boost::get<double_literal>(&e.expr_))
+        return x->string_;
+      if (const variable* x = boost::get<variable>(&e.expr_))
+        return x->name_;
+      if (const fun* x = boost::get<fun>(&e.expr_)) {
+        if (is_user_defined(*x) || has_rng_suffix(x->name_)
+            || has_lp_suffix(x->name_) || x->name_ == "get_lp")
+          return "";
+      } else if (!boost::get<array_expr>(&e.expr_)
+                 && !boost::get<matrix_expr>(&e.expr_)
+                 && !boost::get<row_vector_expr>(&e.expr_)
+                 && !boost::get<index_op>(&e.expr_)
+                 && !boost::get<index_op_sliced>(&e.expr_)
+                 && !boost::get<conditional_op>(&e.expr_)
+                 && !boost::get<binary_op>(&e.expr_)
+                 && !boost::get<unary_op>(&e.expr_)) {
+        return "";
+      }
+
+      std::vector<expression*> subexprs = cse_subexprs(e, false);
+      std::vector<std::string> keys;
+      for (size_t i = 0; i < subexprs.size(); ++i) {
+        keys.push_back(cse_key(*subexprs[i]));
+        if (keys.back().empty())
+          return "";
+      }
+
+      std::string key;
+      if (const fun* x = boost::get<fun>(&e.expr_)) {
+        key = x->name_ + "(";
+      } else if (boost::get<array_expr>(&e.expr_)) {
+        key = "{";
+      } else if (boost::get<matrix_expr>(&e.expr_)) {
+        key = "matrix[";
+      } else if (boost::get<row_vector_expr>(&e.expr_)) {
+        key = "[";
+      } else if (boost::get<conditional_op>(&e.expr_)) {
+        key = "?(";
+      } else if (const binary_op* x = boost::get<binary_op>(&e.expr_)) {
+        key = x->op + "(";
+      } else if (const unary_op* x = boost::get<unary_op>(&e.expr_)) {
+        key = x->op + "(";
+      } else if (const index_op* x = boost::get<index_op>(&e.expr_)) {
+        key = "index" + boost::lexical_cast<std::string>(x->dimss_.size())
+          + "(";
+      } else if (const index_op_sliced* x
+                 = boost::get<index_op_sliced>(&e.expr_)) {
+        // the kind of each index is needed to tell them apart
+        key = "slice(";
+        for (size_t i = 0; i < x->idxs_.size(); ++i) {
+          const idx& k = x->idxs_[i];
+          if (boost::get<uni_idx>(&k.idx_))
+            key += "u";
+          else if (boost::get<multi_idx>(&k.idx_))
+            key += "m";
+          else if (boost::get<omni_idx>(&k.idx_))
+            key += "o";
+          else if (boost::get<lb_idx>(&k.idx_))
+            key += "l";
+          else if (boost::get<ub_idx>(&k.idx_))
+            key += "r";
+          else
+            key += "b";
+        }
+        key += ",";
+      }
+      for (size_t i = 0; i < keys.size(); ++i) {
+        if (i > 0)
+          key += ",";
+        key += keys[i];
+      }
+      return key + ")";
+    }
+
+    /**
+     * Add the names of the variables mentioned in the specified
+     * expression to the specified set.
+     *
+     * @param[in] e expression
+     * @param[in,out] vars set of variable names
+     */
+    void cse_vars(expression& e, std::set<std::string>& vars) {
+      if (const variable* x = boost::get<variable>(&e.expr_))
+        vars.insert(x->name_);
+      std::vector<expression*> subexprs = cse_subexprs(e, false);
+      for (size_t i = 0; i < subexprs.size(); ++i)
+        cse_vars(*subexprs[i], vars);
+    }
+
+    /**
+     * Return true if the specified expression is worth sharing: it is
+     * a real-valued function application or operator that may be
+     * shared and that depends on a variable that is neither data nor
+     * integer valued, so that its value is an autodiff variable in
+     * the log density.
+     *
+     * @param[in] e expression
+     * @param[in] data_vars names of data, transformed data and hoisted
+     * variables
+     * @return true if the expression is worth sharing
+     */
+    bool is_cse_candidate(expression& e,
+                          const std::set<std::string>& data_vars) {
+      if (!(boost::get<fun>(&e.expr_) || boost::get<binary_op>(&e.expr_)
+            || boost::get<unary_op>(&e.expr_))
+          || !e.bare_type().is_double_type()
+          || cse_key(e).empty())
+        return false;
+      std::vector<expression*> stack(1, &e);
+      while (!stack.empty()) {
+        expression& x = *stack.back();
+        stack.pop_back();
+        if (const variable* v = boost::get<variable>(&x.expr_)) {
+          if (!data_vars.count(v->name_)
+              && !v->type_.innermost_type().is_int_type())
+            return true;
+        }
+        std::vector<expression*> subexprs = cse_subexprs(x, false);
+        stack.insert(stack.end(), subexprs.begin(), subexprs.end());
+      }
+      return false;
+    }
+
+    /**
+     * Count the occurrences of candidates for sharing among the
+     * specified expression and its eagerly evaluated subexpressions.
+     *
+     * @param[in] e expression
+     * @param[in] data_vars names of data, transformed data and hoisted
+     * variables
+     * @param[in,out] counts number of occurrences of each key
+     */
+    void count_cse_candidates(expression& e,
+                              const std::set<std::string>& data_vars,
+                              std::map<std::string, int>& counts) {
+      if (is_cse_candidate(e, data_vars))
+        ++counts[cse_key(e)];
+      std::vector<expression*> subexprs = cse_subexprs(e, true);
+      for (size_t i = 0; i < subexprs.size(); ++i)
+        count_cse_candidates(*subexprs[i], data_vars, counts);
+    }
+
+    /**
+     * Replace every occurrence of the expression with the specified
+     * key in the specified expression by the specified variable,
+     * returning the number of replacements.
+     *
+     * @param[in,out] e expression
+     * @param[in] key key of expression to replace
+     * @param[in] v variable
+     * @return number of replacements
+     */
+    int replace_cse(expression& e, const std::string& key,
+                    const variable& v) {
+      if (cse_key(e) == key) {
+        e = expression(v);
+        return 1;
+      }
+      int n = 0;
+      std::vector<expression*> subexprs = cse_subexprs(e, false);
+      for (size_t i = 0; i < subexprs.size(); ++i)
+        n += replace_cse(*subexprs[i], key, v);
+      return n;
+    }
+
+    /**
+     * Return pointers to the expressions evaluated by the specified
+     * statement if it is an assignment, sampling statement, increment
+     * of the log density or expression statement, or an empty
+     * sequence otherwise.  Truncation bounds and left-hand side
+     * indexes are not included.
+     *
+     * @param[in] s statement
+     * @return expressions of the statement
+     */
+    std::vector<expression*> cse_statement_exprs(statement& s) {
+      std::vector<expression*> exprs;
+      if (assgn* x = boost::get<assgn>(&s.statement_)) {
+        exprs.push_back(&x->rhs_);
+      } else if (sample* x = boost::get<sample>(&s.statement_)) {
+        exprs.push_back(&x->expr_);
+        for (size_t i = 0; i < x->dist_.args_.size(); ++i)
+          exprs.push_back(&x->dist_.args_[i]);
+      } else if (increment_log_prob_statement* x
+                 = boost::get<increment_log_prob_statement>(&s.statement_)) {
+        exprs.push_back(&x->log_prob_);
+      } else if (expression* x = boost::get<expression>(&s.statement_)) {
+        exprs.push_back(x);
+      }
+      return exprs;
+    }
+
+    /**
+     * Return the first eagerly evaluated subexpression of the
+     * specified statement with the specified key, or nil if there is
+     * none.
+     *
+     * @param[in] s statement
+     * @param[in] key key of subexpression
+     * @return subexpression
+     */
+    expression find_cse(statement& s, const std::string& key) {
+      std::vector<expression*> stack = cse_statement_exprs(s);
+      std::reverse(stack.begin(), stack.end());
+      while (!stack.empty()) {
+        expression* x = stack.back();
+        stack.pop_back();
+        if (cse_key(*x) == key)
+          return *x;
+        std::vector<expression*> subexprs = cse_subexprs(*x, true);
+        stack.insert(stack.end(), subexprs.rbegin(), subexprs.rend());
+      }
+      return expression(nil());
+    }
+
+    /**
+     * Add the names of the variables assigned by the specified
+     * statement or by any statement nested in it to the specified
+     * set.
+     *
+     * @param[in] s statement
+     * @param[in,out] vars set of variable names
+     */
+    void cse_assigned_vars(const statement& s, std::set<std::string>& vars) {
+      if (const assgn* x = boost::get<assgn>(&s.statement_)) {
+        vars.insert(x->lhs_var_.name_);
+      } else if (const statements* x = boost::get<statements>(&s.statement_)) {
+        for (size_t i = 0; i < x->statements_.size(); ++i)
+          cse_assigned_vars(x->statements_[i], vars);
+      } else if (const for_statement* x
+                 = boost::get<for_statement>(&s.statement_)) {
+        cse_assigned_vars(x->statement_, vars);
+      } else if (const for_array_statement* x
+                 = boost::get<for_array_statement>(&s.statement_)) {
+        cse_assigned_vars(x->statement_, vars);
+      } else if (const for_matrix_statement* x
+                 = boost::get<for_matrix_statement>(&s.statement_)) {
+        cse_assigned_vars(x->statement_, vars);
+      } else if (const conditional_statement* x
+                 = boost::get<conditional_statement>(&s.statement_)) {
+        for (size_t i = 0; i < x->bodies_.size(); ++i)
+          cse_assigned_vars(x->bodies_[i], vars);
+      } else if (const while_statement* x
+                 = boost::get<while_statement>(&s.statement_)) {
+        cse_assigned_vars(x->body_, vars);
+      }
+    }
+
+    /**
+     * Share the largest subexpression repeated among the statements
+     * of the specified block that can be shared, returning true if
+     * there is one.
+     *
+     * @param[in,out] block block of statements
+     * @param[in] data_vars names of data, transformed data and hoisted
+     * variables
+     * @param[in,out] num_temps number of temporaries introduced so far
+     * @return true if a subexpression was shared
+     */
+    bool eliminate_common_subexpr(statements& block,
+                                  const std::set<std::string>& data_vars,
+                                  int& num_temps) {
+      std::vector<statement>& stmts = block.statements_;
+      std::map<std::string, int> counts;
+      std::map<std::string, size_t> first;
+      std::map<std::string, size_t> last;
+      for (size_t i = 0; i < stmts.size(); ++i) {
+        std::vector<expression*> exprs = cse_statement_exprs(stmts[i]);
+        for (size_t j = 0; j < exprs.size(); ++j) {
+          std::map<std::string, int> stmt_counts;
+          count_cse_candidates(*exprs[j], data_vars, stmt_counts);
+          for (std::map<std::string, int>::const_iterator it
+                 = stmt_counts.begin(); it != stmt_counts.end(); ++it) {
+            if (counts[it->first] == 0)
+              first[it->first] = i;
+            counts[it->first] += it->second;
+            last[it->first] = i;
+          }
+        }
+      }
+
+      // try larger subexpressions first
+      std::multimap<size_t, std::string> candidates;
+      for (std::map<std::string, int>::const_iterator it = counts.begin();
+           it != counts.end(); ++it)
+        if (it->second >= 2)
+          candidates.insert(std::make_pair(it->first.size(), it->first));
+
+      for (std::multimap<size_t, std::string>::const_reverse_iterator it
+             = candidates.rbegin(); it != candidates.rend(); ++it) {
+        const std::string& key = it->second;
+        size_t begin = first[key];
+        size_t end = last[key];
+        expression shared = find_cse(stmts[begin], key);
+        std::set<std::string> vars;
+        cse_vars(shared, vars);
+        std::set<std::string> assigned;
+        for (size_t i = begin; i < end; ++i)
+          cse_assigned_vars(stmts[i], assigned);
+        bool clobbered = false;
+        for (std::set<std::string>::const_iterator v = vars.begin();
+             v != vars.end(); ++v)
+          if (assigned.count(*v))
+            clobbered = true;
+        if (clobbered)
+          continue;
+
+        variable v("cse_" + boost::lexical_cast<std::string>(num_temps++)
+                   + "__");
+        v.set_type(shared.bare_type());
+        for (size_t i = begin; i <= end; ++i) {
+          std::vector<expression*> exprs = cse_statement_exprs(stmts[i]);
+          for (size_t j = 0; j < exprs.size(); ++j)
+            replace_cse(*exprs[j], key, v);
+        }
+
+        local_var_decl decl(v.name_, local_var_type(double_type()));
+        decl.begin_line_ = stmts[begin].begin_line_;
+        decl.end_line_ = stmts[begin].begin_line_;
+        block.local_decl_.push_back(decl);
+        statement assign(assgn(v, std::vector<idx>(), "=", shared));
+        assign.begin_line_ = stmts[begin].begin_line_;
+        assign.end_line_ = stmts[begin].begin_line_;
+        stmts.insert(stmts.begin() + begin, assign);
+        return true;
+      }
+      return false;
+    }
+
+    /**
+     * Share the repeated subexpressions in each block of the
+     * specified statement and of the statements nested in it.
+     *
+     * @param[in,out] s statement to rewrite
+     * @param[in] data_vars names of data, transformed data and hoisted
+     * variables
+     * @param[in,out] num_temps number of temporaries introduced so far
+     */
+    void eliminate_common_subexprs(statement& s,
+                                   const std::set<std::string>& data_vars,
+                                   int& num_temps) {
+      if (statements* x = boost::get<statements>(&s.statement_)) {
+        for (size_t i = 0; i < x->statements_.size(); ++i)
+          eliminate_common_subexprs(x->statements_[i], data_vars, num_temps);
+        while (eliminate_common_subexpr(*x, data_vars, num_temps)) { }
+      } else if (for_statement* x = boost::get<for_statement>(&s.statement_)) {
+        eliminate_common_subexprs(x->statement_, data_vars, num_temps);
+      } else if (for_array_statement* x
+                 = boost::get<for_array_statement>(&s.statement_)) {
+        eliminate_common_subexprs(x->statement_, data_vars, num_temps);
+      } else if (for_matrix_statement* x
+                 = boost::get<for_matrix_statement>(&s.statement_)) {
+        eliminate_common_subexprs(x->statement_, data_vars, num_temps);
+      } else if (conditional_statement* x
+                 = boost::get<conditional_statement>(&s.statement_)) {
+        for (size_t i = 0; i < x->bodies_.size(); ++i)
+          eliminate_common_subexprs(x->bodies_[i], data_vars, num_temps);
+      } else if (while_statement* x
+                 = boost::get<while_statement>(&s.statement_)) {
+        eliminate_common_subexprs(x->body_, data_vars, num_temps);
+      }
+    }
+
+    void eliminate_common_subexprs(program& prog) {
+      std::set<std::string> data_vars;
+      for (size_t i = 0; i < prog.data_decl_.size(); ++i)
+        data_vars.insert(prog.data_decl_[i].name());
+      for (size_t i = 0; i < prog.derived_data_decl_.first.size(); ++i)
+        data_vars.insert(prog.derived_data_decl_.first[i].name());
+      for (size_t i = 0; i < prog.hoisted_data_.size(); ++i)
+        data_vars.insert(prog.hoisted_data_[i].var_.name_);
+
+      int num_temps = 0;
+      // the transformed parameters statements are wrapped in a block
+      // if that is needed to declare temporaries
+      statements tparams(std::vector<local_var_decl>(),
+                         prog.derived_decl_.second);
+      statement tparams_block(tparams);
+      eliminate_common_subexprs(tparams_block, data_vars, num_temps);
+      const statements& rewritten
+        = boost::get<statements>(tparams_block.statement_);
+      if (rewritten.local_decl_.empty()) {
+        prog.derived_decl_.second = rewritten.statements_;
+      } else {
+        tparams_block.begin_line_ = rewritten.statements_[0].begin_line_;
+        tparams_block.end_line_ = rewritten.statements_.back().end_line_;
+        prog.derived_decl_.second.assign(1, tparams_block);
+      }
+      eliminate_common_subexprs(prog.statement_, data_vars, num_temps);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,170 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_DATA_EXPR_VIS_HPP
+#define STAN_LANG_AST_FUN_HOIST_DATA_EXPR_VIS_HPP
+
+#include <boost/variant/static_visitor.hpp>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    struct nil;
+    struct int_literal;
+    struct double_literal;
+    struct array_expr;
+    struct matrix_expr;
+    struct row_vector_expr;
+    struct variable;
+    struct fun;
+    struct integrate_1d;
+    struct integrate_ode;
+    struct integrate_ode_control;
+    struct algebra_solver;
+    struct algebra_solver_control;
+    struct map_rect;
+    struct index_op;
+    struct index_op_sliced;
+    struct conditional_op;
+    struct binary_op;
+    struct unary_op;
+    struct expression;
+    struct idx;
+    struct hoisted_expr;
+
+    /**
+     * Visitor to classify an expression as depending only on data
+     * and to replace its maximal data-only subexpressions by
+     * variables whose values are computed once, in the model
+     * constructor.
+     *
+     * <p>Each operator returns <code>NOT_DATA</code> if the
+     * expression depends on something other than data and transformed
+     * data variables or calls a function that may have side effects
+     * or depend on the log density; <code>CONSTANT</code> if it
+     * contains no variables; and <code>DATA</code> otherwise.  When an
+     * expression is not data only, its data-only subexpressions that
+     * are always evaluated are hoisted.  Subexpressions that are only
+     * evaluated conditionally, such as the branches of a conditional
+     * operator or the operands of short-circuiting logical
+     * operators, are classified but never hoisted on their own.
+     */
+    struct hoist_data_expr_vis : public boost::static_visitor<int> {
+      /**
+       * Classifications of expressions.
+       */
+      enum { NOT_DATA, CONSTANT, DATA };
+
+      /**
+       * Construct a visitor hoisting expressions over the specified
+       * data variables into the specified sequence.
+       *
+       * @param data_vars names of data and transformed data variables
+       * @param hoisted sequence of hoisted expressions to extend
+       * @param begin_line line of the statement being rewritten
+       * @param hoist true if subexpressions may be hoisted
+       */
+      hoist_data_expr_vis(const std::set<std::string>& data_vars,
+                          std::vector<hoisted_expr>& hoisted,
+                          std::size_t begin_line, bool hoist);
+
+      /**
+       * Return the classification of the specified expression,
+       * replacing it by a hoisted variable if it is data only and
+       * worth hoisting, and otherwise hoisting its data-only
+       * subexpressions.
+       *
+       * @param[in,out] e expression
+       * @return classification of the expression
+       */
+      int hoist_expr(expression& e) const;
+
+      /**
+       * Return the classification of the specified subexpression.
+       * If subexpressions may be hoisted and the subexpression is
+       * evaluated whenever its enclosing expression is, it is
+       * rewritten with <code>hoist_expr</code>.
+       *
+       * @param[in,out] e subexpression
+       * @param eager true if the subexpression is always evaluated
+       * along with its enclosing expression
+       * @return classification of the subexpression
+       */
+      int visit(expression& e, bool eager) const;
+
+      /**
+       * Return the classification of the specified index, hoisting
+       * data-only subexpressions of its bounds if subexpressions may
+       * be hoisted.
+       *
+       * @param[in,out] i index
+       * @return classification of the index
+       */
+      int visit_idx(idx& i) const;
+
+      /**
+       * Return the classification of an expression whose
+       * subexpressions have the specified classifications.
+       *
+       * @param k1 first classification
+       * @param k2 second classification
+       * @return combined classification
+       */
+      static int combine(int k1, int k2);
+
+      /**
+       * Return true if the specified data-only expression is worth
+       * storing in a member variable.  Variables, literals,
+       * integer-valued expressions and indexing with only single
+       * indexes are not.
+       *
+       * @param e expression
+       * @return true if the expression should be hoisted
+       */
+      static bool is_hoistable(const expression& e);
+
+      int operator()(nil& e) const;
+      int operator()(int_literal& e) const;
+      int operator()(double_literal& e) const;
+      int operator()(array_expr& e) const;
+      int operator()(matrix_expr& e) const;
+      int operator()(row_vector_expr& e) const;
+      int operator()(variable& e) const;
+      int operator()(fun& e) const;
+      int operator()(integrate_1d& e) const;
+      int operator()(integrate_ode& e) const;
+      int operator()(integrate_ode_control& e) const;
+      int operator()(algebra_solver& e) const;
+      int operator()(algebra_solver_control& e) const;
+      int operator()(map_rect& e) const;
+      int operator()(index_op& e) const;
+      int operator()(index_op_sliced& e) const;
+      int operator()(conditional_op& e) const;
+      int operator()(binary_op& e) const;
+      int operator()(unary_op& e) const;
+
+      /**
+       * Names of data and transformed data variables.
+       */
+      const std::set<std::string>& data_vars_;
+
+      /**
+       * Sequence of hoisted expressions.
+       */
+      std::vector<hoisted_expr>& hoisted_;
+
+      /**
+       * Line of the statement being rewritten.
+       */
+      std::size_t begin_line_;
+
+      /**
+       * True if subexpressions may be hoisted.
+       */
+      bool hoist_;
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,196 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_DATA_EXPR_VIS_DEF_HPP
+#define STAN_LANG_AST_FUN_HOIST_DATA_EXPR_VIS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <boost/variant/get.hpp>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    hoist_data_expr_vis::hoist_data_expr_vis(
+                              const std::set<std::string>& data_vars,
+                              std::vector<hoisted_expr>& hoisted,
+                              std::size_t begin_line, bool hoist)
+      : data_vars_(data_vars), hoisted_(hoisted), begin_line_(begin_line),
+        hoist_(hoist) { }
+
+    int hoist_data_expr_vis::hoist_expr(expression& e) const {
+      hoist_data_expr_vis classify_vis(data_vars_, hoisted_, begin_line_,
+                                       false);
+      int k = boost::apply_visitor(classify_vis, e.expr_);
+      if (k == DATA && is_hoistable(e)) {
+        bare_expr_type type = e.bare_type();
+        type.set_is_data();
+        variable v("hoisted_"
+                   + boost::lexical_cast<std::string>(hoisted_.size())
+                   + "__");
+        v.set_type(type);
+        hoisted_.push_back(hoisted_expr(v, e, begin_line_));
+        e = expression(v);
+        return k;
+      }
+      boost::apply_visitor(*this, e.expr_);
+      return k;
+    }
+
+    int hoist_data_expr_vis::visit(expression& e, bool eager) const {
+      if (hoist_ && eager)
+        return hoist_expr(e);
+      hoist_data_expr_vis classify_vis(data_vars_, hoisted_, begin_line_,
+                                       false);
+      return boost::apply_visitor(classify_vis, e.expr_);
+    }
+
+    int hoist_data_expr_vis::visit_idx(idx& i) const {
+      if (uni_idx* x = boost::get<uni_idx>(&i.idx_))
+        return visit(x->idx_, true);
+      if (multi_idx* x = boost::get<multi_idx>(&i.idx_))
+        return visit(x->idxs_, true);
+      if (lb_idx* x = boost::get<lb_idx>(&i.idx_))
+        return visit(x->lb_, true);
+      if (ub_idx* x = boost::get<ub_idx>(&i.idx_))
+        return visit(x->ub_, true);
+      if (lub_idx* x = boost::get<lub_idx>(&i.idx_))
+        return combine(visit(x->lb_, true), visit(x->ub_, true));
+      return CONSTANT;
+    }
+
+    int hoist_data_expr_vis::combine(int k1, int k2) {
+      if (k1 == NOT_DATA || k2 == NOT_DATA)
+        return NOT_DATA;
+      return k1 > k2 ? k1 : k2;
+    }
+
+    bool hoist_data_expr_vis::is_hoistable(const expression& e) {
+      bare_expr_type type = e.bare_type();
+      if (type.innermost_type().is_int_type()
+          || type.innermost_type().is_ill_formed_type()
+          || type.innermost_type().is_void_type())
+        return false;
+      if (const index_op_sliced* x = boost::get<index_op_sliced>(&e.expr_)) {
+        for (size_t i = 0; i < x->idxs_.size(); ++i)
+          if (is_multi_index(x->idxs_[i]))
+            return true;
+        return false;
+      }
+      return boost::get<fun>(&e.expr_)
+        || boost::get<binary_op>(&e.expr_)
+        || boost::get<unary_op>(&e.expr_)
+        || boost::get<conditional_op>(&e.expr_)
+        || boost::get<array_expr>(&e.expr_)
+        || boost::get<matrix_expr>(&e.expr_)
+        || boost::get<row_vector_expr>(&e.expr_);
+    }
+
+    int hoist_data_expr_vis::operator()(nil& e) const {
+      return NOT_DATA;
+    }
+
+    int hoist_data_expr_vis::operator()(int_literal& e) const {
+      return CONSTANT;
+    }
+
+    int hoist_data_expr_vis::operator()(double_literal& e) const {
+      return CONSTANT;
+    }
+
+    int hoist_data_expr_vis::operator()(array_expr& e) const {
+      int k = CONSTANT;
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        k = combine(k, visit(e.args_[i], true));
+      return k;
+    }
+
+    int hoist_data_expr_vis::operator()(matrix_expr& e) const {
+      int k = CONSTANT;
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        k = combine(k, visit(e.args_[i], true));
+      return k;
+    }
+
+    int hoist_data_expr_vis::operator()(row_vector_expr& e) const {
+      int k = CONSTANT;
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        k = combine(k, visit(e.args_[i], true));
+      return k;
+    }
+
+    int hoist_data_expr_vis::operator()(variable& e) const {
+      return data_vars_.count(e.name_) ? DATA : NOT_DATA;
+    }
+
+    int hoist_data_expr_vis::operator()(fun& e) const {
+      // operands of short-circuiting operators may not be evaluated
+      bool eager = e.name_ != "logical_or" && e.name_ != "logical_and";
+      int k = CONSTANT;
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        k = combine(k, visit(e.args_[i], eager));
+      if (is_user_defined(e) || has_rng_suffix(e.name_)
+          || has_lp_suffix(e.name_) || e.name_ == "get_lp")
+        return NOT_DATA;
+      return k;
+    }
+
+    int hoist_data_expr_vis::operator()(integrate_1d& e) const {
+      return NOT_DATA;
+    }
+
+    int hoist_data_expr_vis::operator()(integrate_ode& e) const {
+      return NOT_DATA;
+    }
+
+    int hoist_data_expr_vis::operator()(integrate_ode_control& e) const {
+      return NOT_DATA;
+    }
+
+    int hoist_data_expr_vis::operator()(algebra_solver& e) const {
+      return NOT_DATA;
+    }
+
+    int hoist_data_expr_vis::operator()(algebra_solver_control& e) const {
+      return NOT_DATA;
+    }
+
+    int hoist_data_expr_vis::operator()(map_rect& e) const {
+      return NOT_DATA;
+    }
+
+    int hoist_data_expr_vis::operator()(index_op& e) const {
+      int k = visit(e.expr_, true);
+      for (size_t i = 0; i < e.dimss_.size(); ++i)
+        for (size_t j = 0; j < e.dimss_[i].size(); ++j)
+          k = combine(k, visit(e.dimss_[i][j], true));
+      return k;
+    }
+
+    int hoist_data_expr_vis::operator()(index_op_sliced& e) const {
+      int k = visit(e.expr_, true);
+      for (size_t i = 0; i < e.idxs_.size(); ++i)
+        k = combine(k, visit_idx(e.idxs_[i]));
+      return k;
+    }
+
+    int hoist_data_expr_vis::operator()(conditional_op& e) const {
+      // only one of the branches is evaluated
+      int k = visit(e.cond_, true);
+      k = combine(k, visit(e.true_val_, false));
+      return combine(k, visit(e.false_val_, false));
+    }
+
+    int hoist_data_expr_vis::operator()(binary_op& e) const {
+      return combine(visit(e.left, true), visit(e.right, true));
+    }
+
+    int hoist_data_expr_vis::operator()(unary_op& e) const {
+      return visit(e.subject, true);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,35 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_DATA_EXPRS_HPP
+#define STAN_LANG_AST_FUN_HOIST_DATA_EXPRS_HPP
+
+namespace stan {
+  namespace lang {
+
+    struct program;
+
+    /**
+     * Replace the maximal subexpressions of the statements and
+     * variable definitions in the transformed parameters and model
+     * blocks of the specified program that depend only on data and
+     * transformed data by member variables, recording the replaced
+     * expressions in the program's hoisted data so that they are
+     * computed once in the model constructor rather than on every
+     * evaluation of the log density.
+     *
+     * <p>Only expressions in statements that are executed every time
+     * their block is, that is, statements that are not nested in
+     * loops or conditionals and do not follow a statement that may
+     * end the evaluation early by rejecting or calling a user-defined
+     * function, are hoisted, so that the constructor does not
+     * evaluate, and possibly throw from, an expression the model
+     * might never evaluate.  Expressions calling user-defined
+     * functions, functions with side effects or functions depending
+     * on the log density are not hoisted, nor are integer-valued
+     * expressions, variables and literals.
+     *
+     * @param[in,out] prog program to rewrite
+     */
+    void hoist_data_exprs(program& prog);
+
+  }
+}
+#endif
@@ -0,0 +1,241 @@
+#ifndef STAN_LANG_AST_FUN_HOIST_DATA_EXPRS_DEF_HPP
+#define STAN_LANG_AST_FUN_HOIST_DATA_EXPRS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/get.hpp>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Return true if the specified expression calls a user-defined
+     * function, which may reject, directly or through a higher-order
+     * function.
+     *
+     * @param[in] e expression
+     * @return true if the expression calls a user-defined function
+     */
+    bool calls_user_defined(const expression& e) {
+      std::vector<const expression*> subexprs;
+      if (const array_expr* x = boost::get<array_expr>(&e.expr_)) {
+        for (size_t i = 0; i < x->args_.size(); ++i)
+          subexprs.push_back(&x->args_[i]);
+      } else if (const matrix_expr* x = boost::get<matrix_expr>(&e.expr_)) {
+        for (size_t i = 0; i < x->args_.size(); ++i)
+          subexprs.push_back(&x->args_[i]);
+      } else if (const row_vector_expr* x
+                 = boost::get<row_vector_expr>(&e.expr_)) {
+        for (size_t i = 0; i < x->args_.size(); ++i)
+          subexprs.push_back(&x->args_[i]);
+      } else if (const fun* x = boost::get<fun>(&e.expr_)) {
+        if (is_user_defined(*x))
+          return true;
+        for (size_t i = 0; i < x->args_.size(); ++i)
+          subexprs.push_back(&x->args_[i]);
+      } else if (boost::get<integrate_1d>(&e.expr_)
+                 || boost::get<integrate_ode>(&e.expr_)
+                 || boost::get<integrate_ode_control>(&e.expr_)
+                 || boost::get<algebra_solver>(&e.expr_)
+                 || boost::get<algebra_solver_control>(&e.expr_)
+                 || boost::get<map_rect>(&e.expr_)) {
+        return true;
+      } else if (const index_op* x = boost::get<index_op>(&e.expr_)) {
+        subexprs.push_back(&x->expr_);
+        for (size_t i = 0; i < x->dimss_.size(); ++i)
+          for (size_t j = 0; j < x->dimss_[i].size(); ++j)
+            subexprs.push_back(&x->dimss_[i][j]);
+      } else if (const index_op_sliced* x
+                 = boost::get<index_op_sliced>(&e.expr_)) {
+        subexprs.push_back(&x->expr_);
+        for (size_t i = 0; i < x->idxs_.size(); ++i) {
+          const idx& k = x->idxs_[i];
+          if (const uni_idx* y = boost::get<uni_idx>(&k.idx_)) {
+            subexprs.push_back(&y->idx_);
+          } else if (const multi_idx* y = boost::get<multi_idx>(&k.idx_)) {
+            subexprs.push_back(&y->idxs_);
+          } else if (const lb_idx* y = boost::get<lb_idx>(&k.idx_)) {
+            subexprs.push_back(&y->lb_);
+          } else if (const ub_idx* y = boost::get<ub_idx>(&k.idx_)) {
+            subexprs.push_back(&y->ub_);
+          } else if (const lub_idx* y = boost::get<lub_idx>(&k.idx_)) {
+            subexprs.push_back(&y->lb_);
+            subexprs.push_back(&y->ub_);
+          }
+        }
+      } else if (const conditional_op* x
+                 = boost::get<conditional_op>(&e.expr_)) {
+        subexprs.push_back(&x->cond_);
+        subexprs.push_back(&x->true_val_);
+        subexprs.push_back(&x->false_val_);
+      } else if (const binary_op* x = boost::get<binary_op>(&e.expr_)) {
+        subexprs.push_back(&x->left);
+        subexprs.push_back(&x->right);
+      } else if (const unary_op* x = boost::get<unary_op>(&e.expr_)) {
+        subexprs.push_back(&x->subject);
+      }
+      for (size_t i = 0; i < subexprs.size(); ++i)
+        if (calls_user_defined(*subexprs[i]))
+          return true;
+      return false;
+    }
+
+    /**
+     * Return true if executing the specified statement may end the
+     * evaluation of its block before the statements that follow it,
+     * because it contains a reject or return statement or calls a
+     * user-defined function.
+     *
+     * @param[in] s statement
+     * @return true if the statement may exit early
+     */
+    bool may_exit_early(const statement& s) {
+      if (boost::get<reject_statement>(&s.statement_)
+          || boost::get<return_statement>(&s.statement_))
+        return true;
+      if (const statements* x = boost::get<statements>(&s.statement_)) {
+        for (size_t i = 0; i < x->local_decl_.size(); ++i)
+          if (calls_user_defined(x->local_decl_[i].def_))
+            return true;
+        for (size_t i = 0; i < x->statements_.size(); ++i)
+          if (may_exit_early(x->statements_[i]))
+            return true;
+        return false;
+      }
+      if (const assgn* x = boost::get<assgn>(&s.statement_))
+        return calls_user_defined(x->rhs_);
+      if (const sample* x = boost::get<sample>(&s.statement_)) {
+        if (is_user_defined_prob_function(get_prob_fun(x->dist_.family_),
+                                          x->expr_, x->dist_.args_)
+            || calls_user_defined(x->expr_))
+          return true;
+        for (size_t i = 0; i < x->dist_.args_.size(); ++i)
+          if (calls_user_defined(x->dist_.args_[i]))
+            return true;
+        return false;
+      }
+      if (const increment_log_prob_statement* x
+          = boost::get<increment_log_prob_statement>(&s.statement_))
+        return calls_user_defined(x->log_prob_);
+      if (const expression* x = boost::get<expression>(&s.statement_))
+        return calls_user_defined(*x);
+      if (const for_statement* x = boost::get<for_statement>(&s.statement_))
+        return calls_user_defined(x->range_.low_)
+          || calls_user_defined(x->range_.high_)
+          || may_exit_early(x->statement_);
+      if (const for_array_statement* x
+          = boost::get<for_array_statement>(&s.statement_))
+        return calls_user_defined(x->expression_)
+          || may_exit_early(x->statement_);
+      if (const for_matrix_statement* x
+          = boost::get<for_matrix_statement>(&s.statement_))
+        return calls_user_defined(x->expression_)
+          || may_exit_early(x->statement_);
+      if (const while_statement* x
+          = boost::get<while_statement>(&s.statement_))
+        return calls_user_defined(x->condition_)
+          || may_exit_early(x->body_);
+      if (const conditional_statement* x
+          = boost::get<conditional_statement>(&s.statement_)) {
+        for (size_t i = 0; i < x->conditions_.size(); ++i)
+          if (calls_user_defined(x->conditions_[i]))
+            return true;
+        for (size_t i = 0; i < x->bodies_.size(); ++i)
+          if (may_exit_early(x->bodies_[i]))
+            return true;
+        return false;
+      }
+      return false;
+    }
+
+    /**
+     * Hoist the data-only subexpressions of the definition of the
+     * specified variable declaration, if it has one.
+     *
+     * @param[in,out] decl variable declaration
+     * @param[in] begin_line line of the declaration
+     * @param[in] data_vars names of data and transformed data variables
+     * @param[in,out] hoisted sequence of hoisted expressions
+     * @return false if the definition may exit early, so that no
+     * later expression may be hoisted
+     */
+    bool hoist_data_exprs(var_decl& decl, std::size_t begin_line,
+                          const std::set<std::string>& data_vars,
+                          std::vector<hoisted_expr>& hoisted) {
+      if (is_nil(decl.def_))
+        return true;
+      if (calls_user_defined(decl.def_))
+        return false;
+      hoist_data_expr_vis vis(data_vars, hoisted, begin_line, true);
+      vis.hoist_expr(decl.def_);
+      return true;
+    }
+
+    /**
+     * Hoist the data-only subexpressions of the specified statement
+     * and of the statements nested in it that are executed whenever
+     * it is, stopping at the first statement that may exit early.
+     *
+     * @param[in,out] s statement to rewrite
+     * @param[in] data_vars names of data and transformed data variables
+     * @param[in,out] hoisted sequence of hoisted expressions
+     * @return false if the statement may exit early, so that no later
+     * expression may be hoisted
+     */
+    bool hoist_data_exprs(statement& s, const std::set<std::string>& data_vars,
+                          std::vector<hoisted_expr>& hoisted) {
+      if (statements* x = boost::get<statements>(&s.statement_)) {
+        for (size_t i = 0; i < x->local_decl_.size(); ++i)
+          if (!hoist_data_exprs(x->local_decl_[i],
+                                x->local_decl_[i].begin_line_, data_vars,
+                                hoisted))
+            return false;
+        for (size_t i = 0; i < x->statements_.size(); ++i)
+          if (!hoist_data_exprs(x->statements_[i], data_vars, hoisted))
+            return false;
+        return true;
+      }
+      if (may_exit_early(s))
+        return false;
+      hoist_data_expr_vis vis(data_vars, hoisted, s.begin_line_, true);
+      if (assgn* x = boost::get<assgn>(&s.statement_)) {
+        vis.hoist_expr(x->rhs_);
+      } else if (sample* x = boost::get<sample>(&s.statement_)) {
+        vis.hoist_expr(x->expr_);
+        for (size_t i = 0; i < x->dist_.args_.size(); ++i)
+          vis.hoist_expr(x->dist_.args_[i]);
+      } else if (increment_log_prob_statement* x
+                 = boost::get<increment_log_prob_statement>(&s.statement_)) {
+        vis.hoist_expr(x->log_prob_);
+      } else if (expression* x = boost::get<expression>(&s.statement_)) {
+        vis.hoist_expr(*x);
+      }
+      return true;
+    }
+
+    void hoist_data_exprs(program& prog) {
+      std::set<std::string> data_vars;
+      for (size_t i = 0; i < prog.data_decl_.size(); ++i)
+        data_vars.insert(prog.data_decl_[i].name());
+      for (size_t i = 0; i < prog.derived_data_decl_.first.size(); ++i)
+        data_vars.insert(prog.derived_data_decl_.first[i].name());
+
+      // the transformed parameters run before the model block
+      for (size_t i = 0; i < prog.derived_decl_.first.size(); ++i)
+        if (!hoist_data_exprs(prog.derived_decl_.first[i],
+                              prog.derived_decl_.first[i].begin_line_,
+                              data_vars, prog.hoisted_data_))
+          return;
+      for (size_t i = 0; i < prog.derived_decl_.second.size(); ++i)
+        if (!hoist_data_exprs(prog.derived_decl_.second[i], data_vars,
+                              prog.hoisted_data_))
+          return;
+      hoist_data_exprs(prog.statement_, data_vars, prog.hoisted_data_);
+    }
+
+  }
+}
+#endif
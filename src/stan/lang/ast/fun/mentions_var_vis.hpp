@@ -0,0 +1,294 @@
+#ifndef STAN_LANG_AST_FUN_MENTIONS_VAR_VIS_HPP
+#define STAN_LANG_AST_FUN_MENTIONS_VAR_VIS_HPP
+
+#include <boost/variant/static_visitor.hpp>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    struct nil;
+    struct int_literal;
+    struct double_literal;
+    struct array_expr;
+    struct matrix_expr;
+    struct row_vector_expr;
+    struct variable;
+    struct fun;
+    struct integrate_1d;
+    struct integrate_ode;
+    struct integrate_ode_control;
+    struct algebra_solver;
+    struct algebra_solver_control;
+    struct map_rect;
+    struct index_op;
+    struct index_op_sliced;
+    struct conditional_op;
+    struct binary_op;
+    struct unary_op;
+    struct uni_idx;
+    struct multi_idx;
+    struct omni_idx;
+    struct lb_idx;
+    struct ub_idx;
+    struct lub_idx;
+
+    /**
+     * Visitor to detect whether a variable is mentioned anywhere in an
+     * expression or index, including in the indexes of indexed
+     * expressions.  Unlike <code>var_occurs_vis</code>, which tracks
+     * references that persist out of an expression, this visitor
+     * reports any use of the name.  Expressions with function
+     * arguments, such as ODE integrators, are conservatively reported
+     * as mentioning the variable.
+     */
+    struct mentions_var_vis : public boost::static_visitor<bool> {
+      /**
+       * Construct a visitor to detect whether the variable with the
+       * specified name is mentioned.
+       *
+       * @param name name of variable to detect
+       */
+      explicit mentions_var_vis(const std::string& name);
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return false
+       */
+      bool operator()(const nil& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return false
+       */
+      bool operator()(const int_literal& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return false
+       */
+      bool operator()(const double_literal& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true if the variable is mentioned in any of the
+       * elements
+       */
+      bool operator()(const array_expr& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true if the variable is mentioned in any of the
+       * elements
+       */
+      bool operator()(const matrix_expr& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true if the variable is mentioned in any of the
+       * elements
+       */
+      bool operator()(const row_vector_expr& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true if the variable has the specified name
+       */
+      bool operator()(const variable& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true if the variable is mentioned in any of the
+       * arguments
+       */
+      bool operator()(const fun& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true
+       */
+      bool operator()(const integrate_1d& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true
+       */
+      bool operator()(const integrate_ode& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true
+       */
+      bool operator()(const integrate_ode_control& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true
+       */
+      bool operator()(const algebra_solver& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true
+       */
+      bool operator()(const algebra_solver_control& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true
+       */
+      bool operator()(const map_rect& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true if the variable is mentioned in the indexed
+       * expression or in any of the indexes
+       */
+      bool operator()(const index_op& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true if the variable is mentioned in the indexed
+       * expression or in any of the indexes
+       */
+      bool operator()(const index_op_sliced& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true if the variable is mentioned in the condition
+       * or either result
+       */
+      bool operator()(const conditional_op& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true if the variable is mentioned in either operand
+       */
+      bool operator()(const binary_op& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * expression.
+       *
+       * @param[in] e expression
+       * @return true if the variable is mentioned in the operand
+       */
+      bool operator()(const unary_op& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * index.
+       *
+       * @param[in] e index
+       * @return true if the variable is mentioned in the index
+       */
+      bool operator()(const uni_idx& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * index.
+       *
+       * @param[in] e index
+       * @return true if the variable is mentioned in the indexes
+       */
+      bool operator()(const multi_idx& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * index.
+       *
+       * @param[in] e index
+       * @return false
+       */
+      bool operator()(const omni_idx& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * index.
+       *
+       * @param[in] e index
+       * @return true if the variable is mentioned in the lower bound
+       */
+      bool operator()(const lb_idx& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * index.
+       *
+       * @param[in] e index
+       * @return true if the variable is mentioned in the upper bound
+       */
+      bool operator()(const ub_idx& e) const;
+
+      /**
+       * Return true if the variable is mentioned in the specified
+       * index.
+       *
+       * @param[in] e index
+       * @return true if the variable is mentioned in either bound
+       */
+      bool operator()(const lub_idx& e) const;
+
+      /**
+       * The name of the variable for which to search.
+       */
+      const std::string name_;
+    };
+
+  }
+}
+#endif
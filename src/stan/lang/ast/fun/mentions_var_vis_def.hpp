@@ -0,0 +1,144 @@
+#ifndef STAN_LANG_AST_FUN_MENTIONS_VAR_VIS_DEF_HPP
+#define STAN_LANG_AST_FUN_MENTIONS_VAR_VIS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    mentions_var_vis::mentions_var_vis(const std::string& name)
+      : name_(name) {
+    }
+
+    bool mentions_var_vis::operator()(const nil& e) const {
+      return false;
+    }
+
+    bool mentions_var_vis::operator()(const int_literal& e) const {
+      return false;
+    }
+
+    bool mentions_var_vis::operator()(const double_literal& e) const {
+      return false;
+    }
+
+    bool mentions_var_vis::operator()(const array_expr& e) const {
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        if (boost::apply_visitor(*this, e.args_[i].expr_))
+          return true;
+      return false;
+    }
+
+    bool mentions_var_vis::operator()(const matrix_expr& e) const {
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        if (boost::apply_visitor(*this, e.args_[i].expr_))
+          return true;
+      return false;
+    }
+
+    bool mentions_var_vis::operator()(const row_vector_expr& e) const {
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        if (boost::apply_visitor(*this, e.args_[i].expr_))
+          return true;
+      return false;
+    }
+
+    bool mentions_var_vis::operator()(const variable& e) const {
+      return name_ == e.name_;
+    }
+
+    bool mentions_var_vis::operator()(const fun& e) const {
+      for (size_t i = 0; i < e.args_.size(); ++i)
+        if (boost::apply_visitor(*this, e.args_[i].expr_))
+          return true;
+      return false;
+    }
+
+    bool mentions_var_vis::operator()(const integrate_1d& e) const {
+      return true;
+    }
+
+    bool mentions_var_vis::operator()(const integrate_ode& e) const {
+      return true;
+    }
+
+    bool mentions_var_vis::operator()(const integrate_ode_control& e) const {
+      return true;
+    }
+
+    bool mentions_var_vis::operator()(const algebra_solver& e) const {
+      return true;
+    }
+
+    bool mentions_var_vis::operator()(const algebra_solver_control& e) const {
+      return true;
+    }
+
+    bool mentions_var_vis::operator()(const map_rect& e) const {
+      return true;
+    }
+
+    bool mentions_var_vis::operator()(const index_op& e) const {
+      if (boost::apply_visitor(*this, e.expr_.expr_))
+        return true;
+      for (size_t i = 0; i < e.dimss_.size(); ++i)
+        for (size_t j = 0; j < e.dimss_[i].size(); ++j)
+          if (boost::apply_visitor(*this, e.dimss_[i][j].expr_))
+            return true;
+      return false;
+    }
+
+    bool mentions_var_vis::operator()(const index_op_sliced& e) const {
+      if (boost::apply_visitor(*this, e.expr_.expr_))
+        return true;
+      for (size_t i = 0; i < e.idxs_.size(); ++i)
+        if (boost::apply_visitor(*this, e.idxs_[i].idx_))
+          return true;
+      return false;
+    }
+
+    bool mentions_var_vis::operator()(const conditional_op& e) const {
+      return boost::apply_visitor(*this, e.cond_.expr_)
+        || boost::apply_visitor(*this, e.true_val_.expr_)
+        || boost::apply_visitor(*this, e.false_val_.expr_);
+    }
+
+    bool mentions_var_vis::operator()(const binary_op& e) const {
+      return boost::apply_visitor(*this, e.left.expr_)
+        || boost::apply_visitor(*this, e.right.expr_);
+    }
+
+    bool mentions_var_vis::operator()(const unary_op& e) const {
+      return boost::apply_visitor(*this, e.subject.expr_);
+    }
+
+    bool mentions_var_vis::operator()(const uni_idx& e) const {
+      return boost::apply_visitor(*this, e.idx_.expr_);
+    }
+
+    bool mentions_var_vis::operator()(const multi_idx& e) const {
+      return boost::apply_visitor(*this, e.idxs_.expr_);
+    }
+
+    bool mentions_var_vis::operator()(const omni_idx& e) const {
+      return false;
+    }
+
+    bool mentions_var_vis::operator()(const lb_idx& e) const {
+      return boost::apply_visitor(*this, e.lb_.expr_);
+    }
+
+    bool mentions_var_vis::operator()(const ub_idx& e) const {
+      return boost::apply_visitor(*this, e.ub_.expr_);
+    }
+
+    bool mentions_var_vis::operator()(const lub_idx& e) const {
+      return boost::apply_visitor(*this, e.lb_.expr_)
+        || boost::apply_visitor(*this, e.ub_.expr_);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,39 @@
+#ifndef STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOPS_HPP
+#define STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOPS_HPP
+
+namespace stan {
+  namespace lang {
+
+    struct statement;
+
+    /**
+     * Rewrite the loops in the specified statement, and in the
+     * statements nested in it, that can be replaced by a single
+     * vectorized call to a built-in probability function.
+     *
+     * <p>A loop <code>for (n in L:U)</code> is rewritten if its body
+     * is a single untruncated sampling statement, or a single
+     * increment of the log density by a built-in probability
+     * function, and each argument either does not mention
+     * <code>n</code> and is univariate, or is a univariate element
+     * <code>x[n]</code> of an expression <code>x</code> that does not
+     * mention <code>n</code>.  At least one argument must be of the
+     * second kind.  Each such argument becomes the slice
+     * <code>x[L:U]</code>, so that
+     *
+     * <pre>
+     * for (n in 1:N) y[n] ~ normal(mu[n], sigma);</pre>
+     *
+     * becomes <code>y[1:N] ~ normal(mu[1:N], sigma);</code>.  The
+     * rewrite is only made if the function has a built-in signature
+     * for the sliced argument types returning <code>real</code>.
+     * Built-in probability functions sum over their vectorized
+     * arguments, so the log density is unchanged.
+     *
+     * @param[in,out] s statement to rewrite
+     */
+    void vectorize_sampling_loops(statement& s);
+
+  }
+}
+#endif
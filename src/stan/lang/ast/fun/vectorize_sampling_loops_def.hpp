@@ -0,0 +1,205 @@
+#ifndef STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOPS_DEF_HPP
+#define STAN_LANG_AST_FUN_VECTORIZE_SAMPLING_LOOPS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <boost/variant/get.hpp>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Return true if the specified expression type is int or real.
+     *
+     * @param t expression type
+     * @return true if the type is univariate
+     */
+    bool is_univariate_type(const bare_expr_type& t) {
+      return t.num_dims() == 0 && (t.is_int_type() || t.is_double_type());
+    }
+
+    /**
+     * Return the argument of a vectorized call that replaces the
+     * specified argument of a call in the body of a loop, or nil if
+     * the argument cannot be vectorized.  See
+     * <code>vectorize_sampling_loops</code> for the rules.
+     *
+     * @param[in] arg argument in the body of the loop
+     * @param[in] loop loop
+     * @param[out] sliced set to true if the argument is sliced
+     * @return vectorized argument
+     */
+    expression vectorize_loop_arg(const expression& arg,
+                                  const for_statement& loop,
+                                  bool& sliced) {
+      if (!is_univariate_type(arg.bare_type()))
+        return expression(nil());
+      mentions_var_vis vis(loop.variable_);
+      if (!boost::apply_visitor(vis, arg.expr_))
+        return arg;
+
+      const expression* indexed = 0;
+      const expression* index = 0;
+      if (const index_op* op = boost::get<index_op>(&arg.expr_)) {
+        if (op->dimss_.size() == 1 && op->dimss_[0].size() == 1) {
+          indexed = &op->expr_;
+          index = &op->dimss_[0][0];
+        }
+      } else if (const index_op_sliced* op
+                 = boost::get<index_op_sliced>(&arg.expr_)) {
+        if (op->idxs_.size() == 1) {
+          if (const uni_idx* i = boost::get<uni_idx>(&op->idxs_[0].idx_)) {
+            indexed = &op->expr_;
+            index = &i->idx_;
+          }
+        }
+      }
+      if (indexed == 0)
+        return expression(nil());
+      const variable* v = boost::get<variable>(&index->expr_);
+      if (v == 0 || v->name_ != loop.variable_
+          || boost::apply_visitor(vis, indexed->expr_))
+        return expression(nil());
+
+      std::vector<idx> idxs;
+      idxs.push_back(lub_idx(loop.range_.low_, loop.range_.high_));
+      sliced = true;
+      return index_op_sliced(*indexed, idxs);
+    }
+
+    /**
+     * Set the vectorized arguments for the specified arguments of a
+     * call in the body of a loop and return true if all of them can be
+     * vectorized and at least one is sliced.
+     *
+     * @param[in] args arguments in the body of the loop
+     * @param[in] loop loop
+     * @param[out] vectorized_args vectorized arguments
+     * @return true if the call can be vectorized
+     */
+    bool vectorize_loop_args(const std::vector<expression>& args,
+                             const for_statement& loop,
+                             std::vector<expression>& vectorized_args) {
+      bool sliced = false;
+      vectorized_args.clear();
+      for (size_t i = 0; i < args.size(); ++i) {
+        vectorized_args.push_back(vectorize_loop_arg(args[i], loop, sliced));
+        if (is_nil(vectorized_args.back()))
+          return false;
+      }
+      return sliced;
+    }
+
+    /**
+     * Return true if the specified probability function has a
+     * built-in signature returning real for the specified arguments.
+     *
+     * @param[in] name name of probability function
+     * @param[in] args arguments
+     * @return true if the vectorized call is a built-in density
+     */
+    bool is_builtin_vectorized_prob_fun(const std::string& name,
+                                        const std::vector<expression>& args) {
+      if (!(ends_with("_lpdf", name) || ends_with("_lpmf", name)
+            || ends_with("_log", name))
+          || name.find("cdf") != std::string::npos
+          || name == "multiply_log"
+          || name == "binomial_coefficient_log")
+        return false;
+      std::vector<bare_expr_type> arg_types;
+      for (size_t i = 0; i < args.size(); ++i)
+        arg_types.push_back(args[i].bare_type());
+      function_signature_t sig;
+      if (function_signatures::instance().get_signature_matches(
+              name, arg_types, sig) != 1)
+        return false;
+      if (!sig.first.is_double_type())
+        return false;
+      std::pair<std::string, function_signature_t> name_sig(name, sig);
+      return !function_signatures::instance().is_user_defined(name_sig);
+    }
+
+    /**
+     * Return true and set the replacement if the specified loop can
+     * be replaced by a single vectorized statement.
+     *
+     * @param[in] loop loop
+     * @param[out] result vectorized statement
+     * @return true if the loop is vectorized
+     */
+    bool vectorize_sampling_loop(const for_statement& loop,
+                                 statement& result) {
+      const statement* body = &loop.statement_;
+      if (const statements* block = boost::get<statements>(&body->statement_)) {
+        if (block->local_decl_.size() != 0 || block->statements_.size() != 1)
+          return false;
+        body = &block->statements_[0];
+      }
+
+      std::vector<expression> args;
+      if (const sample* s = boost::get<sample>(&body->statement_)) {
+        if (s->truncation_.has_low() || s->truncation_.has_high())
+          return false;
+        args.push_back(s->expr_);
+        args.insert(args.end(), s->dist_.args_.begin(), s->dist_.args_.end());
+        std::vector<expression> vectorized_args;
+        if (!vectorize_loop_args(args, loop, vectorized_args)
+            || !is_builtin_vectorized_prob_fun(get_prob_fun(s->dist_.family_),
+                                               vectorized_args))
+          return false;
+        sample vectorized(*s);
+        vectorized.expr_ = vectorized_args[0];
+        vectorized.dist_.args_.assign(vectorized_args.begin() + 1,
+                                      vectorized_args.end());
+        result = statement(vectorized);
+      } else if (const increment_log_prob_statement* s
+                 = boost::get<increment_log_prob_statement>(&body->statement_)) {
+        const fun* f = boost::get<fun>(&s->log_prob_.expr_);
+        if (f == 0)
+          return false;
+        std::vector<expression> vectorized_args;
+        if (!vectorize_loop_args(f->args_, loop, vectorized_args)
+            || !is_builtin_vectorized_prob_fun(f->name_, vectorized_args))
+          return false;
+        fun vectorized(*f);
+        vectorized.args_ = vectorized_args;
+        result = statement(increment_log_prob_statement(vectorized));
+      } else {
+        return false;
+      }
+      result.begin_line_ = body->begin_line_;
+      result.end_line_ = body->end_line_;
+      return true;
+    }
+
+    void vectorize_sampling_loops(statement& s) {
+      if (statements* x = boost::get<statements>(&s.statement_)) {
+        for (size_t i = 0; i < x->statements_.size(); ++i)
+          vectorize_sampling_loops(x->statements_[i]);
+      } else if (for_statement* x = boost::get<for_statement>(&s.statement_)) {
+        vectorize_sampling_loops(x->statement_);
+        statement vectorized;
+        if (vectorize_sampling_loop(*x, vectorized))
+          s = vectorized;
+      } else if (for_array_statement* x
+                 = boost::get<for_array_statement>(&s.statement_)) {
+        vectorize_sampling_loops(x->statement_);
+      } else if (for_matrix_statement* x
+                 = boost::get<for_matrix_statement>(&s.statement_)) {
+        vectorize_sampling_loops(x->statement_);
+      } else if (conditional_statement* x
+                 = boost::get<conditional_statement>(&s.statement_)) {
+        for (size_t i = 0; i < x->bodies_.size(); ++i)
+          vectorize_sampling_loops(x->bodies_[i]);
+      } else if (while_statement* x
+                 = boost::get<while_statement>(&s.statement_)) {
+        vectorize_sampling_loops(x->body_);
+      }
+    }
+
+  }
+}
+#endif
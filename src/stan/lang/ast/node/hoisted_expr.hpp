@@ -0,0 +1,52 @@
+#ifndef STAN_LANG_AST_NODE_HOISTED_EXPR_HPP
+#define STAN_LANG_AST_NODE_HOISTED_EXPR_HPP
+
+#include <stan/lang/ast/node/expression.hpp>
+#include <stan/lang/ast/node/variable.hpp>
+#include <cstddef>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * AST node for a data-only expression that is evaluated once in
+     * the model constructor and stored in a member variable rather
+     * than being evaluated each time the log density is evaluated.
+     */
+    struct hoisted_expr {
+      /**
+       * Construct a hoisted expression with a nil expression.
+       */
+      hoisted_expr();
+
+      /**
+       * Construct a hoisted expression storing the value of the
+       * specified expression in the specified variable.
+       *
+       * @param var member variable holding the value
+       * @param expr data-only expression
+       * @param begin_line line of the statement the expression was
+       * hoisted from
+       */
+      hoisted_expr(const variable& var, const expression& expr,
+                   std::size_t begin_line);
+
+      /**
+       * Member variable holding the value of the expression.
+       */
+      variable var_;
+
+      /**
+       * Data-only expression.
+       */
+      expression expr_;
+
+      /**
+       * Line of the statement the expression was hoisted from.
+       */
+      std::size_t begin_line_;
+    };
+
+  }
+}
+#endif
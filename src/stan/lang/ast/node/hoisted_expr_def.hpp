@@ -0,0 +1,18 @@
+#ifndef STAN_LANG_AST_NODE_HOISTED_EXPR_DEF_HPP
+#define STAN_LANG_AST_NODE_HOISTED_EXPR_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <cstddef>
+
+namespace stan {
+  namespace lang {
+
+    hoisted_expr::hoisted_expr() : begin_line_(0) { }
+
+    hoisted_expr::hoisted_expr(const variable& var, const expression& expr,
+                               std::size_t begin_line)
+      : var_(var), expr_(expr), begin_line_(begin_line) { }
+
+  }
+}
+#endif
@@ -4,6 +4,7 @@
 #include <stan/lang/ast/node/function_decl_def.hpp>
 #include <stan/lang/ast/node/statement.hpp>
 #include <stan/lang/ast/node/block_var_decl.hpp>
+#include <stan/lang/ast/node/hoisted_expr.hpp>
 #include <utility>
 #include <vector>
 
@@ -96,6 +97,14 @@ namespace stan {
        */
       std::pair<std::vector<block_var_decl>,
                 std::vector<statement> > generated_decl_;
+
+      /**
+       * Data-only expressions hoisted out of the transformed
+       * parameters and model blocks, to be evaluated once in the
+       * model constructor.  Not parsed; filled in by
+       * <code>hoist_data_exprs</code>.
+       */
+      std::vector<hoisted_expr> hoisted_data_;
     };
 
   }
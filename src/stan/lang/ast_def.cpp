@@ -60,6 +60,7 @@
 #include <stan/lang/ast/fun/write_expression_vis_def.hpp>
 #include <stan/lang/ast/fun/write_idx_vis_def.hpp>
 
+#include <stan/lang/ast/fun/eliminate_common_subexprs_def.hpp>
 #include <stan/lang/ast/fun/ends_with_def.hpp>
 #include <stan/lang/ast/fun/fun_name_exists_def.hpp>
 #include <stan/lang/ast/fun/get_ccdf_def.hpp>
@@ -74,6 +75,8 @@
 #include <stan/lang/ast/fun/has_rng_suffix_def.hpp>
 #include <stan/lang/ast/fun/has_var_def.hpp>
 #include <stan/lang/ast/fun/has_var_vis_def.hpp>
+#include <stan/lang/ast/fun/hoist_data_expr_vis_def.hpp>
+#include <stan/lang/ast/fun/hoist_data_exprs_def.hpp>
 #include <stan/lang/ast/fun/indexed_type_def.hpp>
 #include <stan/lang/ast/fun/infer_type_indexing_def.hpp>
 #include <stan/lang/ast/fun/is_assignable_def.hpp>
@@ -84,6 +87,7 @@
 #include <stan/lang/ast/fun/is_space_def.hpp>
 #include <stan/lang/ast/fun/is_user_defined_def.hpp>
 #include <stan/lang/ast/fun/is_user_defined_prob_function_def.hpp>
+#include <stan/lang/ast/fun/mentions_var_vis_def.hpp>
 #include <stan/lang/ast/fun/num_index_op_dims_def.hpp>
 #include <stan/lang/ast/fun/print_scope_def.hpp>
 #include <stan/lang/ast/fun/promote_primitive_def.hpp>
@@ -93,6 +97,7 @@
 #include <stan/lang/ast/fun/strip_cdf_suffix_def.hpp>
 #include <stan/lang/ast/fun/strip_prob_fun_suffix_def.hpp>
 #include <stan/lang/ast/fun/var_occurs_vis_def.hpp>
+#include <stan/lang/ast/fun/vectorize_sampling_loops_def.hpp>
 
 #include <stan/lang/ast/sigs/function_signatures_def.hpp>
 
@@ -117,6 +122,7 @@
 #include <stan/lang/ast/node/fun_def.hpp>
 #include <stan/lang/ast/node/function_decl_def_def.hpp>
 #include <stan/lang/ast/node/function_decl_defs_def.hpp>
+#include <stan/lang/ast/node/hoisted_expr_def.hpp>
 #include <stan/lang/ast/node/idx_def.hpp>
 #include <stan/lang/ast/node/increment_log_prob_statement_def.hpp>
 #include <stan/lang/ast/node/index_op_def.hpp>
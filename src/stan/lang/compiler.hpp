@@ -20,6 +20,16 @@ namespace stan {
      * true and searching the specified include path for included
      * files.
      *
+     * <p>Loops in the model block whose body is a single sampling
+     * statement are vectorized before code is generated; see
+     * <code>vectorize_sampling_loops</code>.  Then subexpressions of
+     * the transformed parameters and model blocks that depend only on
+     * data are moved to the model constructor; see
+     * <code>hoist_data_exprs</code>.  Finally, real-valued
+     * subexpressions repeated within a block of those blocks are
+     * computed once into local temporaries; see
+     * <code>eliminate_common_subexprs</code>.
+     *
      * @param msgs Output stream for warning messages
      * @param in Stan model specification
      * @param out C++ code output stream
@@ -45,6 +55,9 @@ namespace stan {
                                    allow_undefined);
       if (!parse_succeeded)
         return false;
+      vectorize_sampling_loops(prog.statement_);
+      hoist_data_exprs(prog);
+      eliminate_common_subexprs(prog);
       generate_cpp(prog, name, reader.history(), out);
       return true;
     }
@@ -55,6 +55,8 @@
 #include <stan/lang/generator/generate_functions.hpp>
 #include <stan/lang/generator/generate_functor_arguments.hpp>
 #include <stan/lang/generator/generate_globals.hpp>
+#include <stan/lang/generator/generate_hoisted_exprs.hpp>
+#include <stan/lang/generator/generate_hoisted_var_decls.hpp>
 #include <stan/lang/generator/generate_idx.hpp>
 #include <stan/lang/generator/generate_idxs.hpp>
 #include <stan/lang/generator/generate_idxs_user.hpp>
@@ -8,6 +8,7 @@
 #include <stan/lang/generator/generate_data_var_init.hpp>
 #include <stan/lang/generator/generate_catch_throw_located.hpp>
 #include <stan/lang/generator/generate_comment.hpp>
+#include <stan/lang/generator/generate_hoisted_exprs.hpp>
 #include <stan/lang/generator/generate_set_param_ranges.hpp>
 #include <stan/lang/generator/generate_statements.hpp>
 #include <stan/lang/generator/generate_try.hpp>
@@ -131,6 +132,13 @@ namespace stan {
       }
       o << EOL;
 
+      if (prog.hoisted_data_.size() > 0) {
+        generate_comment("compute data-only expressions used in log_prob",
+                         3, o);
+        generate_hoisted_exprs(prog.hoisted_data_, 3, o);
+        o << EOL;
+      }
+
       generate_comment("validate, set parameter ranges", 3, o);
       generate_set_param_ranges(prog.parameter_decl_, 3, o);
       generate_catch_throw_located(2, o);
@@ -18,7 +18,8 @@ namespace stan {
 
     /**
      * Generate initializations for data block variables by reading
-     * dump format data from constructor variable context.
+     * dump format data from constructor variable context, without
+     * copying values the context stores.
      * In dump format data, arrays are indexed in last-index major fashion,
      * which corresponds to column-major order for matrices
      * represented as two-dimensional arrays.  As a result, the first
@@ -37,12 +38,19 @@ namespace stan {
       block_var_type el_type = var_decl.type().innermost_type();
 
       std::string vals("vals_r");
-      if (vtype.bare_type().innermost_type().is_int_type())
+      std::string vals_type("double");
+      if (vtype.bare_type().innermost_type().is_int_type()) {
         vals = "vals_i";
+        vals_type = "int";
+      }
+      // refer to the values held by the context, copying them into
+      // the buffer vals_r__ or vals_i__ only if the context must
+      std::string var_vals(var_name + "_vals__");
 
       generate_indent(indent, o);
-      o << vals << "__ = context__." << vals
-        << "(\"" << var_name << "\");" << EOL;
+      o << "const std::vector<" << vals_type << ">& " << var_vals
+        << " = context__." << vals << "_ref(\"" << var_name << "\", "
+        << vals << "__);" << EOL;
       generate_indent(indent, o);
       o << "pos__ = 0;" << EOL;
 
@@ -53,7 +61,7 @@ namespace stan {
       o << var_name;
       write_var_idx_all_dims(vtype.array_dims(),
                              vtype.num_dims() - vtype.array_dims(), o);
-      o << " = " << vals << "__[pos__++];" << EOL;
+      o << " = " << var_vals << "[pos__++];" << EOL;
 
       write_end_loop(vtype.num_dims(), indent, o);
     }
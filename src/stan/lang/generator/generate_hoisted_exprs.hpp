@@ -0,0 +1,41 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_HOISTED_EXPRS_HPP
+#define STAN_LANG_GENERATOR_GENERATE_HOISTED_EXPRS_HPP
+
+#include <stan/lang/ast.hpp>
+#include <stan/lang/generator/constants.hpp>
+#include <stan/lang/generator/generate_expression.hpp>
+#include <stan/lang/generator/generate_indent.hpp>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Generate the assignments of the values of the specified
+     * hoisted data-only expressions to their member variables at the
+     * specified indentation level to the specified stream.  The
+     * member variables are default constructed, so they are assigned
+     * directly rather than through <code>stan::math::assign</code>,
+     * which requires matching sizes.
+     *
+     * @param[in] hs hoisted expressions
+     * @param[in] indent indentation level
+     * @param[in,out] o stream for generating
+     */
+    void generate_hoisted_exprs(const std::vector<hoisted_expr>& hs,
+                                int indent, std::ostream& o) {
+      for (size_t i = 0; i < hs.size(); ++i) {
+        generate_indent(indent, o);
+        o << "current_statement_begin__ = " << hs[i].begin_line_ << ";"
+          << EOL;
+        generate_indent(indent, o);
+        o << hs[i].var_.name_ << " = ";
+        generate_expression(hs[i].expr_, NOT_USER_FACING, o);
+        o << ";" << EOL;
+      }
+    }
+
+  }
+}
+#endif
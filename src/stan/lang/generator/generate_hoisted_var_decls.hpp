@@ -0,0 +1,44 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_HOISTED_VAR_DECLS_HPP
+#define STAN_LANG_GENERATOR_GENERATE_HOISTED_VAR_DECLS_HPP
+
+#include <stan/lang/ast.hpp>
+#include <stan/lang/generator/constants.hpp>
+#include <stan/lang/generator/generate_indent.hpp>
+#include <stan/lang/generator/get_typedef_var_type.hpp>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Generate model class member variable declarations for the
+     * variables holding the values of hoisted data-only expressions
+     * at the specified indentation level to the specified stream.
+     *
+     * @param[in] hs hoisted expressions
+     * @param[in] indent indentation level
+     * @param[in] o stream for writing
+     */
+    void generate_hoisted_var_decls(const std::vector<hoisted_expr>& hs,
+                                    int indent, std::ostream& o) {
+      for (size_t i = 0; i < hs.size(); ++i) {
+        generate_indent(indent, o);
+        std::string typedef_var_type
+          = get_typedef_var_type(hs[i].var_.type_);
+        int ar_dims = hs[i].var_.type_.array_dims();
+        for (int d = 0; d < ar_dims; ++d)
+          o << "std::vector<";
+        o << typedef_var_type;
+        if (ar_dims > 0)
+          o << ">";
+        for (int d = 1; d < ar_dims; ++d)
+          o << " >";
+        o << " " << hs[i].var_.name_ << ";" << EOL;
+      }
+    }
+
+  }
+}
+#endif
@@ -20,7 +20,10 @@ namespace stan {
 
     /**
      * Generate the log_prob method for the model class for the
-     * specified program on the specified stream.
+     * specified program on the specified stream.  The type of the
+     * log density accumulator depends on the scalar type, so that
+     * evaluations with <code>double</code> scalars sum terms as they
+     * go rather than buffering them for autodiff.
      *
      * @param prog program node of ast
      * @param o stream for generating
@@ -45,7 +48,8 @@ namespace stan {
 
       o << INDENT2 << "T__ lp__(0.0);"
         << EOL;
-      o << INDENT2 << "stan::math::accumulator<T__> lp_accum__;"
+      o << INDENT2
+        << "typename stan::model::log_prob_accumulator<T__>::type lp_accum__;"
         << EOL;
 
       bool gen_local_vars = true;
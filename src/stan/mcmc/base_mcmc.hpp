@@ -4,6 +4,7 @@
 #include <stan/callbacks/logger.hpp>
 #include <stan/callbacks/writer.hpp>
 #include <stan/mcmc/sample.hpp>
+#include <stan/mcmc/sampler_counters.hpp>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -32,6 +33,14 @@ namespace stan {
                                    std::vector<std::string>& names) {}
 
       virtual void get_sampler_diagnostics(std::vector<double>& values) {}
+
+      /**
+       * Writes the counts of the work done by the sampler since it was
+       * constructed.
+       *
+       * @param[out] counters counts of work
+       */
+      virtual void get_sampler_counters(sampler_counters& counters) {}
     };
 
   }  // mcmc
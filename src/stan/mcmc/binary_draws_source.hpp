@@ -0,0 +1,70 @@
+#ifndef STAN_MCMC_BINARY_DRAWS_SOURCE_HPP
+#define STAN_MCMC_BINARY_DRAWS_SOURCE_HPP
+
+#include <stan/io/binary_draws_reader.hpp>
+#include <stan/mcmc/draws_source.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * A <code>draws_source</code> reading a file written by
+     * <code>callbacks::binary_draws_writer</code>.
+     *
+     * Each read seeks past the columns that are not requested (see
+     * <code>binary_draws_reader::parse</code>). The binary draws
+     * format has no metadata, so <code>num_warmup()</code> is zero.
+     */
+    class binary_draws_source : public draws_source {
+    public:
+      /**
+       * Construct a source for the specified file, reading its header
+       * and counting its draws.
+       *
+       * @param filename name of binary draws file
+       * @throw std::invalid_argument if the file cannot be read, is not
+       *   in the binary draws format or has no column names
+       */
+      explicit binary_draws_source(const std::string& filename)
+        : filename_(filename) {
+        std::ifstream in(filename.c_str(), std::ios::binary);
+        if (!in)
+          throw std::invalid_argument("binary_draws_source: cannot open"
+                                      " file " + filename);
+        Eigen::Matrix<std::string, Eigen::Dynamic, 1> header;
+        if (!io::binary_draws_reader::read_header(in, header)
+            || header.size() == 0)
+          throw std::invalid_argument("binary_draws_source: no column"
+                                      " names in file " + filename);
+        in.seekg(0);
+
+        // the number of draws is found by reading the first column
+        io::stan_csv first = io::binary_draws_reader::parse(
+            in, 0, std::vector<std::string>(1, header(0)));
+        init(header, first.samples.rows(), 0);
+      }
+
+    protected:
+      void read(const std::vector<int>& indexes,
+                Eigen::MatrixXd& draws) const {
+        std::vector<std::string> names(indexes.size());
+        for (size_t n = 0; n < indexes.size(); ++n)
+          names[n] = header()(indexes[n]);
+        std::ifstream in(filename_.c_str(), std::ios::binary);
+        io::stan_csv data = io::binary_draws_reader::parse(in, 0, names);
+        draws.swap(data.samples);
+      }
+
+    private:
+      std::string filename_;
+    };
+
+  }
+}
+
+#endif
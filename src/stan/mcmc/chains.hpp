@@ -2,13 +2,14 @@
 #define STAN_MCMC_CHAINS_HPP
 
 #include <stan/io/stan_csv_reader.hpp>
+#include <stan/mcmc/draws_source.hpp>
 #include <stan/math/prim/mat.hpp>
 #include <stan/analyze/mcmc/compute_effective_sample_size.hpp>
+#include <stan/analyze/mcmc/compute_quantiles.hpp>
+#include <stan/services/util/parallel_for.hpp>
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
-#include <boost/accumulators/statistics/tail_quantile.hpp>
-#include <boost/accumulators/statistics/p_square_quantile.hpp>
 #include <boost/accumulators/statistics/variance.hpp>
 #include <boost/accumulators/statistics/covariance.hpp>
 #include <boost/accumulators/statistics/variates/covariate.hpp>
@@ -29,6 +30,23 @@ namespace stan {
   namespace mcmc {
     using Eigen::Dynamic;
 
+    /**
+     * Summary statistics of parameters, as computed by
+     * <code>chains::summary</code>. The vectors have one entry per
+     * summarized parameter, in the order of <code>indexes</code>, and
+     * <code>quantiles</code> has one row per parameter and one column
+     * per probability.
+     */
+    struct chains_summary {
+      std::vector<int> indexes;
+      Eigen::VectorXd mean;
+      Eigen::VectorXd sd;
+      Eigen::VectorXd effective_sample_size;
+      Eigen::VectorXd split_effective_sample_size;
+      Eigen::VectorXd split_potential_scale_reduction;
+      Eigen::MatrixXd quantiles;
+    };
+
     /**
      * An <code>mcmc::chains</code> object stores parameter names and
      * dimensionalities along with samples from multiple chains.
@@ -42,14 +60,37 @@ namespace stan {
      * as global or single-chain read or write methods.
      *
      * <p><b>Storage Order</b>: Storage is column/last-index major.
+     *
+     * <p><b>Lazy Loading</b>: A chain added as a
+     * <code>draws_source</code> is not read into memory; each column
+     * is read from the source the first time it is used, for example
+     * by <code>samples(index)</code>, <code>quantiles(index,
+     * probs)</code> or <code>effective_sample_size(index)</code>.
+     * <code>load</code> reads many columns in one pass. The sources
+     * must outlive the chains.
      */
     template <class RNG = boost::random::ecuyer1988>
     class chains {
     private:
       Eigen::Matrix<std::string, Dynamic, 1> param_names_;
       Eigen::Matrix<Eigen::MatrixXd, Dynamic, 1> samples_;
+      std::vector<const draws_source*> sources_;
       Eigen::VectorXi warmup_;
 
+      typedef Eigen::Map<const Eigen::VectorXd> column_t;
+
+      /**
+       * Return all draws of a parameter in a chain, including warmup,
+       * reading them from the chain's source if it has one.
+       */
+      column_t column(const int chain, const int index) const {
+        if (sources_[chain])
+          return column_t(sources_[chain]->column(index).data(),
+                          sources_[chain]->num_rows());
+        return column_t(samples_(chain).col(index).data(),
+                        samples_(chain).rows());
+      }
+
       static double mean(const Eigen::VectorXd& x) {
         return (x.array() / x.size()).sum();
       }
@@ -113,67 +154,14 @@ namespace stan {
       }
 
       static double quantile(const Eigen::VectorXd& x, const double prob) {
-        using boost::accumulators::accumulator_set;
-        using boost::accumulators::left;
-        using boost::accumulators::quantile;
-        using boost::accumulators::quantile_probability;
-        using boost::accumulators::right;
-        using boost::accumulators::stats;
-        using boost::accumulators::tag::tail;
-        using boost::accumulators::tag::tail_quantile;
-        double M = x.rows();
-        // size_t cache_size = std::min(prob, 1-prob)*M + 2;
-        size_t cache_size = M;
-
-        if (prob < 0.5) {
-          accumulator_set<double, stats<tail_quantile<left> > >
-            acc(tail<left>::cache_size = cache_size);
-          for (int i = 0; i < M; i++)
-            acc(x(i));
-          return quantile(acc, quantile_probability = prob);
-        }
-        accumulator_set<double, stats<tail_quantile<right> > >
-          acc(tail<right>::cache_size = cache_size);
-        for (int i = 0; i < M; i++)
-          acc(x(i));
-        return quantile(acc, quantile_probability = prob);
+        Eigen::VectorXd probs(1);
+        probs << prob;
+        return quantiles(x, probs)(0);
       }
 
       static Eigen::VectorXd
       quantiles(const Eigen::VectorXd& x, const Eigen::VectorXd& probs) {
-        using boost::accumulators::accumulator_set;
-        using boost::accumulators::left;
-        using boost::accumulators::quantile_probability;
-        using boost::accumulators::quantile;
-        using boost::accumulators::right;
-        using boost::accumulators::stats;
-        using boost::accumulators::tag::tail;
-        using boost::accumulators::tag::tail_quantile;
-        double M = x.rows();
-
-        // size_t cache_size = M/2 + 2;
-        size_t cache_size = M;  // 2 + 2;
-
-        accumulator_set<double, stats<tail_quantile<left> > >
-          acc_left(tail<left>::cache_size = cache_size);
-        accumulator_set<double, stats<tail_quantile<right> > >
-          acc_right(tail<right>::cache_size = cache_size);
-
-        for (int i = 0; i < M; i++) {
-          acc_left(x(i));
-          acc_right(x(i));
-        }
-
-        Eigen::VectorXd q(probs.size());
-        for (int i = 0; i < probs.size(); i++) {
-          if (probs(i) < 0.5)
-            q(i) = quantile(acc_left,
-                            quantile_probability = probs(i));
-          else
-            q(i) = quantile(acc_right,
-                            quantile_probability = probs(i));
-        }
-        return q;
+        return analyze::compute_quantiles(x.data(), x.size(), probs);
       }
 
       static Eigen::VectorXd autocorrelation(const Eigen::VectorXd& x) {
@@ -271,6 +259,11 @@ namespace stan {
           add(stan_csv);
       }
 
+      explicit chains(const draws_source& source)
+        : param_names_(source.header()) {
+        add(source);
+      }
+
       inline int num_chains() const {
         return samples_.size();
       }
@@ -312,6 +305,8 @@ namespace stan {
       }
 
       int num_samples(const int chain) const {
+        if (sources_[chain])
+          return sources_[chain]->num_rows();
         return samples_(chain).rows();
       }
 
@@ -361,6 +356,19 @@ namespace stan {
             samples_(i) = Eigen::MatrixXd(0, num_params());
             warmup_(i) = 0;
           }
+          sources_.resize(chain+1, 0);
+        }
+        if (sources_[chain]) {
+          // appending to a chain read from a source reads all of it
+          const draws_source& source = *sources_[chain];
+          std::vector<int> indexes(num_params());
+          for (int i = 0; i < num_params(); i++)
+            indexes[i] = i;
+          source.load(indexes);
+          samples_(chain).resize(source.num_rows(), num_params());
+          for (int i = 0; i < num_params(); i++)
+            samples_(chain).col(i) = source.column(i);
+          sources_[chain] = 0;
         }
         int row = samples_(chain).rows();
         Eigen::MatrixXd new_samples(row+sample.rows(), num_params());
@@ -410,8 +418,42 @@ namespace stan {
           set_warmup(num_chains()-1, stan_csv.metadata.num_warmup);
       }
 
+      /**
+       * Add a chain whose draws are read from the source as they are
+       * used. The source must outlive this object.
+       *
+       * @param source draws of the chain
+       * @throw std::invalid_argument if the header of the source does
+       *   not match the parameter names
+       */
+      void add(const draws_source& source) {
+        if (source.num_params() != num_params())
+          throw std::invalid_argument("add(source): number of columns in"
+                                      " source does not match chains");
+        if (!param_names_.cwiseEqual(source.header()).all())
+          throw std::invalid_argument("add(source): header does not match"
+                                      " chain's header");
+        int chain = num_chains();
+        add(chain, Eigen::MatrixXd(0, num_params()));
+        sources_[chain] = &source;
+        set_warmup(chain, source.num_warmup());
+      }
+
+      /**
+       * Read the draws of the specified parameters from the sources of
+       * the chains added as sources, in one pass over each source.
+       * Parameters already read are not read again.
+       *
+       * @param indexes indexes of parameters
+       */
+      void load(const std::vector<int>& indexes) const {
+        for (int chain = 0; chain < num_chains(); chain++)
+          if (sources_[chain])
+            sources_[chain]->load(indexes);
+      }
+
       Eigen::VectorXd samples(const int chain, const int index) const {
-        return samples_(chain).col(index).bottomRows(num_kept_samples(chain));
+        return column(chain, index).bottomRows(num_kept_samples(chain));
       }
 
       Eigen::VectorXd samples(const int index) const {
@@ -419,7 +461,7 @@ namespace stan {
         int start = 0;
         for (int chain = 0; chain < num_chains(); chain++) {
           int n = num_kept_samples(chain);
-          s.middleRows(start, n) = samples_(chain).col(index).bottomRows(n);
+          s.middleRows(start, n) = column(chain, index).bottomRows(n);
           start += n;
         }
         return s;
@@ -613,8 +655,7 @@ namespace stan {
         int n_kept_samples = 0;
         for (int chain = 0; chain < n_chains; ++chain) {
           n_kept_samples = num_kept_samples(chain);
-          draws[chain]
-            = samples_(chain).col(index).bottomRows(n_kept_samples).data();
+          draws[chain] = column(chain, index).bottomRows(n_kept_samples).data();
           sizes[chain] = n_kept_samples;
         }
         return analyze::compute_effective_sample_size(draws, sizes);
@@ -631,8 +672,7 @@ namespace stan {
         int n_kept_samples = 0;
         for (int chain = 0; chain < n_chains; ++chain) {
           n_kept_samples = num_kept_samples(chain);
-          draws[chain]
-            = samples_(chain).col(index).bottomRows(n_kept_samples).data();
+          draws[chain] = column(chain, index).bottomRows(n_kept_samples).data();
           sizes[chain] = n_kept_samples;
         }
         return analyze::compute_split_effective_sample_size(draws, sizes);
@@ -654,6 +694,95 @@ namespace stan {
       double split_potential_scale_reduction(const std::string& name) const {
         return split_potential_scale_reduction(index(name));
       }
+
+      /**
+       * Compute the mean, standard deviation, effective sample size,
+       * split effective sample size, split R hat and quantiles of the
+       * specified parameters, with the same results as the methods
+       * computing them one at a time.
+       *
+       * Parameters read from a <code>draws_source</code> are loaded in
+       * one pass. The parameters are divided among up to
+       * <code>num_threads</code> threads (if compiled with
+       * <code>STAN_THREADS</code>), each of which reuses one
+       * autocovariance engine and one buffer of draws for all of its
+       * parameters.
+       *
+       * @param indexes indexes of parameters
+       * @param probs probabilities of the quantiles
+       * @param num_threads maximum number of threads to use
+       * @return summary statistics
+       */
+      chains_summary summary(const std::vector<int>& indexes,
+                             const Eigen::VectorXd& probs,
+                             size_t num_threads = 1) const {
+        chains_summary result;
+        int num_indexes = indexes.size();
+        result.indexes = indexes;
+        result.mean.resize(num_indexes);
+        result.sd.resize(num_indexes);
+        result.effective_sample_size.resize(num_indexes);
+        result.split_effective_sample_size.resize(num_indexes);
+        result.split_potential_scale_reduction.resize(num_indexes);
+        result.quantiles.resize(num_indexes, probs.size());
+        if (num_indexes == 0)
+          return result;
+        load(indexes);
+
+        size_t num_jobs = std::min(std::max(num_threads, size_t(1)),
+                                   indexes.size());
+        services::util::parallel_for(num_jobs, num_jobs, [&](size_t job) {
+          int begin = job * num_indexes / num_jobs;
+          int end = (job + 1) * num_indexes / num_jobs;
+          analyze::autocovariance_engine<double> engine;
+          Eigen::VectorXd kept(num_kept_samples());
+          Eigen::Matrix<Eigen::VectorXd, Dynamic, 1>
+            chain_samples(num_chains());
+          std::vector<const double*> draws(num_chains());
+          std::vector<size_t> sizes(num_chains());
+          for (int i = begin; i < end; i++) {
+            int start = 0;
+            for (int chain = 0; chain < num_chains(); chain++) {
+              int n = num_kept_samples(chain);
+              column_t x = column(chain, indexes[i]);
+              draws[chain] = x.bottomRows(n).data();
+              sizes[chain] = n;
+              chain_samples(chain) = x.bottomRows(n);
+              kept.middleRows(start, n) = x.bottomRows(n);
+              start += n;
+            }
+            result.mean(i) = mean(kept);
+            result.sd(i) = sd(kept);
+            result.effective_sample_size(i)
+              = analyze::compute_effective_sample_size(draws, sizes, engine);
+            result.split_effective_sample_size(i)
+              = analyze::compute_split_effective_sample_size(draws, sizes,
+                                                             engine);
+            result.split_potential_scale_reduction(i)
+              = split_potential_scale_reduction(chain_samples);
+            if (probs.size() > 0)
+              result.quantiles.row(i)
+                = analyze::compute_quantiles_in_place(kept.data(),
+                                                      kept.size(), probs);
+          }
+        });
+        return result;
+      }
+
+      /**
+       * Compute the summary statistics of all parameters.
+       *
+       * @param probs probabilities of the quantiles
+       * @param num_threads maximum number of threads to use
+       * @return summary statistics
+       */
+      chains_summary summary(const Eigen::VectorXd& probs,
+                             size_t num_threads = 1) const {
+        std::vector<int> indexes(num_params());
+        for (int i = 0; i < num_params(); i++)
+          indexes[i] = i;
+        return summary(indexes, probs, num_threads);
+      }
     };
 
   }
@@ -0,0 +1,77 @@
+#ifndef STAN_MCMC_CSV_DRAWS_SOURCE_HPP
+#define STAN_MCMC_CSV_DRAWS_SOURCE_HPP
+
+#include <stan/io/stan_csv_reader.hpp>
+#include <stan/mcmc/draws_source.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * A <code>draws_source</code> reading the draws of a Stan CSV
+     * file.
+     *
+     * Each read maps the file into memory and parses only the
+     * requested columns (see <code>stan_csv_reader::parse_file</code>).
+     * If warmup draws were saved, <code>num_warmup()</code> is the
+     * number of warmup iterations in the metadata.
+     */
+    class csv_draws_source : public draws_source {
+    public:
+      /**
+       * Construct a source for the specified file, reading its header
+       * and counting its draws.
+       *
+       * @param filename name of Stan CSV file
+       * @param num_threads maximum number of threads used to parse
+       * @throw std::invalid_argument if the file cannot be read or has
+       *   no header
+       */
+      explicit csv_draws_source(const std::string& filename,
+                                size_t num_threads = 1)
+        : filename_(filename), num_threads_(num_threads) {
+        std::ifstream in(filename.c_str());
+        if (!in)
+          throw std::invalid_argument("csv_draws_source: cannot open file "
+                                      + filename);
+        io::stan_csv_metadata metadata;
+        Eigen::Matrix<std::string, Eigen::Dynamic, 1> header;
+        io::stan_csv_reader::read_metadata(in, metadata, 0);
+        if (!io::stan_csv_reader::read_header(in, header, 0))
+          throw std::invalid_argument("csv_draws_source: error reading"
+                                      " header of file " + filename);
+        in.close();
+
+        // the number of draws is found by reading the first column
+        io::stan_csv first = io::stan_csv_reader::parse_file(
+            filename, 0, std::vector<std::string>(1, header(0)),
+            num_threads);
+        init(header, first.samples.rows(),
+             metadata.save_warmup ? metadata.num_warmup : 0);
+      }
+
+    protected:
+      void read(const std::vector<int>& indexes,
+                Eigen::MatrixXd& draws) const {
+        std::vector<std::string> names(indexes.size());
+        for (size_t n = 0; n < indexes.size(); ++n)
+          names[n] = header()(indexes[n]);
+        io::stan_csv data = io::stan_csv_reader::parse_file(
+            filename_, 0, names, num_threads_);
+        draws.swap(data.samples);
+      }
+
+    private:
+      std::string filename_;
+      size_t num_threads_;
+    };
+
+  }
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef STAN_MCMC_DRAWS_SOURCE_HPP
+#define STAN_MCMC_DRAWS_SOURCE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * The draws of one chain, read from storage a column at a time.
+     *
+     * <p>A <code>draws_source</code> can be added to
+     * <code>stan::mcmc::chains</code> in place of a matrix of
+     * draws. Only the header and number of rows are read when the
+     * source is constructed; the draws of a column are read and
+     * cached on first access. <code>load</code> reads several columns
+     * in one pass over the storage, which is much cheaper than
+     * reading them one at a time.
+     *
+     * <p>Derived classes call <code>init</code> from their
+     * constructors and implement <code>read</code>.
+     *
+     * <p><b>Synchronization</b>: Columns may be accessed and loaded
+     * concurrently. References to loaded columns remain valid as long
+     * as the source exists.
+     */
+    class draws_source {
+    public:
+      virtual ~draws_source() {}
+
+      const Eigen::Matrix<std::string, Eigen::Dynamic, 1>& header() const {
+        return header_;
+      }
+
+      int num_params() const {
+        return header_.size();
+      }
+
+      /**
+       * Return the number of draws, including saved warmup draws.
+       */
+      int num_rows() const {
+        return num_rows_;
+      }
+
+      /**
+       * Return the number of saved warmup draws at the start of the
+       * draws.
+       */
+      int num_warmup() const {
+        return num_warmup_;
+      }
+
+      /**
+       * Return <code>true</code> if the column has been read.
+       *
+       * @param index index of column
+       */
+      bool loaded(int index) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return loaded_[index];
+      }
+
+      /**
+       * Return the draws of a column, reading them if they have not
+       * been read.
+       *
+       * @param index index of column
+       * @return draws of the column
+       */
+      const Eigen::VectorXd& column(int index) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!loaded_[index])
+          load_locked(std::vector<int>(1, index));
+        return columns_[index];
+      }
+
+      /**
+       * Read the columns that have not been read, in one pass.
+       *
+       * @param indexes indexes of columns
+       */
+      void load(const std::vector<int>& indexes) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<int> missing;
+        for (size_t n = 0; n < indexes.size(); ++n)
+          if (!loaded_[indexes[n]]) {
+            missing.push_back(indexes[n]);
+            loaded_[indexes[n]] = true;
+          }
+        if (!missing.empty())
+          load_locked(missing);
+      }
+
+    protected:
+      draws_source() : num_rows_(0), num_warmup_(0) {}
+
+      void init(const Eigen::Matrix<std::string, Eigen::Dynamic, 1>& header,
+                int num_rows, int num_warmup) {
+        header_ = header;
+        num_rows_ = num_rows;
+        num_warmup_ = num_warmup;
+        columns_.assign(header.size(), Eigen::VectorXd());
+        loaded_.assign(header.size(), false);
+      }
+
+      /**
+       * Read the draws of the specified columns.
+       *
+       * @param[in] indexes indexes of columns, without duplicates
+       * @param[out] draws draws of the columns, one column per index
+       *   in the same order, with <code>num_rows()</code> rows
+       */
+      virtual void read(const std::vector<int>& indexes,
+                        Eigen::MatrixXd& draws) const = 0;
+
+    private:
+      Eigen::Matrix<std::string, Eigen::Dynamic, 1> header_;
+      int num_rows_;
+      int num_warmup_;
+      mutable std::vector<Eigen::VectorXd> columns_;
+      mutable std::vector<bool> loaded_;
+      mutable std::mutex mutex_;
+
+      draws_source(const draws_source&);
+      draws_source& operator=(const draws_source&);
+
+      void load_locked(const std::vector<int>& indexes) const {
+        Eigen::MatrixXd draws;
+        try {
+          read(indexes, draws);
+        } catch (...) {
+          for (size_t n = 0; n < indexes.size(); ++n)
+            loaded_[indexes[n]] = false;
+          throw;
+        }
+        if (draws.rows() != num_rows_
+            || draws.cols() != static_cast<int>(indexes.size())) {
+          for (size_t n = 0; n < indexes.size(); ++n)
+            loaded_[indexes[n]] = false;
+          throw std::invalid_argument("draws_source: number of draws read"
+                                      " does not match");
+        }
+        for (size_t n = 0; n < indexes.size(); ++n) {
+          columns_[indexes[n]] = draws.col(n);
+          loaded_[indexes[n]] = true;
+        }
+      }
+    };
+
+  }
+}
+
+#endif
@@ -70,6 +70,11 @@ namespace stan {
         z_.get_params(values);
       }
 
+      void get_sampler_counters(sampler_counters& counters) {
+        counters.n_leapfrog = integrator_.n_steps();
+        hamiltonian_.get_counters(counters);
+      }
+
       void seed(const Eigen::VectorXd& q) {
         z_.q = q;
       }
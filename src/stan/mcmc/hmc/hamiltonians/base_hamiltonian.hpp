@@ -3,9 +3,11 @@
 
 #include <stan/callbacks/logger.hpp>
 #include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/mcmc/sampler_counters.hpp>
 #include <stan/model/gradient.hpp>
 #include <stan/model/log_prob_propto.hpp>
 #include <Eigen/Dense>
+#include <chrono>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
@@ -18,7 +20,7 @@ namespace stan {
     class base_hamiltonian {
     public:
       explicit base_hamiltonian(const Model& model)
-        : model_(model) {}
+        : model_(model), n_gradient_(0), n_log_prob_(0), log_prob_time_(0) {}
 
       ~base_hamiltonian() {}
 
@@ -46,6 +48,17 @@ namespace stan {
 
       virtual Eigen::VectorXd dtau_dp(Point& z) = 0;
 
+      /**
+       * Writes dtau_dp into existing storage. Metrics with a cheap
+       * closed form override this so that no vector is allocated.
+       *
+       * @param[in] z point in phase space
+       * @param[out] dtau_dp derivative of tau with respect to p
+       */
+      virtual void compute_dtau_dp(Point& z, Eigen::VectorXd& dtau_dp) {
+        dtau_dp = this->dtau_dp(z);
+      }
+
       // phi = 0.5 * log | Lambda (q) | + V(q)
       virtual Eigen::VectorXd dphi_dq(Point& z, callbacks::logger& logger) = 0;
 
@@ -56,15 +69,20 @@ namespace stan {
       }
 
       void update_potential(Point& z, callbacks::logger& logger) {
+        ++n_log_prob_;
+        clock::time_point start = clock::now();
         try {
           z.V = -stan::model::log_prob_propto<true>(model_, z.q);
         } catch (const std::exception& e) {
           this->write_error_msg_(e, logger);
           z.V = std::numeric_limits<double>::infinity();
         }
+        log_prob_time_ += seconds_since(start);
       }
 
       void update_potential_gradient(Point& z, callbacks::logger& logger) {
+        ++n_gradient_;
+        clock::time_point start = clock::now();
         try {
           stan::model::gradient(model_, z.q, z.V, z.g, logger);
           z.V = -z.V;
@@ -73,6 +91,19 @@ namespace stan {
           z.V = std::numeric_limits<double>::infinity();
         }
         z.g = -z.g;
+        log_prob_time_ += seconds_since(start);
+      }
+
+      /**
+       * Writes the number of evaluations of the potential and the time
+       * spent in them since construction.
+       *
+       * @param[out] counters counters to update
+       */
+      void get_counters(sampler_counters& counters) const {
+        counters.n_gradient = n_gradient_;
+        counters.n_log_prob = n_log_prob_;
+        counters.log_prob_time = log_prob_time_;
       }
 
       void update_metric(Point& z, callbacks::logger& logger) { }
@@ -84,7 +115,16 @@ namespace stan {
       }
 
     protected:
+      typedef std::chrono::steady_clock clock;
+
       const Model& model_;
+      long n_gradient_;
+      long n_log_prob_;
+      double log_prob_time_;
+
+      static double seconds_since(const clock::time_point& start) {
+        return std::chrono::duration<double>(clock::now() - start).count();
+      }
 
       void write_error_msg_(const std::exception& e,
                             callbacks::logger& logger) {
@@ -21,7 +21,8 @@ namespace stan {
         : base_hamiltonian<Model, dense_e_point, BaseRNG>(model) {}
 
       double T(dense_e_point& z) {
-        return 0.5 * z.p.transpose() * z.inv_e_metric_ * z.p;
+        return 0.5 * (z.inv_e_metric_llt_u_.triangularView<Eigen::Upper>()
+                      * z.p).squaredNorm();
       }
 
       double tau(dense_e_point& z) {
@@ -44,6 +45,10 @@ namespace stan {
         return z.inv_e_metric_ * z.p;
       }
 
+      void compute_dtau_dp(dense_e_point& z, Eigen::VectorXd& dtau_dp) {
+        dtau_dp.noalias() = z.inv_e_metric_ * z.p;
+      }
+
       Eigen::VectorXd dphi_dq(dense_e_point& z, callbacks::logger& logger) {
         return z.g;
       }
@@ -58,7 +63,7 @@ namespace stan {
         for (idx_t i = 0; i < u.size(); ++i)
           u(i) = rand_dense_gaus();
 
-        z.p = z.inv_e_metric_.llt().matrixU().solve(u);
+        z.p = z.inv_e_metric_llt_u_.triangularView<Eigen::Upper>().solve(u);
       }
     };
 
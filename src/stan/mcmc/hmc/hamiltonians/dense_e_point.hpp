@@ -17,6 +17,12 @@ namespace stan {
        */
       Eigen::MatrixXd inv_e_metric_;
 
+      /**
+       * Upper triangular Cholesky factor of the inverse mass matrix,
+       * cached so it is only recomputed when the metric changes.
+       */
+      Eigen::MatrixXd inv_e_metric_llt_u_;
+
       /**
        * Construct a dense point in n-dimensional phase space
        * with identity matrix as inverse mass matrix.
@@ -24,19 +30,25 @@ namespace stan {
        * @param n number of dimensions
        */
       explicit dense_e_point(int n)
-        : ps_point(n), inv_e_metric_(n, n) {
+        : ps_point(n), inv_e_metric_(n, n), inv_e_metric_llt_u_(n, n) {
         inv_e_metric_.setIdentity();
+        inv_e_metric_llt_u_.setIdentity();
       }
 
       /**
-       * Copy constructor which does fast copy of inverse mass matrix.
+       * Copy constructor which does fast copy of inverse mass matrix
+       * and its Cholesky factor.
        *
        * @param z point to copy
        */
       dense_e_point(const dense_e_point& z)
         : ps_point(z), inv_e_metric_(z.inv_e_metric_.rows(),
-                                     z.inv_e_metric_.cols()) {
+                                     z.inv_e_metric_.cols()),
+          inv_e_metric_llt_u_(z.inv_e_metric_llt_u_.rows(),
+                              z.inv_e_metric_llt_u_.cols()) {
         fast_matrix_copy_<double>(inv_e_metric_, z.inv_e_metric_);
+        fast_matrix_copy_<double>(inv_e_metric_llt_u_,
+                                  z.inv_e_metric_llt_u_);
       }
 
       /**
@@ -47,6 +59,17 @@ namespace stan {
       void
       set_metric(const Eigen::MatrixXd& inv_e_metric) {
         inv_e_metric_ = inv_e_metric;
+        update_metric_factor();
+      }
+
+      /**
+       * Recompute the cached Cholesky factor of the inverse mass
+       * matrix. Must be called whenever <code>inv_e_metric_</code> is
+       * modified other than through <code>set_metric</code>.
+       */
+      void
+      update_metric_factor() {
+        inv_e_metric_llt_u_ = inv_e_metric_.llt().matrixU();
       }
 
       /**
@@ -41,6 +41,10 @@ namespace stan {
         return z.inv_e_metric_.cwiseProduct(z.p);
       }
 
+      void compute_dtau_dp(diag_e_point& z, Eigen::VectorXd& dtau_dp) {
+        dtau_dp = z.inv_e_metric_.cwiseProduct(z.p);
+      }
+
       Eigen::VectorXd dphi_dq(diag_e_point& z, callbacks::logger& logger) {
         return z.g;
       }
@@ -41,6 +41,10 @@ namespace stan {
         return z.p;
       }
 
+      void compute_dtau_dp(unit_e_point& z, Eigen::VectorXd& dtau_dp) {
+        dtau_dp = z.p;
+      }
+
       Eigen::VectorXd dphi_dq(unit_e_point& z, callbacks::logger& logger) {
         return z.g;
       }
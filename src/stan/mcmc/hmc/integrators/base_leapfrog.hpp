@@ -13,12 +13,13 @@ namespace stan {
     class base_leapfrog : public base_integrator<Hamiltonian> {
     public:
       base_leapfrog()
-        : base_integrator<Hamiltonian>() {}
+        : base_integrator<Hamiltonian>(), n_steps_(0) {}
 
       void evolve(typename Hamiltonian::PointType& z,
                   Hamiltonian& hamiltonian,
                   const double epsilon,
                   callbacks::logger& logger) {
+        ++n_steps_;
         begin_update_p(z, hamiltonian, 0.5 * epsilon,
                        logger);
         update_q(z, hamiltonian, epsilon,
@@ -32,6 +33,7 @@ namespace stan {
                      Hamiltonian& hamiltonian,
                      const double epsilon,
                      callbacks::logger& logger) {
+        ++n_steps_;
         std::stringstream msg;
         msg.precision(6);
 
@@ -130,6 +132,18 @@ namespace stan {
       void end_update_p(typename Hamiltonian::PointType& z,
                         Hamiltonian& hamiltonian, double epsilon,
                         callbacks::logger& logger) = 0;
+
+      /**
+       * Returns the number of steps taken since construction.
+       *
+       * @return number of calls to evolve or verbose_evolve
+       */
+      long n_steps() const {
+        return n_steps_;
+      }
+
+    private:
+      long n_steps_;
     };
 
   }  // mcmc
@@ -23,7 +23,8 @@ namespace stan {
       void update_q(typename Hamiltonian::PointType& z,
                     Hamiltonian& hamiltonian, double epsilon,
                     callbacks::logger& logger) {
-        z.q += epsilon * hamiltonian.dtau_dp(z);
+        hamiltonian.compute_dtau_dp(z, dtau_dp_);
+        z.q += epsilon * dtau_dp_;
         hamiltonian.update_potential_gradient(z, logger);
       }
 
@@ -32,6 +33,12 @@ namespace stan {
                         callbacks::logger& logger) {
         z.p -= epsilon * hamiltonian.dphi_dq(z, logger);
       }
+
+    private:
+      /**
+       * Storage for dtau_dp, reused across steps.
+       */
+      Eigen::VectorXd dtau_dp_;
     };
 
   }  // mcmc
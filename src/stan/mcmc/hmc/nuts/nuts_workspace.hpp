@@ -0,0 +1,99 @@
+#ifndef STAN_MCMC_HMC_NUTS_NUTS_WORKSPACE_HPP
+#define STAN_MCMC_HMC_NUTS_NUTS_WORKSPACE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/mcmc/hmc/hamiltonians/ps_point.hpp>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * Preallocated storage for the trajectory builder of base_nuts.
+     *
+     * The states and vectors used while building a trajectory are
+     * sized once and reused across transitions, so tree doublings
+     * do not allocate. Storage for the recursive subtree builder is
+     * kept per tree depth; at any time at most one subtree of a given
+     * depth is under construction.
+     */
+    class nuts_workspace {
+    public:
+      /**
+       * Storage used by one level of the recursive subtree builder.
+       */
+      struct subtree {
+        explicit subtree(int n)
+          : z_propose_final(n),
+            p_init_end(n), p_sharp_init_end(n), rho_init(n),
+            p_final_beg(n), p_sharp_final_beg(n), rho_final(n),
+            rho_subtree(n) {}
+
+        ps_point z_propose_final;
+        Eigen::VectorXd p_init_end;
+        Eigen::VectorXd p_sharp_init_end;
+        Eigen::VectorXd rho_init;
+        Eigen::VectorXd p_final_beg;
+        Eigen::VectorXd p_sharp_final_beg;
+        Eigen::VectorXd rho_final;
+        Eigen::VectorXd rho_subtree;
+      };
+
+      /**
+       * Construct storage for trajectories in an n-dimensional
+       * phase space.
+       *
+       * @param n number of dimensions
+       */
+      explicit nuts_workspace(int n)
+        : z_fwd(n), z_bck(n), z_sample(n), z_propose(n),
+          p_fwd_fwd(n), p_sharp_fwd_fwd(n),
+          p_fwd_bck(n), p_sharp_fwd_bck(n),
+          p_bck_fwd(n), p_sharp_bck_fwd(n),
+          p_bck_bck(n), p_sharp_bck_bck(n),
+          rho(n), rho_fwd(n), rho_bck(n), rho_extended(n),
+          n_(n) {}
+
+      /**
+       * Return the storage for building a subtree of the specified
+       * depth, growing the per-depth stack if needed.
+       *
+       * Growing the stack invalidates references to existing levels,
+       * so this must first be called with the largest depth of a
+       * tree before any of its subtrees are built.
+       *
+       * @param depth depth of the subtree, at least 1
+       * @return storage for that depth
+       */
+      subtree& level(int depth) {
+        while (static_cast<int>(levels_.size()) < depth)
+          levels_.push_back(subtree(n_));
+        return levels_[depth - 1];
+      }
+
+      ps_point z_fwd;
+      ps_point z_bck;
+      ps_point z_sample;
+      ps_point z_propose;
+
+      Eigen::VectorXd p_fwd_fwd;
+      Eigen::VectorXd p_sharp_fwd_fwd;
+      Eigen::VectorXd p_fwd_bck;
+      Eigen::VectorXd p_sharp_fwd_bck;
+      Eigen::VectorXd p_bck_fwd;
+      Eigen::VectorXd p_sharp_bck_fwd;
+      Eigen::VectorXd p_bck_bck;
+      Eigen::VectorXd p_sharp_bck_bck;
+
+      Eigen::VectorXd rho;
+      Eigen::VectorXd rho_fwd;
+      Eigen::VectorXd rho_bck;
+      Eigen::VectorXd rho_extended;
+
+    private:
+      int n_;
+      std::vector<subtree> levels_;
+    };
+
+  }  // mcmc
+}  // stan
+#endif
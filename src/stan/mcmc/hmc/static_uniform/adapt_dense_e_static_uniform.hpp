@@ -37,6 +37,7 @@ namespace stan {
             (this->z_.inv_e_metric_, this->z_.q);
 
           if (update) {
+            this->z_.update_metric_factor();
             this->init_stepsize(logger);
             this->stepsize_adaptation_.set_mu(log(10 * this->nom_epsilon_));
             this->stepsize_adaptation_.restart();
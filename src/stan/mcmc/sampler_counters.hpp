@@ -0,0 +1,40 @@
+#ifndef STAN_MCMC_SAMPLER_COUNTERS_HPP
+#define STAN_MCMC_SAMPLER_COUNTERS_HPP
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Counts of the work done by a sampler since it was constructed.
+     *
+     * Samplers that do not track a quantity leave it at zero.
+     */
+    struct sampler_counters {
+      /**
+       * Number of integrator steps
+       */
+      long n_leapfrog;
+
+      /**
+       * Number of evaluations of the log density with its gradient
+       */
+      long n_gradient;
+
+      /**
+       * Number of evaluations of the log density without its gradient
+       */
+      long n_log_prob;
+
+      /**
+       * Wall time in seconds spent evaluating the log density and its
+       * gradient
+       */
+      double log_prob_time;
+
+      sampler_counters()
+        : n_leapfrog(0), n_gradient(0), n_log_prob(0), log_prob_time(0) {}
+    };
+
+  }  // mcmc
+}  // stan
+#endif
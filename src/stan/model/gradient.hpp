@@ -4,8 +4,8 @@
 #include <stan/callbacks/logger.hpp>
 #include <stan/callbacks/writer.hpp>
 #include <stan/math/rev/mat.hpp>
+#include <stan/model/message_sink.hpp>
 #include <stan/model/model_functional.hpp>
-#include <sstream>
 #include <stdexcept>
 
 namespace stan {
@@ -26,16 +26,15 @@ namespace stan {
                   double& f,
                   Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_f,
                   callbacks::logger& logger) {
-      std::stringstream ss;
+      message_sink msgs;
       try {
-        stan::math::gradient(model_functional<M>(model, &ss), x, f, grad_f);
+        stan::math::gradient(model_functional<M>(model, msgs.stream()),
+                             x, f, grad_f);
       } catch (std::exception& e) {
-        if (ss.str().length() > 0)
-          logger.info(ss);
+        msgs.log_info(logger);
         throw;
       }
-      if (ss.str().length() > 0)
-        logger.info(ss);
+      msgs.log_info(logger);
     }
 
   }
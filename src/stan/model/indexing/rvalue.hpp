@@ -8,6 +8,7 @@
 #include <stan/model/indexing/index_list.hpp>
 #include <stan/model/indexing/rvalue_at.hpp>
 #include <stan/model/indexing/rvalue_index_size.hpp>
+#include <stan/model/indexing/rvalue_range.hpp>
 #include <stan/model/indexing/rvalue_return.hpp>
 #include <vector>
 
@@ -101,6 +102,13 @@ namespace stan {
            const cons_index_list<I, nil_index_list>& idx,
            const char* name = "ANON", int depth = 0) {
       int size = rvalue_index_size(idx.head_, v.size());
+      if (rvalue_is_range(idx.head_)) {
+        if (size <= 0)
+          return Eigen::Matrix<T, Eigen::Dynamic, 1>();
+        int n = rvalue_range_begin("vector[multi] indexing", name,
+                                   idx.head_, size, v.size());
+        return v.segment(n - 1, size);
+      }
       Eigen::Matrix<T, Eigen::Dynamic, 1> a(size);
       for (int i = 0; i < size; ++i) {
         int n = rvalue_at(i, idx.head_);
@@ -133,6 +141,13 @@ namespace stan {
            const cons_index_list<I, nil_index_list>& idx,
            const char* name = "ANON", int depth = 0) {
       int size = rvalue_index_size(idx.head_, rv.size());
+      if (rvalue_is_range(idx.head_)) {
+        if (size <= 0)
+          return Eigen::Matrix<T, 1, Eigen::Dynamic>();
+        int n = rvalue_range_begin("row_vector[multi] indexing", name,
+                                   idx.head_, size, rv.size());
+        return rv.segment(n - 1, size);
+      }
       Eigen::Matrix<T, 1, Eigen::Dynamic> a(size);
       for (int i = 0; i < size; ++i) {
         int n = rvalue_at(i, idx.head_);
@@ -187,6 +202,13 @@ namespace stan {
            const cons_index_list<I, nil_index_list>& idx,
            const char* name = "ANON", int depth = 0) {
       int n_rows = rvalue_index_size(idx.head_, a.rows());
+      if (rvalue_is_range(idx.head_)) {
+        if (n_rows <= 0)
+          return Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>(0, a.cols());
+        int n = rvalue_range_begin("matrix[multi] indexing", name,
+                                   idx.head_, n_rows, a.rows());
+        return a.middleRows(n - 1, n_rows);
+      }
       Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> b(n_rows, a.cols());
       for (int i = 0; i < n_rows; ++i) {
         int n = rvalue_at(i, idx.head_);
@@ -248,6 +270,14 @@ namespace stan {
            const char* name = "ANON", int depth = 0) {
       int m = idx.head_.n_;
       math::check_range("matrix[uni,multi] indexing, row", name, a.rows(), m);
+      if (rvalue_is_range(idx.tail_.head_)) {
+        int size = rvalue_index_size(idx.tail_.head_, a.cols());
+        if (size <= 0)
+          return Eigen::Matrix<T, 1, Eigen::Dynamic>();
+        int n = rvalue_range_begin("row_vector[multi] indexing", name,
+                                   idx.tail_.head_, size, a.cols());
+        return a.row(m - 1).segment(n - 1, size);
+      }
       Eigen::Matrix<T, 1, Eigen::Dynamic> r = a.row(m - 1);
       return rvalue(r, idx.tail_);
     }
@@ -276,6 +306,16 @@ namespace stan {
                                                     nil_index_list> >& idx,
            const char* name = "ANON", int depth = 0) {
       int rows = rvalue_index_size(idx.head_, a.rows());
+      if (rvalue_is_range(idx.head_) && rows > 0) {
+        // checked in the order of the per-element loop below
+        int m = rvalue_range_first("matrix[multi,uni] index row", name,
+                                   idx.head_, a.rows());
+        int n = idx.tail_.head_.n_;
+        math::check_range("matrix[multi,uni] index col", name, a.cols(), n);
+        rvalue_range_check_rest("matrix[multi,uni] index row", name,
+                                idx.head_, rows, a.rows());
+        return a.col(n - 1).segment(m - 1, rows);
+      }
       Eigen::Matrix<T, Eigen::Dynamic, 1> c(rows);
       for (int i = 0; i < rows; ++i) {
         int m = rvalue_at(i, idx.head_);
@@ -314,6 +354,19 @@ namespace stan {
            const char* name = "ANON", int depth = 0) {
       int rows = rvalue_index_size(idx.head_, a.rows());
       int cols = rvalue_index_size(idx.tail_.head_, a.cols());
+      if (rvalue_is_range(idx.head_) && rvalue_is_range(idx.tail_.head_)
+          && rows > 0 && cols > 0) {
+        // checked in the order of the per-element loop below
+        int m = rvalue_range_first("matrix[multi,multi] row index", name,
+                                   idx.head_, a.rows());
+        int n = rvalue_range_first("matrix[multi,multi] col index", name,
+                                   idx.tail_.head_, a.cols());
+        rvalue_range_check_rest("matrix[multi,multi] row index", name,
+                                idx.head_, rows, a.rows());
+        rvalue_range_check_rest("matrix[multi,multi] col index", name,
+                                idx.tail_.head_, cols, a.cols());
+        return a.block(m - 1, n - 1, rows, cols);
+      }
       Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> c(rows, cols);
       for (int j = 0; j < cols; ++j) {
         for (int i = 0; i < rows; ++i) {
@@ -377,7 +430,10 @@ namespace stan {
            const char* name = "ANON", int depth = 0) {
       typename rvalue_return<std::vector<T>,
                              cons_index_list<I, L> >::type result;
-      for (int i = 0; i < rvalue_index_size(idx.head_, c.size()); ++i) {
+      int size = rvalue_index_size(idx.head_, c.size());
+      if (size > 0)
+        result.reserve(size);
+      for (int i = 0; i < size; ++i) {
         int n = rvalue_at(i, idx.head_);
         math::check_range("array[multi,...] index", name, c.size(), n);
         result.push_back(rvalue(c[n - 1], idx.tail_, name, depth + 1));
@@ -0,0 +1,112 @@
+#ifndef STAN_MODEL_INDEXING_RVALUE_RANGE_HPP
+#define STAN_MODEL_INDEXING_RVALUE_RANGE_HPP
+
+#include <stan/math/prim/mat.hpp>
+#include <stan/model/indexing/index.hpp>
+#include <stan/model/indexing/rvalue_at.hpp>
+#include <algorithm>
+
+namespace stan {
+
+  namespace model {
+
+    // no error checking
+
+    /**
+     * Return true if the positions selected by the specified index
+     * are consecutive.  Only a multiple index can select arbitrary
+     * positions.
+     *
+     * @tparam I type of index
+     * @param idx index
+     * @return true
+     */
+    template <typename I>
+    inline bool rvalue_is_range(const I& idx) {
+      return true;
+    }
+
+    /**
+     * Return false, as a multiple index can select arbitrary
+     * positions.
+     *
+     * @param idx index
+     * @return false
+     */
+    inline bool rvalue_is_range(const index_multi& idx) {
+      return false;
+    }
+
+    // error checking
+
+    /**
+     * Check that the first of the range of consecutive positions
+     * selected by the specified index lies within a dimension of the
+     * specified size and return it, indexing from 1.
+     *
+     * @tparam I type of index
+     * @param function name of function for error messages
+     * @param name name of variable for error messages
+     * @param idx index selecting a range
+     * @param size size of dimension
+     * @return first position selected
+     * @throw std::out_of_range if the first position is out of range
+     */
+    template <typename I>
+    inline int rvalue_range_first(const char* function, const char* name,
+                                  const I& idx, int size) {
+      int first = rvalue_at(0, idx);
+      math::check_range(function, name, size, first);
+      return first;
+    }
+
+    /**
+     * Check that the rest of the range of consecutive positions
+     * selected by the specified index lies within a dimension of the
+     * specified size.  Only the last position is checked, but the
+     * error reports the same position as checking each position in
+     * turn would.
+     *
+     * @tparam I type of index
+     * @param function name of function for error messages
+     * @param name name of variable for error messages
+     * @param idx index selecting a range
+     * @param range_size number of positions selected, at least 1
+     * @param size size of dimension
+     * @throw std::out_of_range if a selected position is out of range
+     */
+    template <typename I>
+    inline void rvalue_range_check_rest(const char* function,
+                                        const char* name, const I& idx,
+                                        int range_size, int size) {
+      int last = rvalue_at(range_size - 1, idx);
+      math::check_range(function, name, size, std::min(last, size + 1));
+    }
+
+    /**
+     * Check that the range of consecutive positions selected by the
+     * specified index lies within a dimension of the specified size
+     * and return its first position, indexing from 1.  Only the ends
+     * of the range are checked, but the error reports the same
+     * position as checking each position in turn would.
+     *
+     * @tparam I type of index
+     * @param function name of function for error messages
+     * @param name name of variable for error messages
+     * @param idx index selecting a range
+     * @param range_size number of positions selected, at least 1
+     * @param size size of dimension
+     * @return first position selected
+     * @throw std::out_of_range if a selected position is out of range
+     */
+    template <typename I>
+    inline int rvalue_range_begin(const char* function, const char* name,
+                                  const I& idx, int range_size, int size) {
+      int first = rvalue_range_first(function, name, idx, size);
+      rvalue_range_check_rest(function, name, idx, range_size, size);
+      return first;
+    }
+
+  }
+}
+#endif
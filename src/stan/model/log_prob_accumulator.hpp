@@ -0,0 +1,119 @@
+#ifndef STAN_MODEL_LOG_PROB_ACCUMULATOR_HPP
+#define STAN_MODEL_LOG_PROB_ACCUMULATOR_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/accumulator.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace stan {
+  namespace model {
+
+    /**
+     * Accumulator for the terms of a log density evaluated with
+     * <code>double</code> scalars.
+     *
+     * <p><code>stan::math::accumulator</code> buffers its terms so
+     * that, for autodiff variables, they can be summed by a single
+     * node on the expression graph.  Without autodiff there is nothing
+     * to gain from buffering, so this accumulator adds each term to a
+     * running total as it arrives, which avoids growing a buffer on
+     * every log density evaluation.  Containers are summed with plain
+     * loops over their elements.
+     */
+    class value_accumulator {
+    private:
+      double sum_;
+
+    public:
+      /**
+       * Construct an accumulator with a sum of zero.
+       */
+      value_accumulator() : sum_(0) { }
+
+      /**
+       * Add the specified term to the sum.
+       *
+       * @param x term
+       */
+      void add(double x) {
+        sum_ += x;
+      }
+
+      /**
+       * Add the elements of the specified matrix to the sum.
+       *
+       * @tparam S type of elements
+       * @tparam R number of rows, can be Eigen::Dynamic
+       * @tparam C number of columns, can be Eigen::Dynamic
+       * @param m matrix of terms
+       */
+      template <typename S, int R, int C>
+      void add(const Eigen::Matrix<S, R, C>& m) {
+        const S* x = m.data();
+        for (int i = 0; i < m.size(); ++i)
+          sum_ += x[i];
+      }
+
+      /**
+       * Recursively add the elements of the specified array to the
+       * sum.
+       *
+       * @tparam S type of elements
+       * @param xs array of terms
+       */
+      template <typename S>
+      void add(const std::vector<S>& xs) {
+        for (size_t i = 0; i < xs.size(); ++i)
+          add(xs[i]);
+      }
+
+      /**
+       * Return the sum of the terms added so far.
+       *
+       * @return sum of terms
+       */
+      double sum() const {
+        return sum_;
+      }
+    };
+
+    /**
+     * Return the current value of the log density, given the
+     * specified Jacobian terms and accumulated terms.  This is the
+     * value of the Stan function <code>target()</code>.
+     *
+     * @param lp Jacobian terms
+     * @param lp_accum accumulated terms
+     * @return log density
+     */
+    inline double get_lp(double lp, const value_accumulator& lp_accum) {
+      return lp + lp_accum.sum();
+    }
+
+    /**
+     * Metaprogram to compute the type of the accumulator used by a
+     * generated <code>log_prob</code> method with the specified
+     * scalar type.  It is <code>stan::math::accumulator</code> for
+     * autodiff types.
+     *
+     * @tparam T scalar type
+     */
+    template <typename T>
+    struct log_prob_accumulator {
+      typedef stan::math::accumulator<T> type;
+    };
+
+    /**
+     * Metaprogram to compute the type of the accumulator used by a
+     * generated <code>log_prob</code> method with <code>double</code>
+     * scalars, which evaluates the log density without autodiff.
+     */
+    template <>
+    struct log_prob_accumulator<double> {
+      typedef value_accumulator type;
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,84 @@
+#ifndef STAN_MODEL_MESSAGE_SINK_HPP
+#define STAN_MODEL_MESSAGE_SINK_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <sstream>
+#include <string>
+
+namespace stan {
+  namespace model {
+
+    /**
+     * A stream for the messages a model prints while it is evaluated,
+     * reused across evaluations.
+     *
+     * Each thread has one underlying stream (one per process unless
+     * compiled with <code>STAN_THREADS</code>, following the
+     * convention of the autodiff stack). A <code>message_sink</code>
+     * borrows it and empties it on construction and destruction, so
+     * evaluating a model that prints nothing constructs no stream and
+     * allocates nothing. Sinks must not be nested on one thread.
+     */
+    class message_sink {
+    public:
+      message_sink() : ss_(thread_stream()) {
+        clear();
+      }
+
+      ~message_sink() {
+        clear();
+      }
+
+      /**
+       * Return the stream to pass to the model.
+       *
+       * @return stream collecting messages
+       */
+      std::stringstream* stream() {
+        return &ss_;
+      }
+
+      /**
+       * Return true if nothing has been written since the stream was
+       * last emptied.
+       */
+      bool empty() {
+        return ss_.rdbuf()->in_avail() <= 0;
+      }
+
+      /**
+       * Log any messages with info level and empty the stream.
+       *
+       * @param[in,out] logger logger to write to
+       */
+      void log_info(callbacks::logger& logger) {
+        if (!empty())
+          logger.info(ss_);
+        clear();
+      }
+
+    private:
+      std::stringstream& ss_;
+
+      message_sink(const message_sink&);
+      message_sink& operator=(const message_sink&);
+
+      void clear() {
+        if (!empty())
+          ss_.str(std::string());
+        ss_.clear();
+      }
+
+      static std::stringstream& thread_stream() {
+#ifdef STAN_THREADS
+        static thread_local std::stringstream ss;
+#else
+        static std::stringstream ss;
+#endif
+        return ss;
+      }
+    };
+
+  }
+}
+#endif
@@ -9,6 +9,7 @@
 #include <stan/io/writer.hpp>
 
 #include <stan/lang/rethrow_located.hpp>
+#include <stan/model/log_prob_accumulator.hpp>
 #include <stan/model/model_base.hpp>
 #include <stan/model/model_base_crtp.hpp>
 #include <stan/model/prob_grad.hpp>
@@ -13,6 +13,7 @@
 #include <stan/services/util/create_rng.hpp>
 #include <stan/services/util/initialize.hpp>
 #include <stan/services/util/inv_metric.hpp>
+#include <stan/services/util/parallel_for.hpp>
 #include <vector>
 
 namespace stan {
@@ -175,6 +176,135 @@ namespace stan {
                                       diagnostic_writer);
       }
 
+      /**
+       * Runs <code>num_chains</code> chains of HMC with NUTS with
+       * adaptation using dense Euclidean metric with pre-specified
+       * Euclidean metrics.
+       *
+       * All chains share the model instance and its data. Chain
+       * <code>n</code> uses the pseudo random number generator
+       * <code>create_rng(random_seed, init_chain_id + n)</code>, so
+       * its draws match those of the single chain service called with
+       * <code>chain = init_chain_id + n</code>.
+       *
+       * Initialization and metric validation are done for every chain
+       * on the calling thread before any sampling starts. The chains
+       * are then run concurrently on up to <code>STAN_NUM_THREADS</code>
+       * threads (see <code>util::get_num_threads</code>); without
+       * <code>STAN_THREADS</code> defined they run one after another.
+       * The interrupt and logger are shared between chains and must be
+       * safe to call concurrently when more than one thread is used.
+       *
+       * @tparam Model Model class
+       * @param[in] model Input model to test (with data already instantiated)
+       * @param[in] num_chains number of chains to run
+       * @param[in] init var contexts for initialization, one per chain
+       * @param[in] init_inv_metric var contexts exposing an initial dense
+                    inverse Euclidean metric (must be positive definite),
+                    one per chain
+       * @param[in] random_seed random seed for the random number generator
+       * @param[in] init_chain_id chain id of the first chain
+       * @param[in] init_radius radius to initialize
+       * @param[in] num_warmup Number of warmup samples
+       * @param[in] num_samples Number of samples
+       * @param[in] num_thin Number to thin the samples
+       * @param[in] save_warmup Indicates whether to save the warmup iterations
+       * @param[in] refresh Controls the output
+       * @param[in] stepsize initial stepsize for discrete evolution
+       * @param[in] stepsize_jitter uniform random jitter of stepsize
+       * @param[in] max_depth Maximum tree depth
+       * @param[in] delta adaptation target acceptance statistic
+       * @param[in] gamma adaptation regularization scale
+       * @param[in] kappa adaptation relaxation exponent
+       * @param[in] t0 adaptation iteration offset
+       * @param[in] init_buffer width of initial fast adaptation interval
+       * @param[in] term_buffer width of final fast adaptation interval
+       * @param[in] window initial width of slow adaptation interval
+       * @param[in,out] interrupt Callback for interrupts
+       * @param[in,out] logger Logger for messages
+       * @param[in,out] init_writer Writer callbacks for unconstrained inits,
+                        one per chain
+       * @param[in,out] sample_writer Writers for draws, one per chain
+       * @param[in,out] diagnostic_writer Writers for diagnostic information,
+                        one per chain
+       * @return error_codes::OK if successful
+       */
+      template <class Model>
+      int hmc_nuts_dense_e_adapt(
+          Model& model, size_t num_chains,
+          const std::vector<stan::io::var_context*>& init,
+          const std::vector<stan::io::var_context*>& init_inv_metric,
+          unsigned int random_seed, unsigned int init_chain_id,
+          double init_radius, int num_warmup, int num_samples, int num_thin,
+          bool save_warmup, int refresh, double stepsize,
+          double stepsize_jitter, int max_depth, double delta, double gamma,
+          double kappa, double t0, unsigned int init_buffer,
+          unsigned int term_buffer, unsigned int window,
+          callbacks::interrupt& interrupt, callbacks::logger& logger,
+          const std::vector<callbacks::writer*>& init_writer,
+          const std::vector<callbacks::writer*>& sample_writer,
+          const std::vector<callbacks::writer*>& diagnostic_writer) {
+        if (init.size() != num_chains
+            || init_inv_metric.size() != num_chains
+            || init_writer.size() != num_chains
+            || sample_writer.size() != num_chains
+            || diagnostic_writer.size() != num_chains) {
+          logger.error("Number of init contexts, metrics and writers"
+                       " must match the number of chains.");
+          return error_codes::USAGE;
+        }
+
+        std::vector<boost::ecuyer1988> rngs;
+        rngs.reserve(num_chains);
+        std::vector<std::vector<double> > cont_vectors;
+        cont_vectors.reserve(num_chains);
+        std::vector<Eigen::MatrixXd> inv_metrics;
+        inv_metrics.reserve(num_chains);
+        for (size_t n = 0; n < num_chains; ++n) {
+          rngs.push_back(util::create_rng(random_seed, init_chain_id + n));
+          cont_vectors.push_back(
+              util::initialize(model, *init[n], rngs[n], init_radius, true,
+                               logger, *init_writer[n]));
+          try {
+            inv_metrics.push_back(
+                util::read_dense_inv_metric(*init_inv_metric[n],
+                                              model.num_params_r(), logger));
+            util::validate_dense_inv_metric(inv_metrics[n], logger);
+          } catch (const std::domain_error& e) {
+            return error_codes::CONFIG;
+          }
+        }
+
+        util::parallel_for(num_chains, util::get_num_threads(num_chains),
+                           [&](size_t n) {
+          stan::mcmc::adapt_dense_e_nuts<Model, boost::ecuyer1988>
+            sampler(model, rngs[n]);
+
+          sampler.set_metric(inv_metrics[n]);
+          sampler.set_nominal_stepsize(stepsize);
+          sampler.set_stepsize_jitter(stepsize_jitter);
+          sampler.set_max_depth(max_depth);
+
+          sampler.get_stepsize_adaptation().set_mu(log(10 * stepsize));
+          sampler.get_stepsize_adaptation().set_delta(delta);
+          sampler.get_stepsize_adaptation().set_gamma(gamma);
+          sampler.get_stepsize_adaptation().set_kappa(kappa);
+          sampler.get_stepsize_adaptation().set_t0(t0);
+
+          sampler.set_window_params(num_warmup, init_buffer, term_buffer,
+                                    window, logger);
+
+          util::run_adaptive_sampler(sampler, model, cont_vectors[n],
+                                     num_warmup, num_samples, num_thin,
+                                     refresh, save_warmup, rngs[n],
+                                     interrupt, logger,
+                                     *sample_writer[n],
+                                     *diagnostic_writer[n]);
+        });
+
+        return error_codes::OK;
+      }
+
     }
   }
 }
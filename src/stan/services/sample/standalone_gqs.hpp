@@ -8,7 +8,11 @@
 #include <stan/services/error_codes.hpp>
 #include <stan/services/util/create_rng.hpp>
 #include <stan/services/util/gq_writer.hpp>
+#include <stan/services/util/parallel_for.hpp>
+#include <boost/random/additive_combine.hpp>
 #include <Eigen/Dense>
+#include <algorithm>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -127,6 +131,148 @@ int standalone_generate(const Model &model,
   return error_codes::OK;
 }
 
+/**
+ * Given a set of draws from a fitted model, generate corresponding
+ * quantities of interest using up to the specified number of threads,
+ * and write them to the callback writer.
+ *
+ * Each draw uses its own pseudo random number generator, derived from
+ * the seed by <code>util::create_rng(seed, 1)</code> advanced by
+ * floor(pow(2, 50) / N) times the index of the draw, where N is the
+ * number of draws.  All draws thus stay within the pow(2, 50) numbers
+ * between chain 1's and chain 2's offsets in <code>create_rng</code>,
+ * and each draw has at least pow(2, 20) numbers to itself for up to
+ * pow(2, 30) draws.  The generated quantities of a draw do not depend
+ * on the number of threads or the order in which the draws are
+ * processed.  Draws are processed in blocks; the
+ * results of a block, including messages from the model, are written
+ * in the order of the draws, so the output is identical for any
+ * number of threads.  The interrupt is called once per block.
+ *
+ * The random numbers differ from those of the single threaded
+ * overload, which uses one generator for all draws.
+ *
+ * @tparam Model model class
+ * @param[in] model instantiated model
+ * @param[in] draws sequence of draws of constrained parameters
+ * @param[in] seed seed to use for randomization
+ * @param[in] num_threads maximum number of threads to use; see
+ *   <code>util::get_num_threads</code>
+ * @param[in, out] interrupt called every block of draws
+ * @param[in, out] logger logger to which to write warning and error messages
+ * @param[in, out] sample_writer writer to which draws are written
+ * @return error code
+ */
+template <class Model>
+int standalone_generate(const Model &model,
+                        const Eigen::MatrixXd& draws,
+                        unsigned int seed, size_t num_threads,
+                        callbacks::interrupt &interrupt,
+                        callbacks::logger &logger,
+                        callbacks::writer &sample_writer) {
+  if (draws.size() == 0) {
+    logger.error("Empty set of draws from fitted model.");
+    return error_codes::DATAERR;
+  }
+
+  std::vector<std::string> p_names;
+  model.constrained_param_names(p_names, false, false);
+  std::vector<std::string> gq_names;
+  model.constrained_param_names(gq_names, false, true);
+  if (!(p_names.size() < gq_names.size())) {
+    logger.error("Model doesn't generate any quantities of interest.");
+    return error_codes::CONFIG;
+  }
+
+  if (p_names.size() != draws.cols()) {
+    std::stringstream msg;
+    msg << "Wrong number of parameter values in draws from fitted model.  ";
+    msg << "Expecting " << p_names.size() << " columns, ";
+    msg << "found " << draws.cols() << " columns.";
+    std::string msgstr = msg.str();
+    logger.error(msgstr);
+    return error_codes::DATAERR;
+  }
+  util::gq_writer writer(sample_writer, logger, p_names.size());
+  writer.write_gq_names(model);
+
+  std::vector<std::string> param_names;
+  std::vector<std::vector<size_t>> param_dimss;
+  get_model_parameters(model, param_names, param_dimss);
+
+  // results of one draw, kept until the draw is written in order
+  struct gq_result {
+    bool transform_ok;
+    bool write_ok;
+    std::string transform_message;
+    std::string write_message;
+    std::string error;
+    std::vector<int> params_i;
+    std::vector<double> params_r;
+    std::vector<double> values;
+  };
+
+  if (num_threads < 1)
+    num_threads = 1;
+  const size_t num_draws = draws.rows();
+  // keep every draw's stream below create_rng's offset for chain 2
+  const boost::uintmax_t draw_stride
+      = (static_cast<boost::uintmax_t>(1) << 50) / num_draws;
+  const boost::ecuyer1988 base_rng = util::create_rng(seed, 1);
+  const size_t block_size = 64 * num_threads;
+  std::vector<gq_result> results(std::min(block_size, num_draws));
+
+  for (size_t begin = 0; begin < num_draws; begin += block_size) {
+    const size_t end = std::min(begin + block_size, num_draws);
+    interrupt();   // call out to interrupt and fail
+    util::parallel_for(end - begin, num_threads, [&](size_t n) {
+      gq_result& result = results[n];
+      const size_t i = begin + n;
+      std::stringstream msg;
+      result.transform_ok = false;
+      result.write_ok = false;
+      result.error.clear();
+      result.write_message.clear();
+      result.params_i.clear();
+      result.params_r.clear();
+      try {
+        stan::io::array_var_context context(param_names, draws.row(i),
+                                            param_dimss);
+        model.transform_inits(context, result.params_i, result.params_r,
+                              &msg);
+        result.transform_ok = true;
+      } catch (const std::exception& e) {
+        result.error = e.what();
+      }
+      result.transform_message = msg.str();
+      if (!result.transform_ok)
+        return;
+
+      boost::ecuyer1988 rng = base_rng;
+      rng.discard(draw_stride * i);
+      msg.str("");
+      msg.clear();
+      result.write_ok = util::gq_writer::generate_values(
+          model, rng, result.params_r, result.params_i, result.values, &msg,
+          result.error);
+      result.write_message = msg.str();
+    });
+
+    for (size_t n = 0; n < end - begin; ++n) {
+      const gq_result& result = results[n];
+      if (!result.transform_ok) {
+        if (result.transform_message.length() > 0)
+          logger.error(result.transform_message);
+        logger.error(result.error);
+        return error_codes::DATAERR;
+      }
+      writer.write_generated_values(result.write_ok, result.write_message,
+                                    result.error, result.values);
+    }
+  }
+  return error_codes::OK;
+}
+
 }   // namespace services
 }   // namespace stan
 #endif
@@ -26,6 +26,25 @@ namespace stan {
         callbacks::logger& logger_;
         int num_constrained_params_;
 
+        /**
+         * Buffers reused across draws so that writing a draw does not
+         * allocate once they have reached their final size.
+         */
+        std::vector<double> values_;
+        std::vector<int> params_i_;  // unused - no discrete params
+        std::vector<double> gq_values_;
+
+        /**
+         * Stream for messages printed by the model, cleared after each
+         * draw.
+         */
+        std::stringstream message_ss_;
+
+        /**
+         * Exception message of the last failed draw.
+         */
+        std::string error_;
+
       public:
         /**
          * Constructor.
@@ -57,6 +76,66 @@ namespace stan {
           sample_writer_(gq_names);
         }
 
+        /**
+         * Calls model's `write_array` method to compute the values of
+         * all variables, including those defined in the generated
+         * quantities block.  Does not touch the writer or the logger,
+         * so it may be called concurrently for different draws as
+         * long as each call has its own RNG and buffers.
+         *
+         * @tparam M model class
+         * @tparam RNG pseudo random number generator class
+         * @param[in] model instantiated model
+         * @param[in] rng instantiated RNG
+         * @param[in] params_r unconstrained parameters values
+         * @param[in] params_i integer parameters values
+         * @param[out] values constrained values of all variables
+         * @param[in, out] msgs stream for messages printed by the model
+         * @param[out] error exception message if `write_array` throws
+         * @return true if the values were computed
+         */
+        template <class Model, class RNG>
+        static bool generate_values(const Model& model,
+                                    RNG& rng,
+                                    std::vector<double>& params_r,
+                                    std::vector<int>& params_i,
+                                    std::vector<double>& values,
+                                    std::ostream* msgs,
+                                    std::string& error) {
+          try {
+            model.write_array(rng, params_r, params_i, values, false, true,
+                              msgs);
+          } catch (const std::exception& e) {
+            error = e.what();
+            return false;
+          }
+          return true;
+        }
+
+        /**
+         * Logs the messages from one call to `generate_values` and, if
+         * it succeeded, writes the values of variables defined in the
+         * generated quantities block to stream `sample_writer_`.
+         *
+         * @param[in] ok return value of `generate_values`
+         * @param[in] message messages printed by the model
+         * @param[in] error exception message if `ok` is false
+         * @param[in] values constrained values of all variables
+         */
+        void write_generated_values(bool ok, const std::string& message,
+                                    const std::string& error,
+                                    const std::vector<double>& values) {
+          if (message.length() > 0)
+            logger_.info(message);
+          if (!ok) {
+            logger_.info(error);
+            return;
+          }
+          gq_values_.assign(values.begin() + num_constrained_params_,
+                            values.end());
+          sample_writer_(gq_values_);
+        }
+
         /**
          * Calls model's `write_array` method and writes values of
          * variables defined in the generated quantities block
@@ -72,30 +151,14 @@ namespace stan {
         void write_gq_values(const Model& model,
                              RNG& rng,
                              const std::vector<double>& draw) {
-          std::vector<double> values;
-          std::vector<int> params_i;  // unused - no discrete params
-          std::stringstream ss;
-          try {
-            model.write_array(rng,
-                              const_cast<std::vector<double>&>(draw),
-                              params_i,
-                              values,
-                              false,
-                              true,
-                              &ss);
-          } catch (const std::exception& e) {
-            if (ss.str().length() > 0)
-              logger_.info(ss);
-            logger_.info(e.what());
-            return;
-          }
-          if (ss.str().length() > 0)
-            logger_.info(ss);
-
-          std::vector<double> gq_values(values.begin()
-                                        + num_constrained_params_,
-                                        values.end());
-          sample_writer_(gq_values);
+          values_.clear();
+          message_ss_.str("");
+          message_ss_.clear();
+          bool ok = generate_values(model, rng,
+                                    const_cast<std::vector<double>&>(draw),
+                                    params_i_, values_, &message_ss_,
+                                    error_);
+          write_generated_values(ok, message_ss_.str(), error_, values_);
         }
       };
 
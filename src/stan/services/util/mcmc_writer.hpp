@@ -6,6 +6,8 @@
 #include <stan/mcmc/base_mcmc.hpp>
 #include <stan/mcmc/sample.hpp>
 #include <stan/model/prob_grad.hpp>
+#include <stan/services/util/sampler_timing.hpp>
+#include <chrono>
 #include <iomanip>
 #include <limits>
 #include <sstream>
@@ -27,6 +29,33 @@ class mcmc_writer {
   callbacks::writer& diagnostic_writer_;
   callbacks::logger& logger_;
 
+  /**
+   * Buffers reused across draws so that writing a draw does not
+   * allocate once they have reached their final size.
+   */
+  std::vector<double> values_;
+  std::vector<double> model_values_;
+  std::vector<double> cont_params_;
+  std::vector<int> params_i_;
+  std::vector<double> diagnostic_values_;
+
+  /**
+   * Stream for messages printed by the model, cleared after each
+   * draw.
+   */
+  std::stringstream message_ss_;
+
+  /**
+   * Wall time in seconds spent in the sample and diagnostic writers
+   */
+  double writer_time_;
+
+  typedef std::chrono::steady_clock clock;
+
+  double seconds_since(const clock::time_point& start) const {
+    return std::chrono::duration<double>(clock::now() - start).count();
+  }
+
  public:
   size_t num_sample_params_;
   size_t num_sampler_params_;
@@ -45,6 +74,7 @@ class mcmc_writer {
       : sample_writer_(sample_writer),
         diagnostic_writer_(diagnostic_writer),
         logger_(logger),
+        writer_time_(0),
         num_sample_params_(0),
         num_sampler_params_(0),
         num_model_params_(0) {
@@ -102,42 +132,43 @@ class mcmc_writer {
                            stan::mcmc::sample& sample,
                            stan::mcmc::base_mcmc& sampler,
                            Model& model) {
-    std::vector<double> values;
-
-    sample.get_sample_params(values);
-    sampler.get_sampler_params(values);
-
-    std::vector<double> model_values;
-    std::vector<int> params_i;
-    std::stringstream ss;
+    values_.clear();
+    sample.get_sample_params(values_);
+    sampler.get_sampler_params(values_);
+
+    model_values_.clear();
+    cont_params_.assign(sample.cont_params().data(),
+                        sample.cont_params().data()
+                        + sample.cont_params().size());
+    message_ss_.str("");
+    message_ss_.clear();
     try {
-      std::vector<double> cont_params(sample.cont_params().data(),
-                                      sample.cont_params().data()
-                                      + sample.cont_params().size());
       model.write_array(rng,
-                        cont_params,
-                        params_i,
-                        model_values,
+                        cont_params_,
+                        params_i_,
+                        model_values_,
                         true, true,
-                        &ss);
+                        &message_ss_);
     } catch (const std::exception& e) {
-      if (ss.str().length() > 0)
-        logger_.info(ss);
-      ss.str("");
+      if (message_ss_.str().length() > 0)
+        logger_.info(message_ss_);
+      message_ss_.str("");
       logger_.info(e.what());
     }
-    if (ss.str().length() > 0)
-      logger_.info(ss);
-
-    if (model_values.size() > 0)
-      values.insert(values.end(), model_values.begin(), model_values.end());
-    if (model_values.size() < num_model_params_)
-      values.insert(values.end(),
-                    num_model_params_ - model_values.size(),
-                    std::numeric_limits<double>::quiet_NaN());
-
-
-    sample_writer_(values);
+    if (message_ss_.str().length() > 0)
+      logger_.info(message_ss_);
+
+    if (model_values_.size() > 0)
+      values_.insert(values_.end(), model_values_.begin(),
+                     model_values_.end());
+    if (model_values_.size() < num_model_params_)
+      values_.insert(values_.end(),
+                     num_model_params_ - model_values_.size(),
+                     std::numeric_limits<double>::quiet_NaN());
+
+    clock::time_point start = clock::now();
+    sample_writer_(values_);
+    writer_time_ += seconds_since(start);
   }
 
   /**
@@ -183,13 +214,14 @@ class mcmc_writer {
    */
   void write_diagnostic_params(stan::mcmc::sample& sample,
                                stan::mcmc::base_mcmc& sampler) {
-    std::vector<double> values;
-
-    sample.get_sample_params(values);
-    sampler.get_sampler_params(values);
-    sampler.get_sampler_diagnostics(values);
-
-    diagnostic_writer_(values);
+    diagnostic_values_.clear();
+    sample.get_sample_params(diagnostic_values_);
+    sampler.get_sampler_params(diagnostic_values_);
+    sampler.get_sampler_diagnostics(diagnostic_values_);
+
+    clock::time_point start = clock::now();
+    diagnostic_writer_(diagnostic_values_);
+    writer_time_ += seconds_since(start);
   }
 
   /**
@@ -265,6 +297,100 @@ class mcmc_writer {
     write_timing(warmDeltaT, sampleDeltaT, diagnostic_writer_);
     log_timing(warmDeltaT, sampleDeltaT);
   }
+
+  /**
+   * Returns the wall time spent writing draws and diagnostics.
+   *
+   * @return time in seconds spent in the sample and diagnostic
+   *   writers since construction
+   */
+  double writer_time() const {
+    return writer_time_;
+  }
+
+  /**
+   * Internal method
+   *
+   * Formats the CPU time and work counters of a run, one line per
+   * quantity.
+   *
+   * @param[in] timing time and work of the run
+   * @return lines of text
+   */
+  std::vector<std::string> timing_details(const sampler_timing& timing) {
+    const phase_timing& w = timing.warmup;
+    const phase_timing& s = timing.sampling;
+    std::vector<std::string> lines;
+    std::stringstream ss;
+    ss << " CPU Time: " << w.cpu_time << " seconds warm-up, "
+       << s.cpu_time << " seconds sampling";
+    lines.push_back(ss.str());
+    ss.str("");
+    ss << " Gradient evaluations: " << w.counters.n_gradient
+       << " warm-up, " << s.counters.n_gradient << " sampling";
+    lines.push_back(ss.str());
+    ss.str("");
+    ss << " Leapfrog steps: " << w.counters.n_leapfrog
+       << " warm-up, " << s.counters.n_leapfrog << " sampling";
+    lines.push_back(ss.str());
+    ss.str("");
+    ss << " Log density time: " << w.counters.log_prob_time
+       << " seconds warm-up, " << s.counters.log_prob_time
+       << " seconds sampling";
+    lines.push_back(ss.str());
+    ss.str("");
+    ss << " Writer time: " << w.writer_time << " seconds warm-up, "
+       << s.writer_time << " seconds sampling";
+    lines.push_back(ss.str());
+    return lines;
+  }
+
+  /**
+   * Internal method
+   *
+   * Prints timing information and work counters. The elapsed wall
+   * time is written in the same format as by
+   * <code>write_timing(double, double, callbacks::writer&)</code>,
+   * followed by the CPU time and the counters.
+   *
+   * @param[in] timing time and work of the run
+   * @param[in,out] writer output stream
+   */
+  void write_timing(const sampler_timing& timing,
+                    callbacks::writer& writer) {
+    write_timing(timing.warmup.wall_time, timing.sampling.wall_time,
+                 writer);
+    std::vector<std::string> lines = timing_details(timing);
+    for (size_t n = 0; n < lines.size(); ++n)
+      writer(lines[n]);
+    writer();
+  }
+
+  /**
+   * Internal method
+   *
+   * Logs timing information and work counters
+   *
+   * @param[in] timing time and work of the run
+   */
+  void log_timing(const sampler_timing& timing) {
+    log_timing(timing.warmup.wall_time, timing.sampling.wall_time);
+    std::vector<std::string> lines = timing_details(timing);
+    for (size_t n = 0; n < lines.size(); ++n)
+      logger_.info(lines[n]);
+    logger_.info("");
+  }
+
+  /**
+   * Print timing information and work counters to all streams
+   *
+   * @param[in] timing time and work of the run
+   */
+  void write_timing(const sampler_timing& timing) {
+    write_timing(timing, sample_writer_);
+    write_timing(timing, diagnostic_writer_);
+    log_timing(timing);
+  }
 };
 
 }
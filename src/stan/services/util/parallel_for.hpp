@@ -0,0 +1,141 @@
+#ifndef STAN_SERVICES_UTIL_PARALLEL_FOR_HPP
+#define STAN_SERVICES_UTIL_PARALLEL_FOR_HPP
+
+#include <boost/lexical_cast.hpp>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifdef STAN_THREADS
+#include <atomic>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace stan {
+  namespace services {
+    namespace util {
+
+      /**
+       * Returns the number of threads to use for running
+       * <code>num_jobs</code> independent jobs.
+       *
+       * The number of threads is read from the environment variable
+       * <code>STAN_NUM_THREADS</code>, following the convention of
+       * the math library: a positive integer requests that many
+       * threads and -1 requests one thread per hardware core. If the
+       * variable is not set, a single thread is used. The result is
+       * never larger than <code>num_jobs</code>.
+       *
+       * Unless the code is compiled with <code>STAN_THREADS</code>
+       * defined, the autodiff stack is not thread local and this
+       * function always returns 1.
+       *
+       * @param[in] num_jobs number of independent jobs
+       * @return number of threads to use
+       * @throw std::invalid_argument if <code>STAN_NUM_THREADS</code>
+       *   is not a positive integer or -1
+       */
+      inline size_t get_num_threads(size_t num_jobs) {
+        size_t num_threads = 1;
+#ifdef STAN_THREADS
+        const char* env_num_threads = std::getenv("STAN_NUM_THREADS");
+        if (env_num_threads != 0) {
+          int env_value;
+          try {
+            env_value = boost::lexical_cast<int>(env_num_threads);
+          } catch (const boost::bad_lexical_cast& e) {
+            throw std::invalid_argument(
+                std::string("STAN_NUM_THREADS must be a positive integer"
+                            " or -1, found ") + env_num_threads);
+          }
+          if (env_value == -1) {
+            num_threads = std::thread::hardware_concurrency();
+          } else if (env_value > 0) {
+            num_threads = env_value;
+          } else {
+            throw std::invalid_argument(
+                std::string("STAN_NUM_THREADS must be a positive integer"
+                            " or -1, found ") + env_num_threads);
+          }
+        }
+#endif
+        if (num_threads > num_jobs)
+          num_threads = num_jobs;
+        if (num_threads < 1)
+          num_threads = 1;
+        return num_threads;
+      }
+
+      /**
+       * Calls <code>f(n)</code> for each <code>n</code> in
+       * <code>[0, num_jobs)</code> using up to <code>num_threads</code>
+       * threads.
+       *
+       * Jobs are handed out dynamically: each worker claims the next
+       * unstarted job when it finishes its current one, so long jobs
+       * do not hold up idle threads. The calling thread takes part in
+       * the work. With a single thread, or without
+       * <code>STAN_THREADS</code> defined, the jobs run in order on
+       * the calling thread.
+       *
+       * If any job throws, no further jobs are started and the first
+       * exception is rethrown on the calling thread once all running
+       * jobs have finished.
+       *
+       * @tparam F type of functor, callable with a <code>size_t</code>
+       * @param[in] num_jobs number of jobs
+       * @param[in] num_threads maximum number of threads to use
+       * @param[in] f functor called once per job; must be safe to call
+       *   concurrently for distinct job indices
+       */
+      template <typename F>
+      void parallel_for(size_t num_jobs, size_t num_threads, const F& f) {
+#ifdef STAN_THREADS
+        if (num_threads > num_jobs)
+          num_threads = num_jobs;
+        if (num_threads > 1) {
+          std::atomic<size_t> next_job(0);
+          std::atomic<bool> failed(false);
+          std::exception_ptr first_exception;
+          std::mutex exception_mutex;
+
+          auto worker = [&]() {
+            while (!failed) {
+              size_t n = next_job++;
+              if (n >= num_jobs)
+                return;
+              try {
+                f(n);
+              } catch (...) {
+                std::lock_guard<std::mutex> lock(exception_mutex);
+                if (!failed) {
+                  first_exception = std::current_exception();
+                  failed = true;
+                }
+              }
+            }
+          };
+
+          std::vector<std::thread> threads;
+          threads.reserve(num_threads - 1);
+          for (size_t t = 1; t < num_threads; ++t)
+            threads.emplace_back(worker);
+          worker();
+          for (size_t t = 0; t < threads.size(); ++t)
+            threads[t].join();
+
+          if (first_exception)
+            std::rethrow_exception(first_exception);
+          return;
+        }
+#endif
+        for (size_t n = 0; n < num_jobs; ++n)
+          f(n);
+      }
+
+    }
+  }
+}
+#endif
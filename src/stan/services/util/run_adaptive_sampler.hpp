@@ -5,7 +5,7 @@
 #include <stan/callbacks/writer.hpp>
 #include <stan/services/util/generate_transitions.hpp>
 #include <stan/services/util/mcmc_writer.hpp>
-#include <ctime>
+#include <stan/services/util/sampler_timing.hpp>
 #include <vector>
 
 namespace stan {
@@ -33,6 +33,8 @@ namespace stan {
        * @param[in,out] logger logger for messages
        * @param[in,out] sample_writer writer for draws
        * @param[in,out] diagnostic_writer writer for diagnostic information
+       * @param[out] timing if not null, set to the time and work of the
+       *   warmup and sampling phases
        */
       template <class Sampler, class Model, class RNG>
       void run_adaptive_sampler(Sampler& sampler, Model& model,
@@ -43,7 +45,8 @@ namespace stan {
                                 callbacks::interrupt& interrupt,
                                 callbacks::logger& logger,
                                 callbacks::writer& sample_writer,
-                                callbacks::writer& diagnostic_writer) {
+                                callbacks::writer& diagnostic_writer,
+                                sampler_timing* timing = 0) {
         Eigen::Map<Eigen::VectorXd> cont_params(cont_vector.data(),
                                                 cont_vector.size());
 
@@ -65,32 +68,32 @@ namespace stan {
         writer.write_sample_names(s, sampler, model);
         writer.write_diagnostic_names(s, sampler, model);
 
-        clock_t start = clock();
+        sampler_timing run_timing;
+        phase_timer warmup_timer(sampler, writer.writer_time());
         util::generate_transitions(sampler, num_warmup, 0,
                                    num_warmup + num_samples, num_thin,
                                    refresh, save_warmup, true,
                                    writer,
                                    s, model, rng,
                                    interrupt, logger);
-        clock_t end = clock();
-        double warm_delta_t = static_cast<double>(end - start) / CLOCKS_PER_SEC;
+        warmup_timer.stop(writer.writer_time(), run_timing.warmup);
 
         sampler.disengage_adaptation();
         writer.write_adapt_finish(sampler);
         sampler.write_sampler_state(sample_writer);
 
-        start = clock();
+        phase_timer sampling_timer(sampler, writer.writer_time());
         util::generate_transitions(sampler, num_samples, num_warmup,
                                    num_warmup + num_samples, num_thin,
                                    refresh, true, false,
                                    writer,
                                    s, model, rng,
                                    interrupt, logger);
-        end = clock();
-        double sample_delta_t
-          = static_cast<double>(end - start) / CLOCKS_PER_SEC;
+        sampling_timer.stop(writer.writer_time(), run_timing.sampling);
 
-        writer.write_timing(warm_delta_t, sample_delta_t);
+        writer.write_timing(run_timing);
+        if (timing)
+          *timing = run_timing;
       }
     }
   }
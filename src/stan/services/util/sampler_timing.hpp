@@ -0,0 +1,118 @@
+#ifndef STAN_SERVICES_UTIL_SAMPLER_TIMING_HPP
+#define STAN_SERVICES_UTIL_SAMPLER_TIMING_HPP
+
+#include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/sampler_counters.hpp>
+#include <time.h>
+#include <chrono>
+#include <ctime>
+
+namespace stan {
+namespace services {
+namespace util {
+
+/**
+ * Time and work of one phase (warmup or sampling) of a run.
+ */
+struct phase_timing {
+  /**
+   * Elapsed wall time in seconds
+   */
+  double wall_time;
+
+  /**
+   * CPU time in seconds used by the thread running the sampler, so
+   * chains run concurrently are not charged for each other's work;
+   * process CPU time where per-thread time is not available
+   */
+  double cpu_time;
+
+  /**
+   * Wall time in seconds spent in the sample and diagnostic writers
+   */
+  double writer_time;
+
+  /**
+   * Work done by the sampler during the phase
+   */
+  stan::mcmc::sampler_counters counters;
+
+  phase_timing() : wall_time(0), cpu_time(0), writer_time(0) {}
+};
+
+/**
+ * Return the CPU time in seconds used by the calling thread, or by
+ * the process where per-thread CPU time is not available.
+ *
+ * @return CPU time in seconds
+ */
+inline double thread_cpu_time() {
+#ifdef CLOCK_THREAD_CPUTIME_ID
+  timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+#endif
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Time and work of the warmup and sampling phases of a run.
+ */
+struct sampler_timing {
+  phase_timing warmup;
+  phase_timing sampling;
+};
+
+/**
+ * Measures a phase of a run: wall and CPU time, and the change in
+ * the sampler's counters and in the time spent writing.
+ */
+class phase_timer {
+ public:
+  /**
+   * Starts timing a phase.
+   *
+   * @param[in,out] sampler sampler whose counters are read
+   * @param[in] writer_time time spent writing before the phase
+   */
+  phase_timer(stan::mcmc::base_mcmc& sampler, double writer_time)
+      : sampler_(sampler),
+        wall_start_(std::chrono::steady_clock::now()),
+        cpu_start_(thread_cpu_time()),
+        writer_start_(writer_time) {
+    sampler_.get_sampler_counters(counters_start_);
+  }
+
+  /**
+   * Stops timing the phase.
+   *
+   * @param[in] writer_time time spent writing at the end of the phase
+   * @param[out] timing time and work of the phase
+   */
+  void stop(double writer_time, phase_timing& timing) {
+    timing.cpu_time = thread_cpu_time() - cpu_start_;
+    timing.wall_time = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - wall_start_).count();
+    timing.writer_time = writer_time - writer_start_;
+
+    stan::mcmc::sampler_counters end;
+    sampler_.get_sampler_counters(end);
+    timing.counters.n_leapfrog = end.n_leapfrog - counters_start_.n_leapfrog;
+    timing.counters.n_gradient = end.n_gradient - counters_start_.n_gradient;
+    timing.counters.n_log_prob = end.n_log_prob - counters_start_.n_log_prob;
+    timing.counters.log_prob_time
+        = end.log_prob_time - counters_start_.log_prob_time;
+  }
+
+ private:
+  stan::mcmc::base_mcmc& sampler_;
+  std::chrono::steady_clock::time_point wall_start_;
+  double cpu_start_;
+  double writer_start_;
+  stan::mcmc::sampler_counters counters_start_;
+};
+
+}
+}
+}
+#endif
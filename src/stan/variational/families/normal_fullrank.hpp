@@ -4,6 +4,7 @@
 #include <stan/callbacks/logger.hpp>
 #include <stan/math/prim/mat.hpp>
 #include <stan/model/gradient.hpp>
+#include <stan/model/message_sink.hpp>
 #include <stan/variational/base_family.hpp>
 #include <algorithm>
 #include <ostream>
@@ -445,10 +446,9 @@ namespace stan {
           }
           zeta = transform(eta);
           try {
-            std::stringstream ss;
-            stan::model::gradient(m, zeta, tmp_lp, tmp_mu_grad, &ss);
-            if (ss.str().length() > 0)
-              logger.info(ss);
+            stan::model::message_sink msgs;
+            stan::model::gradient(m, zeta, tmp_lp, tmp_mu_grad, msgs.stream());
+            msgs.log_info(logger);
             stan::math::check_finite(function, "Gradient of mu", tmp_mu_grad);
 
             mu_grad += tmp_mu_grad;
@@ -0,0 +1,65 @@
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat.hpp>
+#include <stan/analyze/mcmc/autocovariance.hpp>
+#include <stan/analyze/mcmc/autocovariance_engine.hpp>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <vector>
+
+class AutocovarianceEngine : public testing::Test {
+public:
+  void SetUp() {
+    // ar1.csv generated in R with
+    //   > x[1] <- rnorm(1, 0, 1)
+    //   > for (n in 2:1000) x[n] <- rnorm(1, 0.8 * x[n-1], 1)
+    std::fstream f("src/test/unit/analyze/mcmc/ar1.csv");
+    y.resize(1000);
+    for (int i = 0; i < y.size(); ++i)
+      f >> y(i);
+  }
+
+  Eigen::VectorXd y;
+};
+
+TEST_F(AutocovarianceEngine, matches_autocovariance) {
+  stan::analyze::autocovariance_engine<double> engine;
+  Eigen::VectorXd expected;
+  stan::analyze::autocovariance<double>(y, expected);
+
+  Eigen::VectorXd acov;
+  engine.autocovariance(y, acov);
+  ASSERT_EQ(1000, acov.size());
+  for (int i = 0; i < acov.size(); ++i)
+    EXPECT_NEAR(expected(i), acov(i), 1e-12);
+
+  // reuse with a different length, then the first length again
+  Eigen::VectorXd short_y = y.head(7);
+  Eigen::VectorXd short_expected;
+  stan::analyze::autocovariance<double>(short_y, short_expected);
+  engine.autocovariance(short_y, acov);
+  ASSERT_EQ(7, acov.size());
+  for (int i = 0; i < acov.size(); ++i)
+    EXPECT_NEAR(short_expected(i), acov(i), 1e-12);
+
+  engine.autocorrelation(y, acov);
+  EXPECT_FLOAT_EQ(1, acov(0));
+  for (int i = 0; i < acov.size(); ++i)
+    EXPECT_NEAR(expected(i) / expected(0), acov(i), 1e-12);
+}
+
+TEST_F(AutocovarianceEngine, pair) {
+  stan::analyze::autocovariance_engine<double> engine;
+  Eigen::VectorXd x = y.reverse() * 3 + Eigen::VectorXd::Constant(1000, 5);
+  Eigen::VectorXd expected_x, expected_y;
+  engine.autocovariance(x, expected_x);
+  engine.autocovariance(y, expected_y);
+
+  Eigen::VectorXd acov_x, acov_y;
+  engine.autocovariance(x, y, acov_x, acov_y);
+  ASSERT_EQ(1000, acov_x.size());
+  ASSERT_EQ(1000, acov_y.size());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_NEAR(expected_x(i), acov_x(i), 1e-10);
+    EXPECT_NEAR(expected_y(i), acov_y(i), 1e-10);
+  }
+}
@@ -0,0 +1,54 @@
+#include <stan/analyze/mcmc/compute_quantiles.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST(ComputeQuantiles, quantile_position) {
+  EXPECT_EQ(0U, stan::analyze::quantile_position(10, 0.0));
+  EXPECT_EQ(0U, stan::analyze::quantile_position(10, 0.1));
+  EXPECT_EQ(1U, stan::analyze::quantile_position(10, 0.15));
+  EXPECT_EQ(5U, stan::analyze::quantile_position(10, 0.5));
+  EXPECT_EQ(7U, stan::analyze::quantile_position(10, 0.75));
+  EXPECT_EQ(9U, stan::analyze::quantile_position(10, 1.0));
+  EXPECT_EQ(0U, stan::analyze::quantile_position(0, 0.5));
+}
+
+TEST(ComputeQuantiles, matches_sorted_draws) {
+  std::vector<double> draws;
+  for (int i = 0; i < 1000; ++i)
+    draws.push_back(std::sin(i * 0.37) * (i % 17));
+  std::vector<double> sorted(draws);
+  std::sort(sorted.begin(), sorted.end());
+
+  Eigen::VectorXd probs(7);
+  probs << 0.975, 0.025, 0.5, 0.1, 0.5, 0.9, 0.0;
+  Eigen::VectorXd q
+    = stan::analyze::compute_quantiles(draws.data(), draws.size(), probs);
+  ASSERT_EQ(probs.size(), q.size());
+  for (int i = 0; i < probs.size(); ++i)
+    EXPECT_FLOAT_EQ(
+        sorted[stan::analyze::quantile_position(draws.size(), probs(i))],
+        q(i))
+      << "prob = " << probs(i);
+}
+
+TEST(ComputeQuantiles, in_place_reorders_copy) {
+  double draws[] = {5, 3, 1, 4, 2};
+  Eigen::VectorXd probs(2);
+  probs << 0.2, 0.6;
+  Eigen::VectorXd q = stan::analyze::compute_quantiles_in_place(draws, 5,
+                                                                probs);
+  EXPECT_FLOAT_EQ(1, q(0));
+  EXPECT_FLOAT_EQ(4, q(1));
+  std::sort(draws, draws + 5);
+  for (int i = 0; i < 5; ++i)
+    EXPECT_FLOAT_EQ(i + 1, draws[i]);
+}
+
+TEST(ComputeQuantiles, empty_draws) {
+  Eigen::VectorXd probs(1);
+  probs << 0.5;
+  Eigen::VectorXd q = stan::analyze::compute_quantiles(0, 0, probs);
+  EXPECT_TRUE(std::isnan(q(0)));
+}
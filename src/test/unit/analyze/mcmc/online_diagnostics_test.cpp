@@ -0,0 +1,197 @@
+#include <stan/analyze/mcmc/online_diagnostics.hpp>
+#include <stan/analyze/mcmc/online_diagnostics_writer.hpp>
+#include <stan/mcmc/chains.hpp>
+#include <stan/io/stan_csv_reader.hpp>
+#include <test/unit/services/instrumented_callbacks.hpp>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <limits>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+class OnlineDiagnostics : public testing::Test {
+public:
+  void SetUp() {
+    std::stringstream out;
+    std::ifstream blocker1_stream, blocker2_stream;
+    blocker1_stream.open("src/test/unit/mcmc/test_csv_files/blocker.1.csv");
+    blocker2_stream.open("src/test/unit/mcmc/test_csv_files/blocker.2.csv");
+    blocker1 = stan::io::stan_csv_reader::parse(blocker1_stream, &out);
+    blocker2 = stan::io::stan_csv_reader::parse(blocker2_stream, &out);
+    blocker1_stream.close();
+    blocker2_stream.close();
+  }
+
+  std::vector<double> row(const stan::io::stan_csv& csv, int n) {
+    std::vector<double> draw(csv.samples.cols());
+    for (int i = 0; i < csv.samples.cols(); ++i)
+      draw[i] = csv.samples(n, i);
+    return draw;
+  }
+
+  stan::io::stan_csv blocker1, blocker2;
+};
+
+TEST_F(OnlineDiagnostics, matches_chains) {
+  stan::mcmc::chains<> chains(blocker1);
+  chains.add(blocker2);
+
+  stan::analyze::online_diagnostics diagnostics(2, 250);
+  int num_draws = blocker1.samples.rows();
+  for (int n = 0; n < num_draws; ++n) {
+    diagnostics.add_draw(0, row(blocker1, n));
+    if (n == 499) {
+      EXPECT_EQ(499, diagnostics.num_draws());
+      EXPECT_EQ(250, diagnostics.ess_num_draws());
+    }
+    diagnostics.add_draw(1, row(blocker2, n));
+  }
+  ASSERT_EQ(num_draws, diagnostics.num_draws());
+  ASSERT_EQ(num_draws, diagnostics.ess_num_draws());
+  ASSERT_EQ(chains.num_params(), diagnostics.num_params());
+
+  for (int index = 4; index < chains.num_params(); ++index) {
+    EXPECT_NEAR(chains.split_effective_sample_size(index),
+                diagnostics.ess(index), 1e-6)
+      << "parameter: " << chains.param_name(index);
+    EXPECT_NEAR(chains.split_potential_scale_reduction(index),
+                diagnostics.rhat(index), 1e-8)
+      << "parameter: " << chains.param_name(index);
+  }
+}
+
+TEST_F(OnlineDiagnostics, before_refresh) {
+  stan::analyze::online_diagnostics diagnostics(2, 100);
+  EXPECT_EQ(0, diagnostics.num_params());
+  EXPECT_TRUE(std::isnan(diagnostics.min_ess()));
+  EXPECT_TRUE(std::isnan(diagnostics.max_rhat()));
+
+  for (int n = 0; n < 99; ++n) {
+    diagnostics.add_draw(0, row(blocker1, n));
+    diagnostics.add_draw(1, row(blocker2, n));
+  }
+  EXPECT_EQ(0, diagnostics.ess_num_draws());
+  EXPECT_TRUE(std::isnan(diagnostics.ess(5)));
+  EXPECT_FALSE(std::isnan(diagnostics.rhat(5)));
+}
+
+TEST_F(OnlineDiagnostics, errors) {
+  stan::analyze::online_diagnostics diagnostics(1);
+  diagnostics.add_draw(0, std::vector<double>(3, 1.0));
+  EXPECT_THROW(diagnostics.add_draw(0, std::vector<double>(2, 1.0)),
+               std::invalid_argument);
+  EXPECT_THROW(diagnostics.add_draw(1, std::vector<double>(3, 1.0)),
+               std::out_of_range);
+  EXPECT_THROW(diagnostics.ess(3), std::out_of_range);
+  EXPECT_THROW(diagnostics.index("mu"), std::out_of_range);
+  EXPECT_THROW(stan::analyze::online_diagnostics(0), std::invalid_argument);
+}
+
+TEST_F(OnlineDiagnostics, writer) {
+  stan::analyze::online_diagnostics diagnostics(1, 10);
+  stan::test::unit::instrumented_writer sample_writer;
+  stan::analyze::online_diagnostics_writer writer(diagnostics, 0,
+                                                  sample_writer);
+  std::vector<std::string> names;
+  names.push_back("lp__");
+  names.push_back("theta");
+  writer(names);
+  for (int n = 0; n < 5; ++n)
+    writer(std::vector<double>(2, n));
+  writer("Adaptation terminated");
+  for (int n = 0; n < 20; ++n) {
+    std::vector<double> draw(2);
+    draw[0] = n;
+    draw[1] = std::sin(n);
+    writer(draw);
+  }
+
+  EXPECT_EQ(1 + 5 + 1 + 20, sample_writer.call_count());
+  EXPECT_EQ(1, diagnostics.num_params());
+  EXPECT_EQ(20, diagnostics.num_draws());
+  EXPECT_EQ(20, diagnostics.ess_num_draws());
+  EXPECT_EQ(0, diagnostics.index("theta"));
+  EXPECT_THROW(diagnostics.index("lp__"), std::out_of_range);
+}
+
+TEST_F(OnlineDiagnostics, constant_column) {
+  stan::analyze::online_diagnostics diagnostics(2, 50);
+  for (int n = 0; n < 100; ++n) {
+    for (int c = 0; c < 2; ++c) {
+      std::vector<double> draw(2);
+      draw[0] = 0.5;
+      draw[1] = std::sin(3 * n + c);
+      diagnostics.add_draw(c, draw);
+    }
+  }
+  EXPECT_FALSE(std::isnan(diagnostics.ess(1)));
+  EXPECT_FLOAT_EQ(diagnostics.ess(1), diagnostics.min_ess());
+  EXPECT_FLOAT_EQ(diagnostics.rhat(1), diagnostics.max_rhat());
+}
+
+TEST_F(OnlineDiagnostics, writer_sampler_columns) {
+  stan::mcmc::chains<> chains(blocker1);
+  chains.add(blocker2);
+
+  stan::analyze::online_diagnostics diagnostics(2, 1000);
+  stan::test::unit::instrumented_writer sample_writer;
+  stan::analyze::online_diagnostics_writer writer1(diagnostics, 0,
+                                                   sample_writer);
+  stan::analyze::online_diagnostics_writer writer2(diagnostics, 1,
+                                                   sample_writer);
+  std::vector<std::string> names(blocker1.header.data(),
+                                 blocker1.header.data()
+                                 + blocker1.header.size());
+  writer1(names);
+  writer2(names);
+  writer1("Adaptation terminated");
+  writer2("Adaptation terminated");
+  int num_draws = blocker1.samples.rows();
+  for (int n = 0; n < num_draws; ++n) {
+    writer1(row(blocker1, n));
+    writer2(row(blocker2, n));
+  }
+
+  // lp__, accept_stat__, stepsize__ and treedepth__ are skipped
+  ASSERT_EQ(chains.num_params() - 4, diagnostics.num_params());
+  ASSERT_EQ(num_draws, diagnostics.ess_num_draws());
+  EXPECT_EQ(0, diagnostics.index("d"));
+
+  double min_ess = std::numeric_limits<double>::infinity();
+  double max_rhat = 0;
+  for (int index = 4; index < chains.num_params(); ++index) {
+    min_ess = std::min(min_ess, chains.split_effective_sample_size(index));
+    max_rhat = std::max(max_rhat,
+                        chains.split_potential_scale_reduction(index));
+  }
+  EXPECT_NEAR(min_ess, diagnostics.min_ess(), 1e-6);
+  EXPECT_NEAR(max_rhat, diagnostics.max_rhat(), 1e-8);
+}
+
+TEST_F(OnlineDiagnostics, threads) {
+  int num_draws = blocker1.samples.rows();
+  stan::analyze::online_diagnostics serial(2, 10);
+  for (int n = 0; n < num_draws; ++n) {
+    serial.add_draw(0, row(blocker1, n));
+    serial.add_draw(1, row(blocker2, n));
+  }
+
+  stan::analyze::online_diagnostics diagnostics(2, 10);
+  std::thread chain1([&]() {
+    for (int n = 0; n < num_draws; ++n)
+      diagnostics.add_draw(0, row(blocker1, n));
+  });
+  std::thread chain2([&]() {
+    for (int n = 0; n < num_draws; ++n)
+      diagnostics.add_draw(1, row(blocker2, n));
+  });
+  chain1.join();
+  chain2.join();
+
+  ASSERT_EQ(num_draws, diagnostics.num_draws());
+  EXPECT_LT(0, diagnostics.ess_num_draws());
+  EXPECT_FALSE(std::isnan(diagnostics.min_ess()));
+  for (size_t index = 0; index < serial.num_params(); ++index)
+    EXPECT_FLOAT_EQ(serial.rhat(index), diagnostics.rhat(index));
+}
@@ -0,0 +1,63 @@
+#include <stan/analyze/mcmc/quantile_sketch.hpp>
+#include <stan/analyze/mcmc/compute_quantiles.hpp>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+TEST(QuantileSketch, exact_before_compaction) {
+  stan::analyze::quantile_sketch sketch(64);
+  std::vector<double> draws;
+  for (int i = 0; i < 50; ++i) {
+    draws.push_back(std::cos(i * 1.3));
+    sketch.add(draws.back());
+  }
+  EXPECT_EQ(50U, sketch.count());
+  EXPECT_EQ(50U, sketch.size());
+
+  std::vector<double> probs;
+  probs.push_back(0.05);
+  probs.push_back(0.5);
+  probs.push_back(0.95);
+  Eigen::VectorXd exact_probs(3);
+  exact_probs << 0.05, 0.5, 0.95;
+  Eigen::VectorXd exact
+    = stan::analyze::compute_quantiles(draws.data(), draws.size(),
+                                       exact_probs);
+  std::vector<double> q = sketch.quantiles(probs);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(exact(i), q[i]);
+}
+
+TEST(QuantileSketch, bounded_memory_and_rank_error) {
+  size_t capacity = 128;
+  stan::analyze::quantile_sketch sketch(capacity);
+  std::vector<double> draws;
+  for (int i = 0; i < 100000; ++i) {
+    draws.push_back(std::sin(i * 0.7071) + std::sin(i * 0.1234));
+    sketch.add(draws.back());
+  }
+  EXPECT_EQ(draws.size(), sketch.count());
+  EXPECT_LT(sketch.size(), capacity * 12);
+
+  std::vector<double> sorted(draws);
+  std::sort(sorted.begin(), sorted.end());
+  double probs[] = {0.05, 0.25, 0.5, 0.75, 0.95};
+  for (int i = 0; i < 5; ++i) {
+    double q = sketch.quantile(probs[i]);
+    double rank = std::lower_bound(sorted.begin(), sorted.end(), q)
+      - sorted.begin();
+    EXPECT_NEAR(probs[i], rank / sorted.size(), 0.02)
+      << "prob = " << probs[i];
+  }
+}
+
+TEST(QuantileSketch, empty) {
+  stan::analyze::quantile_sketch sketch;
+  EXPECT_TRUE(std::isnan(sketch.quantile(0.5)));
+}
+
+TEST(QuantileSketch, throws_on_small_capacity) {
+  EXPECT_THROW(stan::analyze::quantile_sketch(1), std::invalid_argument);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <stan/callbacks/async_writer.hpp>
+#include <stan/callbacks/stream_writer.hpp>
+#include <stan/callbacks/tee_writer.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+  class throwing_writer : public stan::callbacks::writer {
+  public:
+    void operator()(const std::vector<double>&) {
+      throw std::runtime_error("disk full");
+    }
+  };
+
+  void write_calls(stan::callbacks::writer& writer, int num_rows) {
+    std::vector<std::string> names;
+    names.push_back("a");
+    names.push_back("b");
+    writer(names);
+    std::vector<double> x(2);
+    for (int n = 0; n < num_rows; ++n) {
+      x[0] = n;
+      x[1] = -n;
+      writer(x);
+      if (n % 7 == 0)
+        writer("message");
+      if (n % 11 == 0)
+        writer();
+    }
+  }
+}
+
+TEST(StanInterfaceCallbacksAsyncWriter, keeps_order) {
+  std::stringstream expected_ss, ss;
+  stan::callbacks::stream_writer expected(expected_ss, "# ");
+  write_calls(expected, 1000);
+
+  stan::callbacks::stream_writer wrapped(ss, "# ");
+  {
+    stan::callbacks::async_writer writer(wrapped, 4);
+    write_calls(writer, 1000);
+  }
+  EXPECT_EQ(expected_ss.str(), ss.str());
+}
+
+TEST(StanInterfaceCallbacksAsyncWriter, flush) {
+  std::stringstream ss;
+  stan::callbacks::stream_writer wrapped(ss);
+  stan::callbacks::async_writer writer(wrapped);
+  writer("first");
+  std::vector<double> x(3, 1.0);
+  writer(x);
+  writer.flush();
+  EXPECT_EQ("first\n1,1,1\n", ss.str());
+}
+
+TEST(StanInterfaceCallbacksAsyncWriter, tee) {
+  std::stringstream ss1, ss2;
+  stan::callbacks::stream_writer writer1(ss1);
+  stan::callbacks::stream_writer writer2(ss2);
+  stan::callbacks::tee_writer tee(writer1, writer2);
+  {
+    stan::callbacks::async_writer writer(tee, 2);
+    write_calls(writer, 50);
+  }
+  EXPECT_EQ(ss1.str(), ss2.str());
+  EXPECT_FALSE(ss1.str().empty());
+}
+
+TEST(StanInterfaceCallbacksAsyncWriter, rethrows) {
+  throwing_writer wrapped;
+  stan::callbacks::async_writer writer(wrapped, 2);
+  std::vector<double> x(1, 1.0);
+  writer(x);
+  EXPECT_THROW(writer.flush(), std::runtime_error);
+  EXPECT_THROW(writer(x), std::runtime_error);
+  EXPECT_THROW(writer("message"), std::runtime_error);
+  EXPECT_THROW(writer.flush(), std::runtime_error);
+}
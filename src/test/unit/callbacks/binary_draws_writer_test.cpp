@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <stan/callbacks/binary_draws_writer.hpp>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class StanInterfaceCallbacksBinaryDrawsWriter : public ::testing::Test {
+public:
+  StanInterfaceCallbacksBinaryDrawsWriter() : ss() {}
+
+  void SetUp() {
+    ss.str(std::string());
+    ss.clear();
+  }
+
+  uint64_t read_size(const std::string& s, size_t pos) {
+    uint64_t n;
+    std::memcpy(&n, s.data() + pos, sizeof(n));
+    return n;
+  }
+
+  double read_double(const std::string& s, size_t pos) {
+    double x;
+    std::memcpy(&x, s.data() + pos, sizeof(x));
+    return x;
+  }
+
+  std::stringstream ss;
+};
+
+TEST_F(StanInterfaceCallbacksBinaryDrawsWriter, names_and_draws) {
+  std::vector<std::string> names;
+  names.push_back("a");
+  names.push_back("bc");
+  std::vector<double> x(2);
+  {
+    stan::callbacks::binary_draws_writer writer(ss);
+    writer(names);
+    x[0] = 1;
+    x[1] = 2;
+    writer(x);
+    x[0] = 3;
+    x[1] = 4;
+    writer(x);
+    // nothing beyond the names is written until the chunk is flushed
+    EXPECT_EQ(8U + 1 + 8 + 9 + 10, ss.str().size());
+  }
+  std::string out = ss.str();
+
+  EXPECT_EQ("STANDRW1", out.substr(0, 8));
+  EXPECT_EQ('N', out[8]);
+  EXPECT_EQ(2U, read_size(out, 9));
+  EXPECT_EQ(1U, read_size(out, 17));
+  EXPECT_EQ("a", out.substr(25, 1));
+  EXPECT_EQ(2U, read_size(out, 26));
+  EXPECT_EQ("bc", out.substr(34, 2));
+
+  // chunk is written column-major on destruction
+  EXPECT_EQ('D', out[36]);
+  EXPECT_EQ(2U, read_size(out, 37));
+  EXPECT_EQ(2U, read_size(out, 45));
+  EXPECT_EQ(1, read_double(out, 53));
+  EXPECT_EQ(3, read_double(out, 61));
+  EXPECT_EQ(2, read_double(out, 69));
+  EXPECT_EQ(4, read_double(out, 77));
+  EXPECT_EQ(85U, out.size());
+}
+
+TEST_F(StanInterfaceCallbacksBinaryDrawsWriter, full_chunks) {
+  // chunks of a single row
+  stan::callbacks::binary_draws_writer writer(ss, 1);
+  std::vector<double> x(3, 1.5);
+  writer(x);
+  EXPECT_EQ(8U + 1 + 16 + 24, ss.str().size());
+  writer(x);
+  EXPECT_EQ(8U + 2 * (1 + 16 + 24), ss.str().size());
+}
+
+TEST_F(StanInterfaceCallbacksBinaryDrawsWriter, messages_keep_order) {
+  stan::callbacks::binary_draws_writer writer(ss);
+  std::vector<double> x(1, 2.5);
+  writer(x);
+  writer("Adaptation terminated");
+  writer();
+  std::string out = ss.str();
+
+  EXPECT_EQ('D', out[8]);
+  EXPECT_EQ(1U, read_size(out, 9));
+  EXPECT_EQ(2.5, read_double(out, 25));
+  EXPECT_EQ('M', out[33]);
+  EXPECT_EQ(21U, read_size(out, 34));
+  EXPECT_EQ("Adaptation terminated", out.substr(42, 21));
+  EXPECT_EQ('M', out[63]);
+  EXPECT_EQ(0U, read_size(out, 64));
+}
+
+TEST_F(StanInterfaceCallbacksBinaryDrawsWriter, wrong_size) {
+  stan::callbacks::binary_draws_writer writer(ss);
+  std::vector<std::string> names(2, "x");
+  writer(names);
+  std::vector<double> x(3);
+  EXPECT_THROW(writer(x), std::invalid_argument);
+  EXPECT_THROW(writer(names), std::logic_error);
+}
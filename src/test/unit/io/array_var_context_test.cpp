@@ -198,3 +198,58 @@ TEST(array_var_context, invalid_input2) {
   FAIL();
 }
 
+
+TEST(array_var_context, refs) {
+  std::vector<std::string> names_r;
+  names_r.push_back("y");
+  std::vector<double> values_r;
+  values_r.push_back(1.5);
+  values_r.push_back(2.5);
+  std::vector<std::vector<size_t> > dims_r;
+  dims_r.push_back(std::vector<size_t>(1, 2));
+  std::vector<std::string> names_i;
+  names_i.push_back("N");
+  std::vector<int> values_i(1, 3);
+  std::vector<std::vector<size_t> > dims_i(1);
+  stan::io::array_var_context avc(names_r, values_r, dims_r,
+                                  names_i, values_i, dims_i);
+  const stan::io::var_context& context = avc;
+
+  std::vector<double> buffer_r;
+  const std::vector<double>& y = context.vals_r_ref("y", buffer_r);
+  ASSERT_EQ(2U, y.size());
+  EXPECT_FLOAT_EQ(1.5, y[0]);
+  EXPECT_FLOAT_EQ(2.5, y[1]);
+  EXPECT_NE(&buffer_r, &y);
+  EXPECT_EQ(&y, &context.vals_r_ref("y", buffer_r));
+  EXPECT_EQ(0U, buffer_r.size());
+
+  // integers read as reals are converted into the buffer
+  const std::vector<double>& N_r = context.vals_r_ref("N", buffer_r);
+  EXPECT_EQ(&buffer_r, &N_r);
+  ASSERT_EQ(1U, N_r.size());
+  EXPECT_FLOAT_EQ(3, N_r[0]);
+
+  std::vector<int> buffer_i;
+  const std::vector<int>& N = context.vals_i_ref("N", buffer_i);
+  ASSERT_EQ(1U, N.size());
+  EXPECT_EQ(3, N[0]);
+  EXPECT_NE(&buffer_i, &N);
+  EXPECT_EQ(0U, context.vals_i_ref("y", buffer_i).size());
+  EXPECT_EQ(0U, context.vals_r_ref("z", buffer_r).size());
+
+  std::vector<size_t> buffer_dims;
+  EXPECT_EQ(1U, context.dims_r_ref("y", buffer_dims).size());
+  EXPECT_EQ(0U, context.dims_r_ref("N", buffer_dims).size());
+  EXPECT_EQ(0U, context.dims_i_ref("y", buffer_dims).size());
+  EXPECT_NO_THROW(context.validate_dims("test", "y", "vector",
+                                        context.to_vec(2)));
+  EXPECT_THROW(context.validate_dims("test", "y", "vector",
+                                     context.to_vec(3)),
+               std::runtime_error);
+
+  std::vector<std::string> names;
+  context.names_r(names);
+  ASSERT_EQ(1U, names.size());
+  EXPECT_EQ("y", names[0]);
+}
@@ -0,0 +1,178 @@
+#include <stan/io/binary_draws_reader.hpp>
+#include <stan/callbacks/binary_draws_writer.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST(StanIoBinaryDrawsReader, round_trip) {
+  std::stringstream ss;
+  std::vector<std::string> names;
+  names.push_back("lp__");
+  names.push_back("theta.1");
+  names.push_back("Sigma.2.3");
+  {
+    // small chunks so the draws span several records
+    stan::callbacks::binary_draws_writer writer(ss, 2 * 3 * sizeof(double));
+    writer(names);
+    std::vector<double> x(3);
+    for (int n = 0; n < 7; ++n) {
+      x[0] = n;
+      x[1] = 10 * n;
+      x[2] = 100 * n;
+      writer(x);
+      if (n == 2)
+        writer("Adaptation terminated");
+    }
+    writer();
+    writer(" Elapsed Time: 1.5 seconds (Warm-up)");
+    writer("               2.25 seconds (Sampling)");
+    writer("               3.75 seconds (Total)");
+  }
+
+  std::stringstream out;
+  stan::io::stan_csv data = stan::io::binary_draws_reader::parse(ss, &out);
+
+  ASSERT_EQ(3, data.header.size());
+  EXPECT_EQ("lp__", data.header(0));
+  EXPECT_EQ("theta[1]", data.header(1));
+  EXPECT_EQ("Sigma[2,3]", data.header(2));
+
+  ASSERT_EQ(7, data.samples.rows());
+  ASSERT_EQ(3, data.samples.cols());
+  for (int n = 0; n < 7; ++n) {
+    EXPECT_EQ(n, data.samples(n, 0));
+    EXPECT_EQ(10 * n, data.samples(n, 1));
+    EXPECT_EQ(100 * n, data.samples(n, 2));
+  }
+  EXPECT_FLOAT_EQ(1.5, data.timing.warmup);
+  EXPECT_FLOAT_EQ(2.25, data.timing.sampling);
+  EXPECT_EQ("", out.str());
+}
+
+TEST(StanIoBinaryDrawsReader, not_binary) {
+  std::stringstream ss("lp__,theta\n1,2\n");
+  EXPECT_THROW(stan::io::binary_draws_reader::parse(ss, 0),
+               std::invalid_argument);
+}
+
+TEST(StanIoBinaryDrawsReader, truncated) {
+  std::stringstream ss;
+  {
+    stan::callbacks::binary_draws_writer writer(ss);
+    std::vector<double> x(4, 1.0);
+    writer(x);
+  }
+  std::string s = ss.str();
+  std::stringstream truncated(s.substr(0, s.size() - 3));
+  EXPECT_THROW(stan::io::binary_draws_reader::parse(truncated, 0),
+               std::invalid_argument);
+}
+
+TEST(StanIoBinaryDrawsReader, columns) {
+  std::stringstream ss;
+  std::vector<std::string> names;
+  names.push_back("lp__");
+  names.push_back("theta.1");
+  names.push_back("theta.2");
+  names.push_back("sigma");
+  {
+    stan::callbacks::binary_draws_writer writer(ss, 3 * 4 * sizeof(double));
+    writer(names);
+    std::vector<double> x(4);
+    for (int n = 0; n < 7; ++n) {
+      for (int i = 0; i < 4; ++i)
+        x[i] = 10 * n + i;
+      writer(x);
+    }
+  }
+
+  Eigen::Matrix<std::string, Eigen::Dynamic, 1> header;
+  EXPECT_TRUE(stan::io::binary_draws_reader::read_header(ss, header));
+  ASSERT_EQ(4, header.size());
+  EXPECT_EQ("theta[2]", header(2));
+
+  ss.seekg(0);
+  std::vector<std::string> columns;
+  columns.push_back("theta[2]");
+  columns.push_back("lp__");
+  stan::io::stan_csv data
+    = stan::io::binary_draws_reader::parse(ss, 0, columns);
+  ASSERT_EQ(2, data.header.size());
+  EXPECT_EQ("theta[2]", data.header(0));
+  EXPECT_EQ("lp__", data.header(1));
+  ASSERT_EQ(7, data.samples.rows());
+  ASSERT_EQ(2, data.samples.cols());
+  for (int n = 0; n < 7; ++n) {
+    EXPECT_EQ(10 * n + 2, data.samples(n, 0));
+    EXPECT_EQ(10 * n, data.samples(n, 1));
+  }
+
+  ss.clear();
+  ss.seekg(0);
+  columns.push_back("tau");
+  EXPECT_THROW(stan::io::binary_draws_reader::parse(ss, 0, columns),
+               std::invalid_argument);
+}
+
+TEST(StanIoBinaryDrawsReader, repeated_column) {
+  std::stringstream ss;
+  std::vector<std::string> names;
+  names.push_back("lp__");
+  names.push_back("sigma");
+  {
+    stan::callbacks::binary_draws_writer writer(ss);
+    writer(names);
+    std::vector<double> x(2, 1.0);
+    writer(x);
+  }
+
+  std::vector<std::string> columns;
+  columns.push_back("sigma");
+  columns.push_back("lp__");
+  columns.push_back("sigma");
+  EXPECT_THROW(stan::io::binary_draws_reader::parse(ss, 0, columns),
+               std::invalid_argument);
+}
+
+namespace {
+  // string buffer that cannot seek, as a pipe
+  class unseekable_buf : public std::stringbuf {
+  public:
+    explicit unseekable_buf(const std::string& s) : std::stringbuf(s) {}
+
+  protected:
+    std::streampos seekoff(std::streamoff, std::ios_base::seekdir,
+                           std::ios_base::openmode) {
+      return std::streampos(-1);
+    }
+  };
+}
+
+TEST(StanIoBinaryDrawsReader, unseekable) {
+  std::stringstream ss;
+  std::vector<std::string> names;
+  names.push_back("lp__");
+  names.push_back("theta");
+  {
+    stan::callbacks::binary_draws_writer writer(ss, 2 * 2 * sizeof(double));
+    writer(names);
+    std::vector<double> x(2);
+    for (int n = 0; n < 5; ++n) {
+      x[0] = n;
+      x[1] = -n;
+      writer(x);
+    }
+  }
+
+  unseekable_buf buf(ss.str());
+  std::istream in(&buf);
+  std::stringstream out;
+  stan::io::stan_csv data = stan::io::binary_draws_reader::parse(in, &out);
+  ASSERT_EQ(5, data.samples.rows());
+  ASSERT_EQ(2, data.samples.cols());
+  for (int n = 0; n < 5; ++n) {
+    EXPECT_EQ(n, data.samples(n, 0));
+    EXPECT_EQ(-n, data.samples(n, 1));
+  }
+}
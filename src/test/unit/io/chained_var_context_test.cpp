@@ -51,3 +51,31 @@ TEST(chained_var_context, ctor) {
   std::vector<double> alpha(1, 0);
   EXPECT_EQ(alpha, vcc.vals_r("alpha"));
 }
+
+TEST(chained_var_context, int_shadowed_by_real) {
+  std::vector<std::string> names_r;
+  names_r.push_back("k");
+  std::vector<double> vals_r(3, 1.5);
+  std::vector<std::vector<size_t> > dims_r(1, std::vector<size_t>(1, 3));
+  stan::io::array_var_context avc(names_r, vals_r, dims_r);
+
+  std::vector<std::string> names_i;
+  names_i.push_back("k");
+  std::vector<int> vals_i;
+  vals_i.push_back(4);
+  vals_i.push_back(5);
+  std::vector<std::vector<size_t> > dims_i(1, std::vector<size_t>(1, 2));
+  stan::io::array_var_context avc2(names_i, vals_i, dims_i);
+
+  stan::io::chained_var_context vcc(avc, avc2);
+  EXPECT_TRUE(vcc.contains_i("k"));
+  EXPECT_EQ(vals_i, vcc.vals_i("k"));
+  std::vector<size_t> dims = vcc.dims_i("k");
+  ASSERT_EQ(1U, dims.size());
+  EXPECT_EQ(2U, dims[0]);
+  std::vector<size_t> buffer;
+  const std::vector<size_t>& dims_ref = vcc.dims_i_ref("k", buffer);
+  ASSERT_EQ(1U, dims_ref.size());
+  EXPECT_EQ(2U, dims_ref[0]);
+  EXPECT_EQ(3U, vcc.dims_r("k")[0]);
+}
@@ -699,3 +699,65 @@ TEST(io_dump, too_large_zero_array) {
   test_exception("a <- structure(integer(999918446744073709551616L), .Dim = c(2,3))");
   test_exception("a <- structure(double(999918446744073709551616L), .Dim = c(2,3))");
 }
+
+TEST(io_dump, larger_than_block) {
+  // values and keywords cross the boundaries of blocks read from
+  // the stream
+  std::stringstream in;
+  std::vector<double> expected_r;
+  std::vector<int> expected_i;
+  in << "a <- c(";
+  for (int n = 0; n < 30000; ++n) {
+    in << (n > 0 ? ", " : "") << n << ".25";
+    expected_r.push_back(n + 0.25);
+  }
+  in << ")\nb <- structure(c(";
+  for (int n = 0; n < 30000; ++n) {
+    in << (n > 0 ? ",\n  " : "") << -n;
+    expected_i.push_back(-n);
+  }
+  in << "), .Dim = c(100, 300))\n";
+  stan::io::dump dump(in);
+
+  EXPECT_TRUE(dump.contains_r("a"));
+  EXPECT_FALSE(dump.contains_i("a"));
+  std::vector<double> vals_r = dump.vals_r("a");
+  ASSERT_EQ(expected_r.size(), vals_r.size());
+  for (size_t n = 0; n < vals_r.size(); ++n)
+    EXPECT_FLOAT_EQ(expected_r[n], vals_r[n]);
+
+  EXPECT_TRUE(dump.contains_i("b"));
+  std::vector<int> vals_i = dump.vals_i("b");
+  ASSERT_EQ(expected_i.size(), vals_i.size());
+  for (size_t n = 0; n < vals_i.size(); ++n)
+    EXPECT_EQ(expected_i[n], vals_i[n]);
+  std::vector<size_t> dims = dump.dims_i("b");
+  ASSERT_EQ(2U, dims.size());
+  EXPECT_EQ(100U, dims[0]);
+  EXPECT_EQ(300U, dims[1]);
+}
+
+TEST(io_dump, int_range_limits) {
+  test_val("a", 2147483647, "a <- 2147483647");
+  test_exception("a <- 2147483648");
+}
+
+TEST(io_dump, int_sequence_limits) {
+  std::vector<int> expected;
+  expected.push_back(2147483645);
+  expected.push_back(2147483646);
+  expected.push_back(2147483647);
+  test_list("a", expected, "a <- 2147483645:2147483647");
+  std::vector<int> expected_down;
+  expected_down.push_back(-2147483646);
+  expected_down.push_back(-2147483647);
+  test_list("a", expected_down, "a <- -2147483646:-2147483647");
+}
+
+TEST(io_dump, non_ascii_bytes) {
+  std::stringstream in("a <- 1\n\xe9\xa0 <- 2\n");
+  stan::io::dump_reader reader(in);
+  EXPECT_TRUE(reader.next());
+  EXPECT_EQ("a", reader.name());
+  EXPECT_FALSE(reader.next());
+}
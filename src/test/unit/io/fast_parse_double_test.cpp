@@ -0,0 +1,30 @@
+#include <stan/io/fast_parse_double.hpp>
+#include <gtest/gtest.h>
+#include <boost/lexical_cast.hpp>
+#include <string>
+
+TEST(ioFastParseDouble, exact) {
+  using stan::io::fast_parse_double;
+  const char* s[] = { "0", "-0.0", "+1", "1.", ".5", "0.1", "-2.5e-3",
+                      "12345.6789", "9007199254740992", "1e22", "1E-22", "5e+3",
+                      "0.000001234" };
+  for (size_t i = 0; i < sizeof(s) / sizeof(s[0]); ++i) {
+    double x = -1;
+    EXPECT_TRUE(fast_parse_double(std::string(s[i]), x)) << s[i];
+    EXPECT_EQ(boost::lexical_cast<double>(s[i]), x) << s[i];
+  }
+}
+
+TEST(ioFastParseDouble, declined) {
+  using stan::io::fast_parse_double;
+  const char* s[] = { "", "-", ".", "e5", "1e", "1e+", "1.2.3", "1e5e5",
+                      "1-2", "abc", "1e23", "1e-23",
+                      "1234567890123456789", "9007199254740993",
+                      "123456789.123456789", "0.30000000000000004",
+                      "1.7976931348623157e308", "4.9e-324" };
+  for (size_t i = 0; i < sizeof(s) / sizeof(s[0]); ++i) {
+    double x = -1;
+    EXPECT_FALSE(fast_parse_double(std::string(s[i]), x)) << s[i];
+    EXPECT_EQ(-1, x) << s[i];
+  }
+}
@@ -290,6 +290,11 @@ TEST(ioJson,jsonData_array_err4) {
   test_exception(txt,"variable: foo, error: empty array not allowed");
 }
 
+TEST(ioJson,jsonData_array_err4_empty_rows) {
+  std::string txt = "{ \"foo\" : [[],[]] }";
+  test_exception(txt,"variable: foo, error: empty array not allowed");
+}
+
 TEST(ioJson,jsonData_array_err5) {
   std::string txt = "{ \"foo\" : [1, 2, 3, 4, [5], 6, 7] }";
   test_exception(txt,"variable: foo, error: non-scalar array value");
@@ -503,3 +508,69 @@ TEST(ioJson,jsonData_signed_neg_Infinity_str) {
   std::vector<size_t> expected_dims;
   test_real_var(jdata,txt,"foo",expected_vals_r,expected_dims);
 }
+
+TEST(ioJson,jsonData_array_3D_larger_than_tile) {
+  // dims 3 x 5 x 70, with last dimension spanning several tiles
+  std::stringstream txt;
+  txt << "{ \"foo\" : [ ";
+  for (int i = 0; i < 3; ++i) {
+    txt << (i > 0 ? ", [ " : "[ ");
+    for (int j = 0; j < 5; ++j) {
+      txt << (j > 0 ? ", [ " : "[ ");
+      for (int k = 0; k < 70; ++k)
+        txt << (k > 0 ? ", " : "") << (i * 1000 + j * 100 + k) << ".5";
+      txt << " ]";
+    }
+    txt << " ]";
+  }
+  txt << " ] }";
+  stan::json::json_data jdata(txt);
+  std::vector<double> expected_vals_r;
+  for (int k = 0; k < 70; ++k)
+    for (int j = 0; j < 5; ++j)
+      for (int i = 0; i < 3; ++i)
+        expected_vals_r.push_back(i * 1000 + j * 100 + k + 0.5);
+  std::vector<size_t> expected_dims;
+  expected_dims.push_back(3);
+  expected_dims.push_back(5);
+  expected_dims.push_back(70);
+  test_real_var(jdata,txt.str(),"foo",expected_vals_r,expected_dims);
+}
+
+TEST(ioJson,jsonData_array_mixed_int_real) {
+  std::string txt = "{ \"foo\" : [ [ 1, 2, 3.5 ], [ -4, Infinity, 6 ] ] }";
+  std::stringstream in(txt);
+  stan::json::json_data jdata(in);
+  std::vector<double> expected_vals_r;
+  expected_vals_r.push_back(1);
+  expected_vals_r.push_back(-4);
+  expected_vals_r.push_back(2);
+  expected_vals_r.push_back(std::numeric_limits<double>::infinity());
+  expected_vals_r.push_back(3.5);
+  expected_vals_r.push_back(6);
+  std::vector<size_t> expected_dims;
+  expected_dims.push_back(2);
+  expected_dims.push_back(3);
+  test_real_var(jdata,txt,"foo",expected_vals_r,expected_dims);
+}
+
+TEST(ioJson,jsonData_array_real_values_exact) {
+  const char* vals[] = { "0.1", "-2.5e-3", "123456789.123456789",
+                         "1.7976931348623157e308", "4.9e-324",
+                         "0.30000000000000004", "9007199254740993",
+                         "9007199254740993.0", "1e22", "1e23", "-0.0",
+                         "2.2250738585072014e-308" };
+  const size_t n = sizeof(vals) / sizeof(vals[0]);
+  std::stringstream txt;
+  txt << "{ \"foo\" : [ ";
+  for (size_t i = 0; i < n; ++i)
+    txt << (i > 0 ? ", " : "") << vals[i];
+  txt << " ] }";
+  stan::json::json_data jdata(txt);
+  std::vector<double> expected_vals_r;
+  for (size_t i = 0; i < n; ++i)
+    expected_vals_r.push_back(boost::lexical_cast<double>(vals[i]));
+  std::vector<size_t> expected_dims;
+  expected_dims.push_back(n);
+  test_real_var(jdata,txt.str(),"foo",expected_vals_r,expected_dims);
+}
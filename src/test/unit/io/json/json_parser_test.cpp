@@ -155,6 +155,13 @@ TEST(ioJson,jsonParserA9) {
 }
 
 
+TEST(ioJson,jsonParserA10) {
+  test_parser("[ 1, 2.5, -3, 18446744073709551615, Infinity, \"a\", 4 ]",
+              "S:text" "S:arr" "UL(INT):1" "D(REAL):2.5" "L(INT):-3"
+              "UL(INT):18446744073709551615" "D(REAL):inf"
+              "STR:\"a\"" "UL(INT):4" "E:arr" "E:text");
+}
+
 TEST(ioJson,jsonParserO1) {
   test_parser("{  \"foo\" : 1  }   ",
               "S:text" "S:obj" "KEY:\"foo\"" "UL(INT):1" "E:obj" "E:text");
@@ -0,0 +1,194 @@
+#include <stan/io/mmap_var_context.hpp>
+#include <stan/io/array_var_context.hpp>
+#include <stan/io/binary_data_writer.hpp>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class MmapVarContext : public testing::Test {
+public:
+  MmapVarContext() : path("test/mmap_var_context_test.bin") {}
+
+  void SetUp() {
+    std::vector<std::string> names_r;
+    names_r.push_back("y");
+    names_r.push_back("sigma");
+    std::vector<double> values_r;
+    for (int n = 0; n < 6; ++n)
+      values_r.push_back(0.5 * n);
+    values_r.push_back(2.25);
+    std::vector<std::vector<size_t> > dims_r(2);
+    dims_r[0].push_back(2);
+    dims_r[0].push_back(3);
+
+    std::vector<std::string> names_i;
+    names_i.push_back("N");
+    names_i.push_back("idx");
+    std::vector<int> values_i;
+    values_i.push_back(3);
+    values_i.push_back(-1);
+    values_i.push_back(7);
+    values_i.push_back(11);
+    std::vector<std::vector<size_t> > dims_i(2);
+    dims_i[1].push_back(3);
+
+    stan::io::array_var_context context(names_r, values_r, dims_r,
+                                        names_i, values_i, dims_i);
+    std::ofstream out(path.c_str(), std::ios::binary);
+    stan::io::write_binary_data(context, out);
+  }
+
+  void TearDown() {
+    std::remove(path.c_str());
+  }
+
+  std::string path;
+};
+
+TEST_F(MmapVarContext, read) {
+  stan::io::mmap_var_context context(path);
+
+  EXPECT_TRUE(context.contains_r("y"));
+  EXPECT_TRUE(context.contains_r("N"));
+  EXPECT_FALSE(context.contains_i("y"));
+  EXPECT_TRUE(context.contains_i("idx"));
+  EXPECT_FALSE(context.contains_r("z"));
+
+  std::vector<double> y = context.vals_r("y");
+  ASSERT_EQ(6U, y.size());
+  for (int n = 0; n < 6; ++n)
+    EXPECT_FLOAT_EQ(0.5 * n, y[n]);
+  std::vector<size_t> dims = context.dims_r("y");
+  ASSERT_EQ(2U, dims.size());
+  EXPECT_EQ(2U, dims[0]);
+  EXPECT_EQ(3U, dims[1]);
+
+  EXPECT_EQ(1U, context.vals_r("sigma").size());
+  EXPECT_EQ(0U, context.dims_r("sigma").size());
+
+  std::vector<int> idx = context.vals_i("idx");
+  ASSERT_EQ(3U, idx.size());
+  EXPECT_EQ(-1, idx[0]);
+  EXPECT_EQ(11, idx[2]);
+  EXPECT_EQ(1U, context.dims_i("idx").size());
+  std::vector<double> idx_r = context.vals_r("idx");
+  ASSERT_EQ(3U, idx_r.size());
+  EXPECT_FLOAT_EQ(7.0, idx_r[1]);
+  EXPECT_EQ(3, context.vals_i("N")[0]);
+  EXPECT_EQ(0U, context.vals_i("y").size());
+
+  std::vector<std::string> names;
+  context.names_r(names);
+  EXPECT_EQ(2U, names.size());
+  context.names_i(names);
+  EXPECT_EQ(2U, names.size());
+}
+
+TEST_F(MmapVarContext, views) {
+  stan::io::mmap_var_context context(path);
+  stan::io::mmap_var_context::vals_r_view_t y = context.vals_r_view("y");
+  ASSERT_EQ(6, y.size());
+  EXPECT_FLOAT_EQ(2.5, y(5));
+  EXPECT_EQ(0U, reinterpret_cast<size_t>(y.data()) % sizeof(double));
+  EXPECT_EQ(0, context.vals_r_view("idx").size());
+
+  stan::io::mmap_var_context::vals_i_view_t idx = context.vals_i_view("idx");
+  ASSERT_EQ(3, idx.size());
+  EXPECT_EQ(7, idx(1));
+  EXPECT_EQ(0, context.vals_i_view("y").size());
+}
+
+TEST_F(MmapVarContext, bad_files) {
+  EXPECT_THROW(stan::io::mmap_var_context("test/no_such_file.bin"),
+               std::invalid_argument);
+
+  std::ifstream in(path.c_str(), std::ios::binary);
+  std::stringstream contents;
+  contents << in.rdbuf();
+  in.close();
+
+  std::string truncated = contents.str();
+  truncated.resize(truncated.size() - 4);
+  std::ofstream out(path.c_str(), std::ios::binary);
+  out << truncated;
+  out.close();
+  EXPECT_THROW(stan::io::mmap_var_context context(path),
+               std::invalid_argument);
+
+  std::string bad_magic = contents.str();
+  bad_magic[0] = 'X';
+  out.open(path.c_str(), std::ios::binary);
+  out << bad_magic;
+  out.close();
+  EXPECT_THROW(stan::io::mmap_var_context context(path),
+               std::invalid_argument);
+}
+
+namespace {
+
+  void write_size(std::string& s, uint64_t n) {
+    s.append(reinterpret_cast<const char*>(&n), sizeof(n));
+  }
+
+  std::string header(uint64_t num_vars) {
+    std::string s(stan::io::binary_data_format::magic(),
+                  stan::io::binary_data_format::magic_size);
+    write_size(s, stan::io::binary_data_format::byte_order);
+    write_size(s, num_vars);
+    return s;
+  }
+
+  void write_file(const std::string& path, const std::string& contents) {
+    std::ofstream out(path.c_str(), std::ios::binary);
+    out << contents;
+  }
+
+}
+
+TEST_F(MmapVarContext, name_size_overflow) {
+  std::string s = header(1);
+  write_size(s, std::numeric_limits<uint64_t>::max());
+  s += "xR";
+  write_size(s, 0);
+  write_size(s, 0);
+  write_file(path, s);
+  EXPECT_THROW(stan::io::mmap_var_context context(path),
+               std::invalid_argument);
+}
+
+TEST_F(MmapVarContext, dims_overflow) {
+  std::string s = header(1);
+  write_size(s, 1);
+  s += "xR";
+  write_size(s, 2);
+  write_size(s, 1ULL << 32);
+  write_size(s, (1ULL << 32) + 1);
+  write_size(s, 0);
+  while (s.size() % stan::io::binary_data_format::alignment != 0)
+    s += '\0';
+  write_file(path, s);
+  EXPECT_THROW(stan::io::mmap_var_context context(path),
+               std::invalid_argument);
+}
+
+TEST_F(MmapVarContext, values_size_overflow) {
+  std::string s = header(1);
+  write_size(s, 1);
+  s += "xR";
+  write_size(s, 1);
+  write_size(s, (1ULL << 61) + 1);
+  uint64_t offset = s.size() + sizeof(uint64_t);
+  offset += (stan::io::binary_data_format::alignment
+             - offset % stan::io::binary_data_format::alignment)
+    % stan::io::binary_data_format::alignment;
+  write_size(s, offset);
+  s.resize(offset, '\0');
+  write_size(s, 0);
+  write_file(path, s);
+  EXPECT_THROW(stan::io::mmap_var_context context(path),
+               std::invalid_argument);
+}
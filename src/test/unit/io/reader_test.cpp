@@ -1430,3 +1430,39 @@ TEST(IoReader, UnitVectorThrows) {
   EXPECT_THROW(reader.unit_vector_constrain(x), std::invalid_argument);
   EXPECT_THROW(reader.unit_vector_constrain(x, lp), std::invalid_argument);
 }
+
+TEST(io_reader, block_exceptions) {
+  std::vector<double> theta;
+  for (int i = 0; i < 4; ++i)
+    theta.push_back(static_cast<double>(i));
+  std::vector<int> theta_i;
+  stan::io::reader<double> reader(theta, theta_i);
+
+  EXPECT_THROW(reader.vector(5), std::runtime_error);
+  EXPECT_THROW(reader.matrix_lb_constrain(0.0, 2, 3), std::runtime_error);
+  EXPECT_EQ(4U, reader.available());
+
+  std::vector<double> y = reader.std_vector(4);
+  EXPECT_EQ(4U, y.size());
+  EXPECT_FLOAT_EQ(3.0, y[3]);
+  EXPECT_EQ(0U, reader.available());
+  EXPECT_THROW(reader.row_vector(1), std::runtime_error);
+}
+
+TEST(io_reader, matrix_lub_constrain_order) {
+  std::vector<double> theta;
+  for (int i = 0; i < 6; ++i)
+    theta.push_back(0.5 * i - 1.0);
+  std::vector<int> theta_i;
+  stan::io::reader<double> reader(theta, theta_i);
+
+  double lp = 0;
+  Eigen::MatrixXd y = reader.matrix_lub_constrain(-1.0, 2.0, 2, 3, lp);
+  double lp_expected = 0;
+  for (int j = 0; j < 3; ++j)
+    for (int i = 0; i < 2; ++i)
+      EXPECT_FLOAT_EQ(stan::math::lub_constrain(theta[i + 2 * j], -1.0, 2.0,
+                                                lp_expected),
+                      y(i, j));
+  EXPECT_FLOAT_EQ(lp_expected, lp);
+}
@@ -1,6 +1,7 @@
 #include <stan/io/stan_csv_reader.hpp>
 #include <test/unit/util.hpp>
 #include <gtest/gtest.h>
+#include <cstdio>
 #include <fstream>
 #include <sstream>
 
@@ -467,3 +468,136 @@ TEST_F(StanIoStanCsvReader,ParseEightSchools) {
   
   EXPECT_EQ("", out.str());
 }
+
+TEST_F(StanIoStanCsvReader,ParseFileEightSchools) {
+  std::stringstream out;
+  stan::io::stan_csv expected
+    = stan::io::stan_csv_reader::parse(eight_schools_stream, &out);
+  stan::io::stan_csv eight_schools = stan::io::stan_csv_reader::parse_file(
+      "src/test/unit/io/test_csv_files/eight_schools.csv", &out,
+      std::vector<std::string>(), 4);
+  EXPECT_EQ("", out.str());
+
+  EXPECT_EQ(expected.metadata.model, eight_schools.metadata.model);
+  EXPECT_EQ(expected.metadata.seed, eight_schools.metadata.seed);
+  ASSERT_EQ(expected.header.size(), eight_schools.header.size());
+  for (int i = 0; i < expected.header.size(); ++i)
+    EXPECT_EQ(expected.header(i), eight_schools.header(i));
+  EXPECT_FLOAT_EQ(expected.adaptation.step_size,
+                  eight_schools.adaptation.step_size);
+  ASSERT_EQ(expected.samples.rows(), eight_schools.samples.rows());
+  ASSERT_EQ(expected.samples.cols(), eight_schools.samples.cols());
+  for (int i = 0; i < expected.samples.rows(); ++i)
+    for (int j = 0; j < expected.samples.cols(); ++j)
+      EXPECT_EQ(expected.samples(i, j), eight_schools.samples(i, j));
+  EXPECT_FLOAT_EQ(expected.timing.warmup, eight_schools.timing.warmup);
+  EXPECT_FLOAT_EQ(expected.timing.sampling, eight_schools.timing.sampling);
+}
+
+TEST_F(StanIoStanCsvReader,ParseFileColumns) {
+  std::stringstream out;
+  stan::io::stan_csv expected
+    = stan::io::stan_csv_reader::parse(eight_schools_stream, &out);
+  std::vector<std::string> columns;
+  columns.push_back("theta[8]");
+  columns.push_back("lp__");
+  columns.push_back("tau");
+  stan::io::stan_csv eight_schools = stan::io::stan_csv_reader::parse_file(
+      "src/test/unit/io/test_csv_files/eight_schools.csv", &out, columns);
+
+  ASSERT_EQ(3, eight_schools.header.size());
+  EXPECT_EQ("theta[8]", eight_schools.header(0));
+  EXPECT_EQ("lp__", eight_schools.header(1));
+  EXPECT_EQ("tau", eight_schools.header(2));
+  ASSERT_EQ(1000, eight_schools.samples.rows());
+  ASSERT_EQ(3, eight_schools.samples.cols());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(expected.samples(i, 24), eight_schools.samples(i, 0));
+    EXPECT_EQ(expected.samples(i, 0), eight_schools.samples(i, 1));
+    EXPECT_EQ(expected.samples(i, 8), eight_schools.samples(i, 2));
+  }
+
+  columns.push_back("foo");
+  EXPECT_THROW(stan::io::stan_csv_reader::parse_file(
+                   "src/test/unit/io/test_csv_files/eight_schools.csv", &out,
+                   columns),
+               std::invalid_argument);
+  EXPECT_THROW(stan::io::stan_csv_reader::parse_file(
+                   "src/test/unit/io/test_csv_files/no_such_file.csv", &out),
+               std::invalid_argument);
+}
+
+TEST_F(StanIoStanCsvReader,ParseFileRepeatedColumn) {
+  std::stringstream out;
+  std::vector<std::string> columns;
+  columns.push_back("tau");
+  columns.push_back("lp__");
+  columns.push_back("tau");
+  EXPECT_THROW(stan::io::stan_csv_reader::parse_file(
+                   "src/test/unit/io/test_csv_files/eight_schools.csv", &out,
+                   columns),
+               std::invalid_argument);
+}
+
+TEST_F(StanIoStanCsvReader,ParseFileEmpty) {
+  std::stringstream out;
+  const char* path = "src/test/unit/io/test_csv_files/empty_test.csv";
+  std::ofstream empty(path);
+  empty.close();
+  stan::io::stan_csv data
+    = stan::io::stan_csv_reader::parse_file(path, &out);
+  std::remove(path);
+  EXPECT_EQ(0, data.header.size());
+  EXPECT_EQ(0, data.samples.size());
+}
+
+struct append_block {
+  std::vector<Eigen::MatrixXd>& blocks_;
+  explicit append_block(std::vector<Eigen::MatrixXd>& blocks)
+    : blocks_(blocks) {}
+  void operator()(const Eigen::MatrixXd& block) const {
+    blocks_.push_back(block);
+  }
+};
+
+TEST_F(StanIoStanCsvReader,ParseBlocks) {
+  std::stringstream out;
+  stan::io::stan_csv expected
+    = stan::io::stan_csv_reader::parse(eight_schools_stream, &out);
+  std::ifstream in("src/test/unit/io/test_csv_files/eight_schools.csv");
+  std::vector<std::string> columns;
+  columns.push_back("mu");
+  columns.push_back("tau");
+  std::vector<Eigen::MatrixXd> blocks;
+  stan::io::stan_csv eight_schools = stan::io::stan_csv_reader::parse_blocks(
+      in, &out, 300, append_block(blocks), columns);
+  EXPECT_EQ("", out.str());
+
+  EXPECT_EQ(0, eight_schools.samples.size());
+  ASSERT_EQ(2, eight_schools.header.size());
+  EXPECT_EQ("mu", eight_schools.header(0));
+  EXPECT_FLOAT_EQ(expected.timing.sampling, eight_schools.timing.sampling);
+  ASSERT_EQ(4U, blocks.size());
+  EXPECT_EQ(300, blocks[0].rows());
+  EXPECT_EQ(100, blocks[3].rows());
+  int row = 0;
+  for (size_t b = 0; b < blocks.size(); ++b) {
+    ASSERT_EQ(2, blocks[b].cols());
+    for (int i = 0; i < blocks[b].rows(); ++i, ++row) {
+      EXPECT_EQ(expected.samples(row, 7), blocks[b](i, 0));
+      EXPECT_EQ(expected.samples(row, 8), blocks[b](i, 1));
+    }
+  }
+  EXPECT_EQ(1000, row);
+}
+
+TEST_F(StanIoStanCsvReader,read_samples_column_mismatch) {
+  std::stringstream in("1,2,3\n4,5,6\n\n7,8\n");
+  std::stringstream out;
+  Eigen::MatrixXd samples;
+  stan::io::stan_csv_timing timing;
+  EXPECT_FALSE(stan::io::stan_csv_reader::read_samples(in, samples, timing,
+                                                       &out));
+  EXPECT_EQ("Error: expected 3 columns, but found 2 instead for row 3\n",
+            out.str());
+}
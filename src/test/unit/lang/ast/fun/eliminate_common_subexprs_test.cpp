@@ -0,0 +1,63 @@
+#include <stan/lang/ast_def.cpp>
+#include <stan/lang/generator.hpp>
+#include <test/unit/lang/utility.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+void hoist_and_eliminate_common_subexprs(stan::lang::program& prog) {
+  stan::lang::hoist_data_exprs(prog);
+  stan::lang::eliminate_common_subexprs(prog);
+}
+
+std::string cse_model_to_hpp(const std::string& model_text) {
+  return transformed_model_to_hpp("cse", model_text,
+                                  hoist_and_eliminate_common_subexprs);
+}
+
+const std::string cse_header
+  = "data { int N; vector[N] x; vector[N] y; real s; } "
+    "parameters { real alpha; real beta; real<lower=0> sigma; } ";
+
+TEST(langAst, cseLoopBody) {
+  std::string hpp = cse_model_to_hpp(cse_header
+      + "model { for (n in 1:N) { "
+      + "target += -exp(alpha + beta * x[n]); "
+      + "y[n] ~ normal(log(exp(alpha + beta * x[n])), sigma); } }");
+  EXPECT_EQ(1, count_matches("local_scalar_t__ cse_0__", hpp));
+  EXPECT_EQ(1, count_matches("stan::math::exp((alpha + (beta * ", hpp));
+  EXPECT_EQ(1, count_matches("lp_accum__.add(-(cse_0__));", hpp));
+  EXPECT_EQ(1, count_matches("stan::math::log(cse_0__)", hpp));
+  EXPECT_EQ(0, count_matches("cse_1__", hpp));
+}
+
+TEST(langAst, cseTransformedParameters) {
+  std::string hpp = cse_model_to_hpp(cse_header
+      + "transformed parameters { real a; real b; "
+      + "a = exp(alpha * beta); b = exp(alpha * beta) + 1; } "
+      + "model { y ~ normal(a + b, sigma); }");
+  // once in log_prob and once in write_array
+  EXPECT_EQ(2, count_matches("stan::math::exp((alpha * beta))", hpp));
+  EXPECT_EQ(2, count_matches("stan::math::assign(a, cse_0__);", hpp));
+  EXPECT_EQ(2, count_matches("stan::math::assign(b, (cse_0__ + 1));", hpp));
+}
+
+TEST(langAst, cseNotAcrossAssignment) {
+  std::string hpp = cse_model_to_hpp(cse_header
+      + "model { real mu = alpha; target += exp(mu * beta); "
+      + "mu = beta; target += exp(mu * beta); }");
+  EXPECT_EQ(0, count_matches("cse_0__", hpp));
+}
+
+TEST(langAst, cseNotDataOrLazy) {
+  std::string hpp = cse_model_to_hpp(cse_header
+      + "model { target += s > 0 ? exp(alpha) : 0; "
+      + "target += s > 0 ? exp(alpha) : 1; "
+      + "target += sqrt(s) * alpha; target += sqrt(s) * beta; }");
+  EXPECT_EQ(0, count_matches("cse_0__", hpp));
+}
+
+TEST(langAst, cseNotImpure) {
+  std::string hpp = cse_model_to_hpp(cse_header
+      + "model { target += exp(target()); target += exp(target()); }");
+  EXPECT_EQ(0, count_matches("cse_0__", hpp));
+}
@@ -0,0 +1,82 @@
+#include <stan/lang/ast_def.cpp>
+#include <stan/lang/generator.hpp>
+#include <test/unit/lang/utility.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+std::string hoisted_model_to_hpp(const std::string& model_text) {
+  return transformed_model_to_hpp("hoisted", model_text,
+                                  stan::lang::hoist_data_exprs);
+}
+
+const std::string hoist_header
+  = "data { int N; vector[N] y; matrix[N, 2] X; real s; } "
+    "transformed data { vector[N] z = 2 * y; } "
+    "parameters { vector[2] beta; real<lower=0> sigma; } ";
+
+TEST(langAst, hoistDataExprSampling) {
+  std::string hpp = hoisted_model_to_hpp(hoist_header
+      + "model { y ~ normal(X * beta, s * sigma + log(s)); }");
+  EXPECT_EQ(1, count_matches("double hoisted_0__;", hpp));
+  EXPECT_EQ(1, count_matches("hoisted_0__ = stan::math::log(s);", hpp));
+  EXPECT_EQ(1, count_matches("((s * sigma) + hoisted_0__)", hpp));
+  EXPECT_EQ(0, count_matches("hoisted_1__", hpp));
+}
+
+TEST(langAst, hoistDataExprMaximal) {
+  std::string hpp = hoisted_model_to_hpp(hoist_header
+      + "model { target += dot_self(X * beta - (y + z) / s); }");
+  EXPECT_EQ(1, count_matches("vector_d hoisted_0__;", hpp));
+  EXPECT_EQ(1, count_matches("hoisted_0__ = divide(add(y, z), s);", hpp));
+  EXPECT_EQ(0, count_matches("hoisted_1__", hpp));
+}
+
+TEST(langAst, hoistDataExprTransformedParameters) {
+  std::string hpp = hoisted_model_to_hpp(hoist_header
+      + "transformed parameters { vector[N] mu = X * beta + sd(y); } "
+      + "model { y ~ normal(mu, sigma); }");
+  EXPECT_EQ(1, count_matches("hoisted_0__ = sd(y);", hpp));
+  EXPECT_EQ(2, count_matches("add(multiply(X, beta), hoisted_0__)", hpp));
+}
+
+TEST(langAst, hoistDataExprNotInLoopsOrConditionals) {
+  std::string hpp = hoisted_model_to_hpp(hoist_header
+      + "model { for (n in 1:N) y[n] ~ normal(sigma, log(s)); "
+      + "if (s > 0) y ~ normal(sigma, sqrt(s)); "
+      + "target += s > 0 ? log(s) : sigma; }");
+  EXPECT_EQ(0, count_matches("hoisted_0__", hpp));
+}
+
+TEST(langAst, hoistDataExprNoParamsOrTarget) {
+  std::string hpp = hoisted_model_to_hpp(hoist_header
+      + "model { target += log(sigma) + exp(target()); "
+      + "y ~ normal(0, 1); }");
+  EXPECT_EQ(0, count_matches("hoisted_0__", hpp));
+}
+
+TEST(langAst, hoistDataExprNotAfterReject) {
+  std::string hpp = hoisted_model_to_hpp(hoist_header
+      + "model { target += log(s) * sigma; "
+      + "if (s <= 0) reject(\"s must be positive\"); "
+      + "y ~ normal(X * beta, sqrt(s) * sigma); }");
+  EXPECT_EQ(1, count_matches("hoisted_0__ = stan::math::log(s);", hpp));
+  EXPECT_EQ(0, count_matches("hoisted_1__", hpp));
+  EXPECT_EQ(1, count_matches("stan::math::sqrt(s)", hpp));
+}
+
+TEST(langAst, hoistDataExprNotAfterRejectInTransformedParameters) {
+  std::string hpp = hoisted_model_to_hpp(hoist_header
+      + "transformed parameters { real t = sigma; "
+      + "if (s <= 0) reject(\"s must be positive\"); } "
+      + "model { y ~ normal(X * beta, log(s) * sigma); }");
+  EXPECT_EQ(0, count_matches("hoisted_0__", hpp));
+}
+
+TEST(langAst, hoistDataExprNotAfterUserDefinedCall) {
+  std::string hpp = hoisted_model_to_hpp(
+      "functions { void check_data(real x) { "
+      "if (x <= 0) reject(\"x must be positive\"); } } "
+      + hoist_header
+      + "model { check_data(s); y ~ normal(X * beta, log(s) * sigma); }");
+  EXPECT_EQ(0, count_matches("hoisted_0__", hpp));
+}
@@ -0,0 +1,92 @@
+#include <stan/lang/ast_def.cpp>
+#include <stan/lang/generator.hpp>
+#include <test/unit/lang/utility.hpp>
+#include <gtest/gtest.h>
+#include <string>
+
+void vectorize_program(stan::lang::program& prog) {
+  stan::lang::vectorize_sampling_loops(prog.statement_);
+}
+
+std::string vectorized_model_to_hpp(const std::string& model_text) {
+  return transformed_model_to_hpp("vectorized", model_text,
+                                  vectorize_program);
+}
+
+const std::string vectorize_header
+  = "data { int N; vector[N] y; int k[N]; matrix[N, 2] X; } "
+    "parameters { vector[N] mu; real<lower=0> sigma; real lambda[N]; "
+    "vector[2] beta; } ";
+
+const std::string y_slice
+  = "stan::model::rvalue(y, stan::model::cons_list("
+    "stan::model::index_min_max(1, N), stan::model::nil_index_list()), \"y\")";
+
+const std::string mu_slice
+  = "stan::model::rvalue(mu, stan::model::cons_list("
+    "stan::model::index_min_max(1, N), stan::model::nil_index_list()), \"mu\")";
+
+TEST(langAst, vectorizeSamplingLoop) {
+  std::string hpp = vectorized_model_to_hpp(vectorize_header
+      + "model { for (n in 1:N) y[n] ~ normal(mu[n], sigma); }");
+  EXPECT_EQ(1, count_matches("lp_accum__.add(normal_log<propto__>("
+                             + y_slice + ", " + mu_slice + ", sigma));",
+                             hpp));
+  EXPECT_EQ(0, count_matches("for (int n = 1; n <= N; ++n)", hpp));
+}
+
+TEST(langAst, vectorizeSamplingLoopBlock) {
+  std::string hpp = vectorized_model_to_hpp(vectorize_header
+      + "model { for (n in 1:N) { k[n] ~ poisson_log(lambda[n]); } }");
+  EXPECT_EQ(1, count_matches("lp_accum__.add(poisson_log_log<propto__>("
+                             "stan::model::rvalue(k, ", hpp));
+}
+
+TEST(langAst, vectorizeTargetIncrementLoop) {
+  std::string hpp = vectorized_model_to_hpp(vectorize_header
+      + "model { for (n in 1:N) target += normal_lpdf(y[n] | 0, 1); }");
+  EXPECT_EQ(1, count_matches("lp_accum__.add(normal_log(" + y_slice
+                             + ", 0, 1));", hpp));
+}
+
+TEST(langAst, vectorizeLoopInvariantSlicedParameter) {
+  std::string hpp = vectorized_model_to_hpp(vectorize_header
+      + "model { for (n in 1:N) sigma ~ normal(mu[n], 2); }");
+  EXPECT_EQ(1, count_matches("lp_accum__.add(normal_log<propto__>(sigma, "
+                             + mu_slice + ", 2));", hpp));
+}
+
+TEST(langAst, vectorizeSamplingLoopUnchanged) {
+  // index is not the loop variable
+  std::string hpp = vectorized_model_to_hpp(vectorize_header
+      + "model { for (n in 2:N) y[n] ~ normal(mu[n - 1], sigma); }");
+  EXPECT_EQ(1, count_matches("for (int n = 2; n <= N; ++n)", hpp));
+
+  // argument mentions loop variable other than as its only index
+  hpp = vectorized_model_to_hpp(vectorize_header
+      + "model { for (n in 1:N) y[n] ~ normal(X[n] * beta, sigma); }");
+  EXPECT_EQ(1, count_matches("for (int n = 1; n <= N; ++n)", hpp));
+
+  // loop-invariant argument is not univariate
+  hpp = vectorized_model_to_hpp(vectorize_header
+      + "model { for (n in 1:N) y[n] ~ normal(mu, 1); }");
+  EXPECT_EQ(1, count_matches("for (int n = 1; n <= N; ++n)", hpp));
+
+  // truncation
+  hpp = vectorized_model_to_hpp(vectorize_header
+      + "model { for (n in 1:N) y[n] ~ normal(mu[n], 1) T[0, ]; }");
+  EXPECT_EQ(1, count_matches("for (int n = 1; n <= N; ++n)", hpp));
+
+  // more than one statement
+  hpp = vectorized_model_to_hpp(vectorize_header
+      + "model { for (n in 1:N) { y[n] ~ normal(mu[n], 1); "
+        "lambda[n] ~ normal(0, 1); } }");
+  EXPECT_EQ(1, count_matches("for (int n = 1; n <= N; ++n)", hpp));
+
+  // user-defined density
+  hpp = vectorized_model_to_hpp(
+      "functions { real foo_lpdf(real y, real mu) { return -(y - mu)^2; } } "
+      + vectorize_header
+      + "model { for (n in 1:N) y[n] ~ foo(mu[n]); }");
+  EXPECT_EQ(1, count_matches("for (int n = 1; n <= N; ++n)", hpp));
+}
@@ -64,13 +64,13 @@ TEST(lang, data_block_hpp_ctor) {
                        "            validate_non_negative_index(\"cfcov_54\", \"4\", 4);\n"
                        "            context__.validate_dims(\"data initialization\", \"cfcov_54\", \"matrix_d\", context__.to_vec(5,4));\n"
                        "            cfcov_54 = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>(5, 4);\n"
-                       "            vals_r__ = context__.vals_r(\"cfcov_54\");\n"
+                       "            const std::vector<double>& cfcov_54_vals__ = context__.vals_r_ref(\"cfcov_54\", vals_r__);\n"
                        "            pos__ = 0;\n"
                        "            size_t cfcov_54_j_2_max__ = 4;\n"
                        "            size_t cfcov_54_j_1_max__ = 5;\n"
                        "            for (size_t j_2__ = 0; j_2__ < cfcov_54_j_2_max__; ++j_2__) {\n"
                        "                for (size_t j_1__ = 0; j_1__ < cfcov_54_j_1_max__; ++j_1__) {\n"
-                       "                    cfcov_54(j_1__, j_2__) = vals_r__[pos__++];\n"
+                       "                    cfcov_54(j_1__, j_2__) = cfcov_54_vals__[pos__++];\n"
                        "                }\n"
                        "            }\n"
                        "            stan::math::check_cholesky_factor(function__, \"cfcov_54\", cfcov_54);\n"
@@ -80,13 +80,13 @@ TEST(lang, data_block_hpp_ctor) {
                        "            validate_non_negative_index(\"cfcov_33\", \"3\", 3);\n"
                        "            context__.validate_dims(\"data initialization\", \"cfcov_33\", \"matrix_d\", context__.to_vec(3,3));\n"
                        "            cfcov_33 = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>(3, 3);\n"
-                       "            vals_r__ = context__.vals_r(\"cfcov_33\");\n"
+                       "            const std::vector<double>& cfcov_33_vals__ = context__.vals_r_ref(\"cfcov_33\", vals_r__);\n"
                        "            pos__ = 0;\n"
                        "            size_t cfcov_33_j_2_max__ = 3;\n"
                        "            size_t cfcov_33_j_1_max__ = 3;\n"
                        "            for (size_t j_2__ = 0; j_2__ < cfcov_33_j_2_max__; ++j_2__) {\n"
                        "                for (size_t j_1__ = 0; j_1__ < cfcov_33_j_1_max__; ++j_1__) {\n"
-                       "                    cfcov_33(j_1__, j_2__) = vals_r__[pos__++];\n"
+                       "                    cfcov_33(j_1__, j_2__) = cfcov_33_vals__[pos__++];\n"
                        "                }\n"
                        "            }\n"
                        "            stan::math::check_cholesky_factor(function__, \"cfcov_33\", cfcov_33);\n");
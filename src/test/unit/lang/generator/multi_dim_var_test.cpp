@@ -52,7 +52,7 @@ TEST(lang, data_block_var_hpp) {
                        "            validate_non_negative_index(\"ar_mat\", \"5\", 5);\n"
                        "            context__.validate_dims(\"data initialization\", \"ar_mat\", \"matrix_d\", context__.to_vec(4,5,2,3));\n"
                        "            ar_mat = std::vector<std::vector<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> > >(4, std::vector<Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> >(5, Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>(2, 3)));\n"
-                       "            vals_r__ = context__.vals_r(\"ar_mat\");\n"
+                       "            const std::vector<double>& ar_mat_vals__ = context__.vals_r_ref(\"ar_mat\", vals_r__);\n"
                        "            pos__ = 0;\n"
                        "            size_t ar_mat_j_2_max__ = 3;\n"
                        "            size_t ar_mat_j_1_max__ = 2;\n"
@@ -62,7 +62,7 @@ TEST(lang, data_block_var_hpp) {
                        "                for (size_t j_1__ = 0; j_1__ < ar_mat_j_1_max__; ++j_1__) {\n"
                        "                    for (size_t k_1__ = 0; k_1__ < ar_mat_k_1_max__; ++k_1__) {\n"
                        "                        for (size_t k_0__ = 0; k_0__ < ar_mat_k_0_max__; ++k_0__) {\n"
-                       "                            ar_mat[k_0__][k_1__](j_1__, j_2__) = vals_r__[pos__++];\n"
+                       "                            ar_mat[k_0__][k_1__](j_1__, j_2__) = ar_mat_vals__[pos__++];\n"
                        "                        }\n"
                        "                    }\n"
                        "                }\n"
@@ -80,9 +80,9 @@ TEST(lang, data_block_var_hpp_ctor) {
       "            context__.validate_dims(\"data initialization\", \"p1\", "
       "\"int\", context__.to_vec());\n"
       "            p1 = int(0);\n"
-      "            vals_i__ = context__.vals_i(\"p1\");\n"
+      "            const std::vector<int>& p1_vals__ = context__.vals_i_ref(\"p1\", vals_i__);\n"
       "            pos__ = 0;\n"
-      "            p1 = vals_i__[pos__++];\n"
+      "            p1 = p1_vals__[pos__++];\n"
       "            check_greater_or_equal(function__, \"p1\", p1, 0);\n"
       "            check_less_or_equal(function__, \"p1\", p1, 1);\n"
       "\n"
@@ -90,20 +90,20 @@ TEST(lang, data_block_var_hpp_ctor) {
       "            context__.validate_dims(\"data initialization\", \"p2\", "
       "\"double\", context__.to_vec());\n"
       "            p2 = double(0);\n"
-      "            vals_r__ = context__.vals_r(\"p2\");\n"
+      "            const std::vector<double>& p2_vals__ = context__.vals_r_ref(\"p2\", vals_r__);\n"
       "            pos__ = 0;\n"
-      "            p2 = vals_r__[pos__++];\n"
+      "            p2 = p2_vals__[pos__++];\n"
       "\n"
       "            current_statement_begin__ = 4;\n"
       "            validate_non_negative_index(\"ar_p1\", \"3\", 3);\n"
       "            context__.validate_dims(\"data initialization\", \"ar_p1\", "
       "\"int\", context__.to_vec(3));\n"
       "            ar_p1 = std::vector<int>(3, int(0));\n"
-      "            vals_i__ = context__.vals_i(\"ar_p1\");\n"
+      "            const std::vector<int>& ar_p1_vals__ = context__.vals_i_ref(\"ar_p1\", vals_i__);\n"
       "            pos__ = 0;\n"
       "            size_t ar_p1_k_0_max__ = 3;\n"
       "            for (size_t k_0__ = 0; k_0__ < ar_p1_k_0_max__; ++k_0__) {\n"
-      "                ar_p1[k_0__] = vals_i__[pos__++];\n"
+      "                ar_p1[k_0__] = ar_p1_vals__[pos__++];\n"
       "            }\n"
       "\n"
       "            current_statement_begin__ = 5;\n"
@@ -111,11 +111,11 @@ TEST(lang, data_block_var_hpp_ctor) {
       "            context__.validate_dims(\"data initialization\", \"ar_p2\", "
       "\"double\", context__.to_vec(4));\n"
       "            ar_p2 = std::vector<double>(4, double(0));\n"
-      "            vals_r__ = context__.vals_r(\"ar_p2\");\n"
+      "            const std::vector<double>& ar_p2_vals__ = context__.vals_r_ref(\"ar_p2\", vals_r__);\n"
       "            pos__ = 0;\n"
       "            size_t ar_p2_k_0_max__ = 4;\n"
       "            for (size_t k_0__ = 0; k_0__ < ar_p2_k_0_max__; ++k_0__) {\n"
-      "                ar_p2[k_0__] = vals_r__[pos__++];\n"
+      "                ar_p2[k_0__] = ar_p2_vals__[pos__++];\n"
       "            }\n"
       "            size_t ar_p2_i_0_max__ = 4;\n"
       "            for (size_t i_0__ = 0; i_0__ < ar_p2_i_0_max__; ++i_0__) {\n"
@@ -130,11 +130,11 @@ TEST(lang, data_block_var_hpp_ctor) {
       "            context__.validate_dims(\"data initialization\", \"ar_p3\", "
       "\"double\", context__.to_vec(5));\n"
       "            ar_p3 = std::vector<double>(5, double(0));\n"
-      "            vals_r__ = context__.vals_r(\"ar_p3\");\n"
+      "            const std::vector<double>& ar_p3_vals__ = context__.vals_r_ref(\"ar_p3\", vals_r__);\n"
       "            pos__ = 0;\n"
       "            size_t ar_p3_k_0_max__ = 5;\n"
       "            for (size_t k_0__ = 0; k_0__ < ar_p3_k_0_max__; ++k_0__) {\n"
-      "                ar_p3[k_0__] = vals_r__[pos__++];\n"
+      "                ar_p3[k_0__] = ar_p3_vals__[pos__++];\n"
       "            }\n"
       "\n");
 
@@ -249,6 +249,25 @@ std::string model_to_hpp(const std::string& model_name,
   return output.str();
 }
 
+/** generate C++ for a model after applying a pass to its AST
+ *
+ * @param model_name Name of model
+ * @param model_text Text of model
+ * @param pass Pass applied to the parsed program before generation
+ */
+std::string transformed_model_to_hpp(const std::string& model_name,
+                                     const std::string& model_text,
+                                     void (*pass)(stan::lang::program&)) {
+  stan::lang::program prog = model_to_ast(model_name, model_text);
+  pass(prog);
+  stan::io::program_reader reader;
+  reader.add_event(0, 0, "start", model_name);
+  reader.add_event(100, 100, "end", model_name);
+  std::stringstream output;
+  stan::lang::generate_cpp(prog, model_name, reader.history(), output);
+  return output.str();
+}
+
 void expect_matches(int n,
                     const std::string& stan_code,
                     const std::string& target) {
@@ -1,7 +1,11 @@
 #include <stan/mcmc/chains.hpp>
+#include <stan/mcmc/binary_draws_source.hpp>
+#include <stan/mcmc/csv_draws_source.hpp>
+#include <stan/callbacks/binary_draws_writer.hpp>
 #include <stan/io/stan_csv_reader.hpp>
 #include <gtest/gtest.h>
 #include <boost/random/additive_combine.hpp>
+#include <cstdio>
 #include <set>
 #include <exception>
 #include <utility>
@@ -862,3 +866,150 @@ TEST_F(McmcChains,blocker_split_potential_scale_reduction) {
   }
 
 }
+
+TEST_F(McmcChains, csv_draws_source) {
+  stan::io::stan_csv blocker1
+    = stan::io::stan_csv_reader::parse(blocker1_stream, 0);
+  stan::io::stan_csv blocker2
+    = stan::io::stan_csv_reader::parse(blocker2_stream, 0);
+  stan::mcmc::chains<> expected(blocker1);
+  expected.add(blocker2);
+
+  stan::mcmc::csv_draws_source source1(
+      "src/test/unit/mcmc/test_csv_files/blocker.1.csv");
+  stan::mcmc::csv_draws_source source2(
+      "src/test/unit/mcmc/test_csv_files/blocker.2.csv", 2);
+  stan::mcmc::chains<> chains(source1);
+  chains.add(source2);
+
+  ASSERT_EQ(expected.num_params(), chains.num_params());
+  ASSERT_EQ(2, chains.num_chains());
+  EXPECT_EQ(expected.num_samples(), chains.num_samples());
+  EXPECT_EQ(expected.warmup(0), chains.warmup(0));
+  for (int index = 0; index < chains.num_params(); index++)
+    EXPECT_FALSE(source1.loaded(index));
+
+  int index = chains.index("d");
+  EXPECT_FLOAT_EQ(expected.effective_sample_size(index),
+                  chains.effective_sample_size(index));
+  EXPECT_TRUE(source1.loaded(index));
+  EXPECT_TRUE(source2.loaded(index));
+  EXPECT_FALSE(source1.loaded(index + 1));
+
+  Eigen::VectorXd probs(3);
+  probs << 0.025, 0.5, 0.975;
+  Eigen::VectorXd q_expected = expected.quantiles(index + 1, probs);
+  Eigen::VectorXd q = chains.quantiles(index + 1, probs);
+  for (int i = 0; i < probs.size(); i++)
+    EXPECT_FLOAT_EQ(q_expected(i), q(i));
+
+  std::vector<int> indexes;
+  indexes.push_back(0);
+  indexes.push_back(chains.num_params() - 1);
+  chains.load(indexes);
+  EXPECT_TRUE(source1.loaded(0));
+  EXPECT_TRUE(source2.loaded(chains.num_params() - 1));
+  EXPECT_FALSE(source2.loaded(1));
+  for (int index = 0; index < chains.num_params(); index++) {
+    Eigen::VectorXd x_expected = expected.samples(index);
+    Eigen::VectorXd x = chains.samples(index);
+    ASSERT_EQ(x_expected.size(), x.size());
+    for (int n = 0; n < x.size(); n++)
+      EXPECT_FLOAT_EQ(x_expected(n), x(n));
+  }
+
+  // appending to a chain read from a source reads it into memory
+  chains.add(1, blocker1.samples);
+  EXPECT_EQ(2000, chains.num_samples(1));
+  EXPECT_FLOAT_EQ(blocker1.samples(999, 3), chains.samples(1, 3)(1999));
+  EXPECT_FLOAT_EQ(blocker2.samples(0, 3), chains.samples(1, 3)(0));
+}
+
+TEST_F(McmcChains, binary_draws_source) {
+  stan::io::stan_csv blocker1
+    = stan::io::stan_csv_reader::parse(blocker1_stream, 0);
+  std::string path = "src/test/unit/mcmc/test_csv_files/blocker.1.bin";
+  {
+    std::ofstream out(path.c_str(), std::ios::binary);
+    stan::callbacks::binary_draws_writer writer(out, 10000);
+    std::vector<std::string> names(blocker1.header.size());
+    for (int i = 0; i < blocker1.header.size(); i++)
+      names[i] = blocker1.header(i);
+    writer(names);
+    std::vector<double> draw(blocker1.samples.cols());
+    for (int n = 0; n < blocker1.samples.rows(); n++) {
+      for (int i = 0; i < blocker1.samples.cols(); i++)
+        draw[i] = blocker1.samples(n, i);
+      writer(draw);
+    }
+  }
+
+  stan::mcmc::chains<> expected(blocker1);
+  {
+    stan::mcmc::binary_draws_source source(path);
+    EXPECT_EQ(1000, source.num_rows());
+    stan::mcmc::chains<> chains(source);
+    ASSERT_EQ(expected.num_params(), chains.num_params());
+    EXPECT_EQ(1000, chains.num_samples(0));
+    for (int index = 0; index < chains.num_params(); index++) {
+      EXPECT_EQ(expected.mean(index), chains.mean(index));
+      EXPECT_EQ(expected.split_effective_sample_size(index),
+                chains.split_effective_sample_size(index));
+    }
+  }
+  std::remove(path.c_str());
+
+  EXPECT_THROW(stan::mcmc::binary_draws_source(
+                   "src/test/unit/mcmc/test_csv_files/blocker.1.csv"),
+               std::invalid_argument);
+}
+
+TEST_F(McmcChains, blocker_summary) {
+  stan::io::stan_csv blocker1
+    = stan::io::stan_csv_reader::parse(blocker1_stream, 0);
+  stan::io::stan_csv blocker2
+    = stan::io::stan_csv_reader::parse(blocker2_stream, 0);
+  stan::mcmc::chains<> chains(blocker1);
+  chains.add(blocker2);
+
+  Eigen::VectorXd probs(3);
+  probs << 0.05, 0.5, 0.95;
+  stan::mcmc::chains_summary summary = chains.summary(probs, 3);
+  ASSERT_EQ(chains.num_params(), static_cast<int>(summary.indexes.size()));
+  ASSERT_EQ(chains.num_params(), summary.quantiles.rows());
+  ASSERT_EQ(3, summary.quantiles.cols());
+  for (int index = 4; index < chains.num_params(); index++) {
+    EXPECT_FLOAT_EQ(chains.mean(index), summary.mean(index));
+    EXPECT_FLOAT_EQ(chains.sd(index), summary.sd(index));
+    EXPECT_FLOAT_EQ(chains.effective_sample_size(index),
+                    summary.effective_sample_size(index));
+    EXPECT_FLOAT_EQ(chains.split_effective_sample_size(index),
+                    summary.split_effective_sample_size(index));
+    EXPECT_FLOAT_EQ(chains.split_potential_scale_reduction(index),
+                    summary.split_potential_scale_reduction(index));
+    Eigen::VectorXd q = chains.quantiles(index, probs);
+    for (int i = 0; i < probs.size(); i++)
+      EXPECT_FLOAT_EQ(q(i), summary.quantiles(index, i));
+  }
+
+  std::vector<int> indexes;
+  indexes.push_back(7);
+  indexes.push_back(5);
+  stan::mcmc::csv_draws_source source1(
+      "src/test/unit/mcmc/test_csv_files/blocker.1.csv");
+  stan::mcmc::csv_draws_source source2(
+      "src/test/unit/mcmc/test_csv_files/blocker.2.csv");
+  stan::mcmc::chains<> lazy_chains(source1);
+  lazy_chains.add(source2);
+  stan::mcmc::chains_summary lazy_summary
+    = lazy_chains.summary(indexes, Eigen::VectorXd());
+  EXPECT_TRUE(source1.loaded(7));
+  EXPECT_TRUE(source2.loaded(5));
+  EXPECT_FALSE(source1.loaded(6));
+  EXPECT_EQ(0, lazy_summary.quantiles.cols());
+  for (int i = 0; i < 2; i++) {
+    EXPECT_FLOAT_EQ(summary.mean(indexes[i]), lazy_summary.mean(i));
+    EXPECT_FLOAT_EQ(summary.effective_sample_size(indexes[i]),
+                    lazy_summary.effective_sample_size(i));
+  }
+}
@@ -175,3 +175,29 @@ TEST(McmcDenseEMetric, streams) {
   EXPECT_EQ("", stan::test::cout_ss.str());
   EXPECT_EQ("", stan::test::cerr_ss.str());
 }
+
+TEST(McmcDenseEMetric, cached_metric_factor) {
+  Eigen::MatrixXd m(2, 2);
+  m(0, 0) = 3.0;
+  m(1, 0) = -2.0;
+  m(0, 1) = -2.0;
+  m(1, 1) = 4.0;
+
+  stan::mcmc::mock_model model(2);
+  stan::mcmc::dense_e_metric<stan::mcmc::mock_model, rng_t> metric(model);
+  stan::mcmc::dense_e_point z(2);
+  z.p(0) = 1.5;
+  z.p(1) = -0.5;
+
+  z.set_metric(m);
+  EXPECT_FLOAT_EQ(0.5 * z.p.transpose() * m * z.p, metric.T(z));
+
+  stan::mcmc::dense_e_point z_copy(z);
+  EXPECT_FLOAT_EQ(metric.T(z), metric.T(z_copy));
+
+  // direct modification of the metric requires a refresh of the factor
+  z.inv_e_metric_ = 2 * m;
+  z.update_metric_factor();
+  EXPECT_FLOAT_EQ(z.p.transpose() * m * z.p, metric.T(z));
+  EXPECT_FLOAT_EQ(0.5 * metric.T(z), metric.T(z_copy));
+}
@@ -297,6 +297,61 @@ TEST(McmcNutsBaseNuts, rho_aggregation_test) {
   
 }
 
+TEST(McmcNutsBaseNuts, build_tree_workspace_reuse_test) {
+
+  rng_t base_rng(0);
+
+  int model_size = 1;
+  double init_momentum = 1.5;
+
+  stan::mcmc::ps_point z_init(model_size);
+  z_init.q(0) = 0;
+  z_init.p(0) = init_momentum;
+
+  stan::mcmc::mock_model model(model_size);
+  stan::mcmc::mock_nuts sampler(model, base_rng);
+
+  sampler.set_nominal_stepsize(1);
+  sampler.set_stepsize_jitter(0);
+  sampler.sample_stepsize();
+
+  std::stringstream debug, info, warn, error, fatal;
+  stan::callbacks::stream_logger logger(debug, info, warn, error, fatal);
+
+  // Building trees of growing and then shrinking depth reuses the
+  // per-depth storage and must give the same results as a fresh sampler
+  int depths[] = {3, 1, 4, 2, 3};
+  for (int i = 0; i < 5; ++i) {
+    stan::mcmc::ps_point z_propose(model_size);
+    Eigen::VectorXd p_begin = Eigen::VectorXd::Zero(model_size);
+    Eigen::VectorXd p_sharp_begin = Eigen::VectorXd::Zero(model_size);
+    Eigen::VectorXd p_end = Eigen::VectorXd::Zero(model_size);
+    Eigen::VectorXd p_sharp_end = Eigen::VectorXd::Zero(model_size);
+    Eigen::VectorXd rho = z_init.p;
+    double log_sum_weight = -std::numeric_limits<double>::infinity();
+    double H0 = -0.1;
+    int n_leapfrog = 0;
+    double sum_metro_prob = 0;
+
+    sampler.z() = z_init;
+    bool valid_subtree = sampler.build_tree(depths[i], z_propose,
+                                            p_sharp_begin, p_sharp_end,
+                                            rho, p_begin, p_end,
+                                            H0, 1, n_leapfrog,
+                                            log_sum_weight,
+                                            sum_metro_prob, logger);
+
+    int n_expected = 1 << depths[i];
+    EXPECT_TRUE(valid_subtree);
+    EXPECT_EQ(n_expected, n_leapfrog);
+    EXPECT_EQ(init_momentum * (n_leapfrog + 1), rho(0));
+    EXPECT_EQ(n_expected * init_momentum, sampler.z().q(0));
+    EXPECT_FLOAT_EQ(H0 + std::log(n_leapfrog), log_sum_weight);
+  }
+
+  EXPECT_EQ("", error.str());
+}
+
 TEST(McmcNutsBaseNuts, divergence_test) {
 
   rng_t base_rng(0);
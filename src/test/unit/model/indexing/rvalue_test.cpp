@@ -1,5 +1,6 @@
 #include <iostream>
 #include <stdexcept>
+#include <string>
 #include <vector>
 #include <stan/model/indexing/rvalue.hpp>
 #include <gtest/gtest.h>
@@ -641,3 +642,70 @@ TEST(ModelIndexing, rvalueMatrixMultiMulti) {
 
 
   
+
+TEST(ModelIndexing, rvalueRangeOutOfRangeIndex) {
+  Eigen::VectorXd v(5);
+  v << 1, 2, 3, 4, 5;
+  try {
+    rvalue(v, index_list(index_min_max(3, 9)), "v");
+    FAIL() << "expecting out of range";
+  } catch (const std::out_of_range& e) {
+    EXPECT_TRUE(std::string(e.what()).find("6") != std::string::npos)
+      << e.what();
+    EXPECT_TRUE(std::string(e.what()).find("9") == std::string::npos)
+      << e.what();
+  }
+}
+
+TEST(ModelIndexing, rvalueRangeEmpty) {
+  Eigen::VectorXd v(3);
+  v << 1, 2, 3;
+  EXPECT_EQ(0, rvalue(v, index_list(index_min_max(3, 2))).size());
+
+  Eigen::MatrixXd m(3, 4);
+  m.setZero();
+  Eigen::MatrixXd b = rvalue(m, index_list(index_min_max(2, 1)));
+  EXPECT_EQ(0, b.rows());
+  EXPECT_EQ(4, b.cols());
+}
+
+TEST(ModelIndexing, rvalueMatrixRangeRange) {
+  Eigen::MatrixXd m(3, 4);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 4; ++j)
+      m(i, j) = 10 * i + j;
+  Eigen::MatrixXd b = rvalue(m, index_list(index_min(2), index_max(3)));
+  ASSERT_EQ(2, b.rows());
+  ASSERT_EQ(3, b.cols());
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_FLOAT_EQ(m(i + 1, j), b(i, j));
+  test_out_of_range(m, index_list(index_min_max(1, 2), index_min_max(2, 5)));
+}
+
+TEST(ModelIndexing, rvalueMatrixRangeRowAndColOutOfRange) {
+  // the column is reported first, as by the per-element loop
+  Eigen::MatrixXd m(3, 4);
+  m.setZero();
+  try {
+    rvalue(m, index_list(index_min_max(2, 5), index_uni(7)), "m");
+    FAIL() << "expecting out of range";
+  } catch (const std::out_of_range& e) {
+    EXPECT_TRUE(std::string(e.what()).find("index col") != std::string::npos)
+      << e.what();
+  }
+  try {
+    rvalue(m, index_list(index_min_max(2, 5), index_min_max(6, 7)), "m");
+    FAIL() << "expecting out of range";
+  } catch (const std::out_of_range& e) {
+    EXPECT_TRUE(std::string(e.what()).find("col index") != std::string::npos)
+      << e.what();
+  }
+  try {
+    rvalue(m, index_list(index_min_max(2, 5), index_min_max(3, 7)), "m");
+    FAIL() << "expecting out of range";
+  } catch (const std::out_of_range& e) {
+    EXPECT_TRUE(std::string(e.what()).find("row index") != std::string::npos)
+      << e.what();
+  }
+}
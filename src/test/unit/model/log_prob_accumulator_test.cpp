@@ -0,0 +1,37 @@
+#include <stan/math/rev/core.hpp>
+#include <stan/model/log_prob_accumulator.hpp>
+#include <gtest/gtest.h>
+#include <boost/type_traits/is_same.hpp>
+#include <vector>
+
+TEST(ModelUtil, value_accumulator_scalars) {
+  stan::model::value_accumulator acc;
+  EXPECT_FLOAT_EQ(0, acc.sum());
+  acc.add(1.5);
+  acc.add(2);
+  EXPECT_FLOAT_EQ(3.5, acc.sum());
+  EXPECT_FLOAT_EQ(4.5, stan::model::get_lp(1.0, acc));
+}
+
+TEST(ModelUtil, value_accumulator_containers) {
+  stan::model::value_accumulator acc;
+  Eigen::VectorXd v(3);
+  v << 1, 2, 3;
+  acc.add(v);
+  Eigen::MatrixXd m(2, 2);
+  m << 10, 20, 30, 40;
+  acc.add(m);
+  std::vector<Eigen::RowVectorXd> rvs(2, Eigen::RowVectorXd::Constant(2, 100));
+  acc.add(rvs);
+  std::vector<std::vector<int> > xss(2, std::vector<int>(3, 1000));
+  acc.add(xss);
+  EXPECT_FLOAT_EQ(6 + 100 + 400 + 6000, acc.sum());
+}
+
+TEST(ModelUtil, log_prob_accumulator_type) {
+  EXPECT_TRUE((boost::is_same<stan::model::value_accumulator,
+               stan::model::log_prob_accumulator<double>::type>::value));
+  EXPECT_TRUE((boost::is_same<stan::math::accumulator<stan::math::var>,
+               stan::model::log_prob_accumulator<stan::math::var>::type>
+               ::value));
+}
@@ -0,0 +1,28 @@
+#include <stan/model/message_sink.hpp>
+#include <test/unit/services/instrumented_callbacks.hpp>
+#include <gtest/gtest.h>
+
+TEST(ModelUtil, message_sink) {
+  stan::test::unit::instrumented_logger logger;
+  {
+    stan::model::message_sink msgs;
+    EXPECT_TRUE(msgs.empty());
+    msgs.log_info(logger);
+    EXPECT_EQ(0, logger.call_count());
+
+    *msgs.stream() << "first message";
+    EXPECT_FALSE(msgs.empty());
+    msgs.log_info(logger);
+    EXPECT_TRUE(msgs.empty());
+    EXPECT_EQ(1, logger.call_count_info());
+    EXPECT_EQ(1, logger.find_info("first message"));
+
+    *msgs.stream() << "dropped";
+  }
+  stan::model::message_sink msgs;
+  EXPECT_TRUE(msgs.empty());
+  *msgs.stream() << "second message";
+  msgs.log_info(logger);
+  EXPECT_EQ(2, logger.call_count_info());
+  EXPECT_EQ(0, logger.find_info("dropped"));
+}
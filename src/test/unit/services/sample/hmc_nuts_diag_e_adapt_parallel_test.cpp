@@ -0,0 +1,147 @@
+#include <stan/services/sample/hmc_nuts_diag_e_adapt.hpp>
+#include <gtest/gtest.h>
+#include <stan/io/empty_var_context.hpp>
+#include <test/test-models/good/optimization/rosenbrock.hpp>
+#include <test/unit/services/instrumented_callbacks.hpp>
+#include <iostream>
+#include <vector>
+
+class ServicesSampleHmcNutsDiagEAdaptParallel : public testing::Test {
+public:
+  ServicesSampleHmcNutsDiagEAdaptParallel()
+    : model(context, &model_log),
+      unit_metric(stan::services::util::create_unit_e_diag_inv_metric(2)) {
+    for (size_t n = 0; n < num_chains; ++n) {
+      inits.push_back(&context);
+      metrics.push_back(&unit_metric);
+      init_writers.push_back(&init[n]);
+      parameter_writers.push_back(&parameter[n]);
+      diagnostic_writers.push_back(&diagnostic[n]);
+    }
+  }
+
+  static const size_t num_chains = 3;
+  std::stringstream model_log;
+  stan::test::unit::instrumented_logger logger;
+  stan::test::unit::instrumented_writer init[num_chains];
+  stan::test::unit::instrumented_writer parameter[num_chains];
+  stan::test::unit::instrumented_writer diagnostic[num_chains];
+  stan::io::empty_var_context context;
+  stan_model model;
+  stan::io::dump unit_metric;
+  std::vector<stan::io::var_context*> inits;
+  std::vector<stan::io::var_context*> metrics;
+  std::vector<stan::callbacks::writer*> init_writers;
+  std::vector<stan::callbacks::writer*> parameter_writers;
+  std::vector<stan::callbacks::writer*> diagnostic_writers;
+};
+
+TEST_F(ServicesSampleHmcNutsDiagEAdaptParallel, call_count) {
+  unsigned int random_seed = 0;
+  unsigned int chain = 1;
+  double init_radius = 0;
+  int num_warmup = 200;
+  int num_samples = 400;
+  int num_thin = 5;
+  bool save_warmup = true;
+  int refresh = 0;
+  double stepsize = 0.1;
+  double stepsize_jitter = 0;
+  int max_depth = 8;
+  double delta = .1;
+  double gamma = .1;
+  double kappa = .1;
+  double t0 = .1;
+  unsigned int init_buffer = 50;
+  unsigned int term_buffer = 50;
+  unsigned int window = 100;
+  stan::test::unit::instrumented_interrupt interrupt;
+  EXPECT_EQ(interrupt.call_count(), 0);
+
+  int return_code = stan::services::sample::hmc_nuts_diag_e_adapt(
+      model, num_chains, inits, metrics, random_seed, chain, init_radius,
+      num_warmup, num_samples, num_thin, save_warmup, refresh,
+      stepsize, stepsize_jitter, max_depth, delta, gamma, kappa, t0,
+      init_buffer, term_buffer, window,
+      interrupt, logger, init_writers,
+      parameter_writers, diagnostic_writers);
+
+  EXPECT_EQ(0, return_code);
+
+  int num_output_lines = (num_warmup+num_samples)/num_thin;
+  EXPECT_EQ(num_chains * (num_warmup+num_samples), interrupt.call_count());
+  for (size_t n = 0; n < num_chains; ++n) {
+    EXPECT_EQ(1, parameter[n].call_count("vector_string"));
+    EXPECT_EQ(num_output_lines, parameter[n].call_count("vector_double"));
+    EXPECT_EQ(1, diagnostic[n].call_count("vector_string"));
+    EXPECT_EQ(num_output_lines, diagnostic[n].call_count("vector_double"));
+  }
+}
+
+TEST_F(ServicesSampleHmcNutsDiagEAdaptParallel, matches_single_chain) {
+  unsigned int random_seed = 12345;
+  unsigned int chain = 1;
+  double init_radius = 2;
+  int num_warmup = 100;
+  int num_samples = 100;
+  int num_thin = 1;
+  bool save_warmup = false;
+  int refresh = 0;
+  double stepsize = 0.1;
+  double stepsize_jitter = 0;
+  int max_depth = 8;
+  double delta = .8;
+  double gamma = .05;
+  double kappa = .75;
+  double t0 = 10;
+  unsigned int init_buffer = 15;
+  unsigned int term_buffer = 10;
+  unsigned int window = 25;
+  stan::test::unit::instrumented_interrupt interrupt;
+
+  stan::services::sample::hmc_nuts_diag_e_adapt(
+      model, num_chains, inits, metrics, random_seed, chain, init_radius,
+      num_warmup, num_samples, num_thin, save_warmup, refresh,
+      stepsize, stepsize_jitter, max_depth, delta, gamma, kappa, t0,
+      init_buffer, term_buffer, window,
+      interrupt, logger, init_writers,
+      parameter_writers, diagnostic_writers);
+
+  for (size_t n = 0; n < num_chains; ++n) {
+    stan::test::unit::instrumented_writer single_init, single_parameter,
+      single_diagnostic;
+    stan::services::sample::hmc_nuts_diag_e_adapt(
+        model, context, random_seed, chain + n, init_radius,
+        num_warmup, num_samples, num_thin, save_warmup, refresh,
+        stepsize, stepsize_jitter, max_depth, delta, gamma, kappa, t0,
+        init_buffer, term_buffer, window,
+        interrupt, logger, single_init,
+        single_parameter, single_diagnostic);
+
+    std::vector<std::vector<double> > expected
+      = single_parameter.vector_double_values();
+    std::vector<std::vector<double> > found
+      = parameter[n].vector_double_values();
+    ASSERT_EQ(expected.size(), found.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(expected[i].size(), found[i].size());
+      for (size_t j = 0; j < expected[i].size(); ++j)
+        EXPECT_FLOAT_EQ(expected[i][j], found[i][j]);
+    }
+  }
+}
+
+TEST_F(ServicesSampleHmcNutsDiagEAdaptParallel, size_mismatch) {
+  stan::test::unit::instrumented_interrupt interrupt;
+  inits.pop_back();
+
+  int return_code = stan::services::sample::hmc_nuts_diag_e_adapt(
+      model, num_chains, inits, metrics, 0, 1, 0,
+      200, 400, 5, true, 0, 0.1, 0, 8, .1, .1, .1, .1, 50, 50, 100,
+      interrupt, logger, init_writers,
+      parameter_writers, diagnostic_writers);
+
+  EXPECT_EQ(stan::services::error_codes::USAGE, return_code);
+  EXPECT_EQ(1, logger.call_count_error());
+  EXPECT_EQ(0, parameter[0].call_count());
+}
@@ -89,3 +89,29 @@ TEST_F(ServicesStandaloneGQ, genDraws_bad) {
   EXPECT_EQ(count_matches("Wrong number of parameter values", logger_ss.str()),
             1);
 }
+
+TEST_F(ServicesStandaloneGQ, genDraws_bernoulli_threads) {
+  stan::io::stan_csv bern_csv;
+  std::stringstream out;
+  std::ifstream csv_stream;
+  csv_stream.open("src/test/test-models/good/services/bernoulli_fit.csv");
+  bern_csv = stan::io::stan_csv_reader::parse(csv_stream, &out);
+  csv_stream.close();
+  Eigen::MatrixXd draws = bern_csv.samples.middleCols<1>(7);
+
+  std::stringstream sample_ss_1;
+  stan::callbacks::stream_writer sample_writer_1(sample_ss_1, "");
+  int return_code = stan::services::standalone_generate(
+      *model, draws, 12345, 1, interrupt, logger, sample_writer_1);
+  EXPECT_EQ(return_code, stan::services::error_codes::OK);
+  EXPECT_EQ(count_matches("y_rep", sample_ss_1.str()), 10);
+  EXPECT_EQ(count_matches("\n", sample_ss_1.str()), 1001);
+  match_csv_columns(bern_csv.samples, sample_ss_1.str(), 1000, 1, 8);
+
+  std::stringstream sample_ss_4;
+  stan::callbacks::stream_writer sample_writer_4(sample_ss_4, "");
+  return_code = stan::services::standalone_generate(
+      *model, draws, 12345, 4, interrupt, logger, sample_writer_4);
+  EXPECT_EQ(return_code, stan::services::error_codes::OK);
+  EXPECT_EQ(sample_ss_1.str(), sample_ss_4.str());
+}
@@ -146,6 +146,27 @@ TEST_F(ServicesUtil, write_sample_params) {
   EXPECT_EQ(0, logger.call_count());
 }
 
+TEST_F(ServicesUtil, write_sample_params_repeated) {
+  boost::ecuyer1988 rng = stan::services::util::create_rng(0, 1);
+  Eigen::VectorXd x = Eigen::VectorXd::Zero(2);
+  stan::mcmc::sample sample(x, 1, 2);
+  mock_sampler sampler;
+
+  mcmc_writer.write_sample_names(sample, sampler, model);
+  mcmc_writer.write_sample_params(rng, sample, sampler, model);
+  mcmc_writer.write_sample_params(rng, sample, sampler, model);
+  EXPECT_EQ(3, sample_writer.call_count());
+  EXPECT_EQ(2, sample_writer.call_count("vector_double"));
+
+  std::vector<std::vector<double>> values = sample_writer.vector_double_values();
+  ASSERT_EQ(2, values.size());
+  EXPECT_EQ(mcmc_writer.num_sample_params_ + mcmc_writer.num_sampler_params_
+            + mcmc_writer.num_model_params_, values[0].size());
+  EXPECT_EQ(values[0].size(), values[1].size());
+  for (size_t i = 0; i < mcmc_writer.num_sample_params_; ++i)
+    EXPECT_FLOAT_EQ(values[0][i], values[1][i]);
+}
+
 TEST_F(ServicesUtil, write_adapt_finish) {
   mock_sampler sampler;
 
@@ -201,6 +222,23 @@ TEST_F(ServicesUtil, write_timing) {
 }
 
 
+TEST_F(ServicesUtil, write_timing_counters) {
+  stan::services::util::sampler_timing timing;
+  timing.warmup.wall_time = 1;
+  timing.sampling.wall_time = 2;
+  timing.sampling.counters.n_gradient = 42;
+  mcmc_writer.write_timing(timing);
+  EXPECT_EQ(11, sample_writer.call_count());
+  EXPECT_EQ(3 + 5, sample_writer.call_count("string"));
+  EXPECT_EQ(3, sample_writer.call_count("empty"));
+  EXPECT_EQ(11, diagnostic_writer.call_count());
+  EXPECT_EQ(11, logger.call_count());
+  EXPECT_EQ(11, logger.call_count_info());
+  EXPECT_EQ(1, logger.find_info("1 seconds (Warm-up)"));
+  EXPECT_EQ(1, logger.find_info("2 seconds (Sampling)"));
+  EXPECT_EQ(1, logger.find_info("Gradient evaluations: 0 warm-up, 42 sampling"));
+}
+
 TEST_F(ServicesUtil, throwing_model__write_sample_parameters) {
   boost::ecuyer1988 rng = stan::services::util::create_rng(0, 1);
   Eigen::VectorXd x = Eigen::VectorXd::Zero(2);
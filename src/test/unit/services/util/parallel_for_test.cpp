@@ -0,0 +1,34 @@
+#include <stan/services/util/parallel_for.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+TEST(ServicesUtil, get_num_threads) {
+  EXPECT_EQ(1U, stan::services::util::get_num_threads(0));
+  EXPECT_EQ(1U, stan::services::util::get_num_threads(1));
+  EXPECT_LE(stan::services::util::get_num_threads(4), 4U);
+}
+
+TEST(ServicesUtil, parallel_for_visits_each_job_once) {
+  std::vector<int> visits(100, 0);
+  stan::services::util::parallel_for(visits.size(), 4,
+                                     [&](size_t n) { visits[n] += 1; });
+  for (size_t n = 0; n < visits.size(); ++n)
+    EXPECT_EQ(1, visits[n]) << "job " << n;
+}
+
+TEST(ServicesUtil, parallel_for_no_jobs) {
+  int calls = 0;
+  stan::services::util::parallel_for(0, 4, [&](size_t n) { ++calls; });
+  EXPECT_EQ(0, calls);
+}
+
+TEST(ServicesUtil, parallel_for_rethrows) {
+  EXPECT_THROW(stan::services::util::parallel_for(
+                   10, 4,
+                   [](size_t n) {
+                     if (n == 3)
+                       throw std::domain_error("job 3");
+                   }),
+               std::domain_error);
+}
@@ -46,25 +46,25 @@ TEST_F(ServicesUtil, all_zero) {
                                              sample_writer, diagnostic_writer);
   EXPECT_EQ(0, interrupt.call_count());
 
-  EXPECT_EQ(3 + 2, logger.call_count())
+  EXPECT_EQ(3 + 2 + 5 + 1, logger.call_count())
     << "Writes the elapsed time";
   EXPECT_EQ(logger.call_count(), logger.call_count_info())
     << "No other calls to logger";
 
-  EXPECT_EQ(8, sample_writer.call_count());
+  EXPECT_EQ(14, sample_writer.call_count());
   EXPECT_EQ(1, sample_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(2 + 3, sample_writer.call_count("string"))
-    << "adaptation info + elapsed time";
-  EXPECT_EQ(2, sample_writer.call_count("empty"))
+  EXPECT_EQ(2 + 3 + 5, sample_writer.call_count("string"))
+    << "adaptation info + elapsed time + work counters";
+  EXPECT_EQ(3, sample_writer.call_count("empty"))
     << "blank lines";
 
-  EXPECT_EQ(6, diagnostic_writer.call_count());
+  EXPECT_EQ(12, diagnostic_writer.call_count());
   EXPECT_EQ(1, diagnostic_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(3, diagnostic_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, diagnostic_writer.call_count("empty"))
+  EXPECT_EQ(3 + 5, diagnostic_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, diagnostic_writer.call_count("empty"))
     << "blank lines";
 }
 
@@ -80,25 +80,25 @@ TEST_F(ServicesUtil, num_warmup_no_save) {
                                              sample_writer, diagnostic_writer);
   EXPECT_EQ(num_warmup, interrupt.call_count());
 
-  EXPECT_EQ(3 + 2, logger.call_count())
+  EXPECT_EQ(3 + 2 + 5 + 1, logger.call_count())
     << "Writes the elapsed time";
   EXPECT_EQ(logger.call_count(), logger.call_count_info())
     << "No other calls to logger";
 
-  EXPECT_EQ(8, sample_writer.call_count());
+  EXPECT_EQ(14, sample_writer.call_count());
   EXPECT_EQ(1, sample_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(2 + 3, sample_writer.call_count("string"))
-    << "adaptation info + elapsed time";
-  EXPECT_EQ(2, sample_writer.call_count("empty"))
+  EXPECT_EQ(2 + 3 + 5, sample_writer.call_count("string"))
+    << "adaptation info + elapsed time + work counters";
+  EXPECT_EQ(3, sample_writer.call_count("empty"))
     << "blank lines";
 
-  EXPECT_EQ(6, diagnostic_writer.call_count());
+  EXPECT_EQ(12, diagnostic_writer.call_count());
   EXPECT_EQ(1, diagnostic_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(3, diagnostic_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, diagnostic_writer.call_count("empty"))
+  EXPECT_EQ(3 + 5, diagnostic_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, diagnostic_writer.call_count("empty"))
     << "blank lines";
 }
 
@@ -115,27 +115,27 @@ TEST_F(ServicesUtil, num_warmup_save) {
                                              sample_writer, diagnostic_writer);
   EXPECT_EQ(num_warmup, interrupt.call_count());
 
-  EXPECT_EQ(3 + 2, logger.call_count())
+  EXPECT_EQ(3 + 2 + 5 + 1, logger.call_count())
     << "Writes the elapsed time";
   EXPECT_EQ(logger.call_count(), logger.call_count_info())
     << "No other calls to logger";
 
-  EXPECT_EQ(num_warmup + 8, sample_writer.call_count());
+  EXPECT_EQ(num_warmup + 14, sample_writer.call_count());
   EXPECT_EQ(1, sample_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(2 + 3, sample_writer.call_count("string"))
-    << "adaptation info + elapsed time";
-  EXPECT_EQ(2, sample_writer.call_count("empty"))
+  EXPECT_EQ(2 + 3 + 5, sample_writer.call_count("string"))
+    << "adaptation info + elapsed time + work counters";
+  EXPECT_EQ(3, sample_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ(num_warmup, sample_writer.call_count("vector_double"))
     << "warmup draws";
 
-  EXPECT_EQ(num_warmup + 6, diagnostic_writer.call_count());
+  EXPECT_EQ(num_warmup + 12, diagnostic_writer.call_count());
   EXPECT_EQ(1, diagnostic_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(3, diagnostic_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, diagnostic_writer.call_count("empty"))
+  EXPECT_EQ(3 + 5, diagnostic_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, diagnostic_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ(num_warmup, diagnostic_writer.call_count("vector_double"))
     << "warmup draws";
@@ -154,27 +154,27 @@ TEST_F(ServicesUtil, num_samples) {
                                              sample_writer, diagnostic_writer);
   EXPECT_EQ(num_samples, interrupt.call_count());
 
-  EXPECT_EQ(3 + 2, logger.call_count())
+  EXPECT_EQ(3 + 2 + 5 + 1, logger.call_count())
     << "Writes the elapsed time";
   EXPECT_EQ(logger.call_count(), logger.call_count_info())
     << "No other calls to logger";
 
-  EXPECT_EQ(num_samples + 8, sample_writer.call_count());
+  EXPECT_EQ(num_samples + 14, sample_writer.call_count());
   EXPECT_EQ(1, sample_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(2 + 3, sample_writer.call_count("string"))
-    << "adaptation info + elapsed time";
-  EXPECT_EQ(2, sample_writer.call_count("empty"))
+  EXPECT_EQ(2 + 3 + 5, sample_writer.call_count("string"))
+    << "adaptation info + elapsed time + work counters";
+  EXPECT_EQ(3, sample_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ(num_samples, sample_writer.call_count("vector_double"))
     << "num_samples draws";
 
-  EXPECT_EQ(num_samples + 6, diagnostic_writer.call_count());
+  EXPECT_EQ(num_samples + 12, diagnostic_writer.call_count());
   EXPECT_EQ(1, diagnostic_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(3, diagnostic_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, diagnostic_writer.call_count("empty"))
+  EXPECT_EQ(3 + 5, diagnostic_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, diagnostic_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ(num_samples, sample_writer.call_count("vector_double"))
     << "num_samples draws";
@@ -195,30 +195,30 @@ TEST_F(ServicesUtil, num_warmup_save_num_samples_num_thin) {
                                              sample_writer, diagnostic_writer);
   EXPECT_EQ(num_warmup + num_samples, interrupt.call_count());
 
-  EXPECT_EQ(3 + 2, logger.call_count())
+  EXPECT_EQ(3 + 2 + 5 + 1, logger.call_count())
     << "Writes the elapsed time";
   EXPECT_EQ(logger.call_count(), logger.call_count_info())
     << "No other calls to logger";
 
-  EXPECT_EQ((num_warmup + num_samples) / num_thin + 8,
+  EXPECT_EQ((num_warmup + num_samples) / num_thin + 14,
             sample_writer.call_count());
   EXPECT_EQ(1, sample_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(2 + 3, sample_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, sample_writer.call_count("empty"))
+  EXPECT_EQ(2 + 3 + 5, sample_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, sample_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ((num_warmup + num_samples) / num_thin,
             sample_writer.call_count("vector_double"))
     << "thinned warmup and draws";
 
-  EXPECT_EQ((num_warmup + num_samples) / num_thin + 6,
+  EXPECT_EQ((num_warmup + num_samples) / num_thin + 12,
             diagnostic_writer.call_count());
   EXPECT_EQ(1, diagnostic_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(3, diagnostic_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, diagnostic_writer.call_count("empty"))
+  EXPECT_EQ(3 + 5, diagnostic_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, diagnostic_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ((num_warmup + num_samples) / num_thin,
             diagnostic_writer.call_count("vector_double"))
@@ -239,33 +239,58 @@ TEST_F(ServicesUtil, num_warmup_num_samples_refresh) {
                                              sample_writer, diagnostic_writer);
   EXPECT_EQ(num_warmup + num_samples, interrupt.call_count());
 
-  EXPECT_EQ((num_warmup + num_samples) / refresh + 2 + 3 + 2, logger.call_count())
+  EXPECT_EQ((num_warmup + num_samples) / refresh + 2 + 3 + 2 + 5 + 1,
+            logger.call_count())
     << "Writes 1 to start warmup, 1 to start post-warmup, and "
     << "(num_warmup + num_samples) / refresh, then the elapsed time";
   EXPECT_EQ(logger.call_count(), logger.call_count_info())
     << "No other calls to logger";
 
-  EXPECT_EQ(num_samples + 8,
+  EXPECT_EQ(num_samples + 14,
             sample_writer.call_count());
   EXPECT_EQ(1, sample_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(2 + 3, sample_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, sample_writer.call_count("empty"))
+  EXPECT_EQ(2 + 3 + 5, sample_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, sample_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ(num_samples,
             sample_writer.call_count("vector_double"))
     << "draws";
 
-  EXPECT_EQ(num_samples + 6,
+  EXPECT_EQ(num_samples + 12,
             diagnostic_writer.call_count());
   EXPECT_EQ(1, diagnostic_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(3, diagnostic_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, diagnostic_writer.call_count("empty"))
+  EXPECT_EQ(3 + 5, diagnostic_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, diagnostic_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ(num_samples,
             diagnostic_writer.call_count("vector_double"))
     << "draws";
 }
+
+TEST_F(ServicesUtil, timing) {
+  num_warmup = 100;
+  num_samples = 50;
+  stan::services::util::sampler_timing timing;
+  stan::services::util::run_adaptive_sampler(sampler, model,
+                                             cont_vector,
+                                             num_warmup, num_samples,
+                                             num_thin, refresh, save_warmup,
+                                             rng,
+                                             interrupt,
+                                             logger,
+                                             sample_writer, diagnostic_writer,
+                                             &timing);
+  EXPECT_LE(0, timing.warmup.wall_time);
+  EXPECT_LE(0, timing.sampling.wall_time);
+  EXPECT_LE(0, timing.warmup.cpu_time);
+  EXPECT_LE(0, timing.sampling.writer_time);
+  EXPECT_LT(0, timing.warmup.counters.n_leapfrog);
+  EXPECT_LT(0, timing.sampling.counters.n_leapfrog);
+  EXPECT_LE(timing.sampling.counters.n_leapfrog,
+            timing.sampling.counters.n_gradient);
+  EXPECT_EQ(1, logger.find_info("Leapfrog steps:"));
+}
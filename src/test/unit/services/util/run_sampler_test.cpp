@@ -96,24 +96,24 @@ TEST_F(ServicesUtil, all_zero) {
                                     sample_writer, diagnostic_writer);
   EXPECT_EQ(0, interrupt.call_count());
 
-  EXPECT_EQ(3 + 2, logger.call_count()) << "Writes the elapsed time";
+  EXPECT_EQ(3 + 2 + 5 + 1, logger.call_count()) << "Writes the elapsed time";
   EXPECT_EQ(logger.call_count(), logger.call_count_info())
     << "No other calls to logger";
 
-  EXPECT_EQ(7, sample_writer.call_count());
+  EXPECT_EQ(13, sample_writer.call_count());
   EXPECT_EQ(1, sample_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(4, sample_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, sample_writer.call_count("empty"))
+  EXPECT_EQ(4 + 5, sample_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, sample_writer.call_count("empty"))
     << "blank lines";
 
-  EXPECT_EQ(6, diagnostic_writer.call_count());
+  EXPECT_EQ(12, diagnostic_writer.call_count());
   EXPECT_EQ(1, diagnostic_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(3, diagnostic_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, diagnostic_writer.call_count("empty"))
+  EXPECT_EQ(3 + 5, diagnostic_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, diagnostic_writer.call_count("empty"))
     << "blank lines";
 }
 
@@ -129,24 +129,24 @@ TEST_F(ServicesUtil, num_warmup_no_save) {
                                     sample_writer, diagnostic_writer);
   EXPECT_EQ(num_warmup, interrupt.call_count());
 
-  EXPECT_EQ(3 + 2, logger.call_count()) << "Writes the elapsed time";
+  EXPECT_EQ(3 + 2 + 5 + 1, logger.call_count()) << "Writes the elapsed time";
   EXPECT_EQ(logger.call_count(), logger.call_count_info())
     << "No other calls to logger";
 
-  EXPECT_EQ(7, sample_writer.call_count());
+  EXPECT_EQ(13, sample_writer.call_count());
   EXPECT_EQ(1, sample_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(4, sample_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, sample_writer.call_count("empty"))
+  EXPECT_EQ(4 + 5, sample_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, sample_writer.call_count("empty"))
     << "blank lines";
 
-  EXPECT_EQ(6, diagnostic_writer.call_count());
+  EXPECT_EQ(12, diagnostic_writer.call_count());
   EXPECT_EQ(1, diagnostic_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(3, diagnostic_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, diagnostic_writer.call_count("empty"))
+  EXPECT_EQ(3 + 5, diagnostic_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, diagnostic_writer.call_count("empty"))
     << "blank lines";
 }
 
@@ -163,26 +163,26 @@ TEST_F(ServicesUtil, num_warmup_save) {
                                     sample_writer, diagnostic_writer);
   EXPECT_EQ(num_warmup, interrupt.call_count());
 
-  EXPECT_EQ(3 + 2, logger.call_count()) << "Writes the elapsed time";
+  EXPECT_EQ(3 + 2 + 5 + 1, logger.call_count()) << "Writes the elapsed time";
   EXPECT_EQ(logger.call_count(), logger.call_count_info())
     << "No other calls to logger";
 
-  EXPECT_EQ(num_warmup + 7, sample_writer.call_count());
+  EXPECT_EQ(num_warmup + 13, sample_writer.call_count());
   EXPECT_EQ(1, sample_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(4, sample_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, sample_writer.call_count("empty"))
+  EXPECT_EQ(4 + 5, sample_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, sample_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ(num_warmup, sample_writer.call_count("vector_double"))
     << "warmup draws";
 
-  EXPECT_EQ(num_warmup + 6, diagnostic_writer.call_count());
+  EXPECT_EQ(num_warmup + 12, diagnostic_writer.call_count());
   EXPECT_EQ(1, diagnostic_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(3, diagnostic_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, diagnostic_writer.call_count("empty"))
+  EXPECT_EQ(3 + 5, diagnostic_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, diagnostic_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ(num_warmup, diagnostic_writer.call_count("vector_double"))
     << "warmup draws";
@@ -201,26 +201,26 @@ TEST_F(ServicesUtil, num_samples) {
                                     sample_writer, diagnostic_writer);
   EXPECT_EQ(num_samples, interrupt.call_count());
 
-  EXPECT_EQ(3 + 2, logger.call_count()) << "Writes the elapsed time";
+  EXPECT_EQ(3 + 2 + 5 + 1, logger.call_count()) << "Writes the elapsed time";
   EXPECT_EQ(logger.call_count(), logger.call_count_info())
     << "No other calls to logger";
 
-  EXPECT_EQ(num_samples + 7, sample_writer.call_count());
+  EXPECT_EQ(num_samples + 13, sample_writer.call_count());
   EXPECT_EQ(1, sample_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(4, sample_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, sample_writer.call_count("empty"))
+  EXPECT_EQ(4 + 5, sample_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, sample_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ(num_samples, sample_writer.call_count("vector_double"))
     << "num_samples draws";
 
-  EXPECT_EQ(num_samples + 6, diagnostic_writer.call_count());
+  EXPECT_EQ(num_samples + 12, diagnostic_writer.call_count());
   EXPECT_EQ(1, diagnostic_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(3, diagnostic_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, diagnostic_writer.call_count("empty"))
+  EXPECT_EQ(3 + 5, diagnostic_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, diagnostic_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ(num_samples, sample_writer.call_count("vector_double"))
     << "num_samples draws";
@@ -241,29 +241,29 @@ TEST_F(ServicesUtil, num_warmup_save_num_samples_num_thin) {
                                     sample_writer, diagnostic_writer);
   EXPECT_EQ(num_warmup + num_samples, interrupt.call_count());
 
-  EXPECT_EQ(3 + 2, logger.call_count()) << "Writes the elapsed time";
+  EXPECT_EQ(3 + 2 + 5 + 1, logger.call_count()) << "Writes the elapsed time";
   EXPECT_EQ(logger.call_count(), logger.call_count_info())
     << "No other calls to logger";
 
-  EXPECT_EQ((num_warmup + num_samples) / num_thin + 7,
+  EXPECT_EQ((num_warmup + num_samples) / num_thin + 13,
             sample_writer.call_count());
   EXPECT_EQ(1, sample_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(4, sample_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, sample_writer.call_count("empty"))
+  EXPECT_EQ(4 + 5, sample_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, sample_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ((num_warmup + num_samples) / num_thin,
             sample_writer.call_count("vector_double"))
     << "thinned warmup and draws";
 
-  EXPECT_EQ((num_warmup + num_samples) / num_thin + 6,
+  EXPECT_EQ((num_warmup + num_samples) / num_thin + 12,
             diagnostic_writer.call_count());
   EXPECT_EQ(1, diagnostic_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(3, diagnostic_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, diagnostic_writer.call_count("empty"))
+  EXPECT_EQ(3 + 5, diagnostic_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, diagnostic_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ((num_warmup + num_samples) / num_thin,
             diagnostic_writer.call_count("vector_double"))
@@ -286,31 +286,32 @@ TEST_F(ServicesUtil, num_warmup_num_samples_refresh) {
                                     sample_writer, diagnostic_writer);
   EXPECT_EQ(num_warmup + num_samples, interrupt.call_count());
 
-  EXPECT_EQ((num_warmup + num_samples) / refresh + 2 + 3 + 2, logger.call_count())
+  EXPECT_EQ((num_warmup + num_samples) / refresh + 2 + 3 + 2 + 5 + 1,
+            logger.call_count())
     << "Writes 1 to start warmup, 1 to start post-warmup, and "
     << "(num_warmup + num_samples) / refresh, then the elapsed time";
   EXPECT_EQ(logger.call_count(), logger.call_count_info())
     << "No other calls to logger";
 
-  EXPECT_EQ(num_samples + 7,
+  EXPECT_EQ(num_samples + 13,
             sample_writer.call_count());
   EXPECT_EQ(1, sample_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(4, sample_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, sample_writer.call_count("empty"))
+  EXPECT_EQ(4 + 5, sample_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, sample_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ(num_samples,
             sample_writer.call_count("vector_double"))
     << "draws";
 
-  EXPECT_EQ(num_samples + 6,
+  EXPECT_EQ(num_samples + 12,
             diagnostic_writer.call_count());
   EXPECT_EQ(1, diagnostic_writer.call_count("vector_string"))
     << "header line";
-  EXPECT_EQ(3, diagnostic_writer.call_count("string"))
-    << "elapsed time";
-  EXPECT_EQ(2, diagnostic_writer.call_count("empty"))
+  EXPECT_EQ(3 + 5, diagnostic_writer.call_count("string"))
+    << "elapsed time + work counters";
+  EXPECT_EQ(3, diagnostic_writer.call_count("empty"))
     << "blank lines";
   EXPECT_EQ(num_samples,
             diagnostic_writer.call_count("vector_double"))